@@ -32,6 +32,17 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_is_element)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) c
                                              size_t const key);
 
 
+/**
+ * Stores (at most `len` of) the keys in insertion order.
+ *
+ * @return The number of keys.
+ */
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_keys)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                       size_t const len,
+                                       size_t keys[len]);
+
+
 #undef VRD_TYPENAME
 
 
@@ -0,0 +1,67 @@
+/**
+ * @file: batch.h
+ *
+ * Concurrent import of a batch of samples. Each sample is parsed (in the
+ * format of vrd_variants_from_file() or vrd_coverage_from_file()) on a
+ * worker thread into a private staging area that is sorted on reference
+ * and position. The staged runs are then merged into copies of the trees
+ * of the tables; the trees of different references are merged in
+ * parallel and each is published when its merge is done.
+ *
+ * The tables can be queried during the import: queries see a reference
+ * either before or after the batch. On error all entries of the samples
+ * in the batch are removed from the tables and `(size_t) -1` is returned
+ * with `errno` set: `EINVAL` for input that cannot be imported (e.g., an
+ * inserted sequence longer than 1023), `ENOMEM` when out of memory and
+ * -1 otherwise.
+ */
+
+
+#ifndef VRD_BATCH_H
+#define VRD_BATCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stddef.h>     // size_t
+#include <stdio.h>      // FILE
+
+#include "../include/cov_table.h"   // vrd_Cov_Table
+#include "../include/mnv_table.h"   // vrd_MNV_Table
+#include "../include/seq_table.h"   // vrd_Seq_Table
+#include "../include/snv_table.h"   // vrd_SNV_Table
+
+
+/**
+ * @return The number of variants inserted, or `(size_t) -1` on error.
+ */
+size_t
+vrd_variants_from_files(size_t const count,
+                        FILE* const streams[count],
+                        size_t const sample_id[count],
+                        vrd_SNV_Table* const snv,
+                        vrd_MNV_Table* const mnv,
+                        vrd_Seq_Table* const seq,
+                        size_t const threads);
+
+
+/**
+ * @return The number of covered regions inserted, or `(size_t) -1` on
+ *         error.
+ */
+size_t
+vrd_coverage_from_files(size_t const count,
+                        FILE* const streams[count],
+                        size_t const sample_id[count],
+                        vrd_Cov_Table* const cov,
+                        size_t const threads);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file: cohort_table.h
+ *
+ * Defines a table that classifies sample identifiers into (possibly
+ * overlapping) cohorts, referred to as cohort table. Each sample
+ * identifier maps onto a bitmask with one bit per cohort, so a stratified
+ * query classifies every visited entry once, instead of testing it
+ * against a separate subset for each cohort.
+ *
+ * The number of cohorts is limited to VRD_MAX_COHORTS. The capacity
+ * bounds the sample identifiers that can be classified; sample
+ * identifiers beyond the capacity are in no cohort.
+ */
+
+
+#ifndef VRD_COHORT_TABLE_H
+#define VRD_COHORT_TABLE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stddef.h>     // size_t
+#include <stdint.h>     // uint64_t
+
+
+static size_t const VRD_MAX_COHORTS = 64;
+
+
+typedef struct vrd_Cohort_Table vrd_Cohort_Table;
+
+
+vrd_Cohort_Table*
+vrd_Cohort_table_init(size_t const cohort_count, size_t const capacity);
+
+
+void
+vrd_Cohort_table_destroy(vrd_Cohort_Table** const self);
+
+
+int
+vrd_Cohort_table_insert(vrd_Cohort_Table* const self,
+                        size_t const cohort,
+                        size_t const sample_id);
+
+
+size_t
+vrd_Cohort_table_count(vrd_Cohort_Table const* const self);
+
+
+uint64_t
+vrd_Cohort_table_mask(vrd_Cohort_Table const* const self,
+                      size_t const sample_id);
+
+
+/**
+ * Add `value` to `count[i]` for every cohort `i` in `mask`.
+ */
+static inline void
+vrd_cohort_add(uint64_t mask, size_t const value, size_t count[])
+{
+    while (0 != mask)
+    {
+        count[__builtin_ctzll(mask)] += value;  // GCC builtin also works with clang
+        mask &= mask - 1;
+    } // while
+} // vrd_cohort_add
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
@@ -36,10 +36,24 @@ extern "C"
 #include <stddef.h>     // size_t
 
 #include "avl_tree.h"   // vrd_AVL_Tree
+#include "cohort_table.h"   // vrd_Cohort_Table
 #include "template.h"   // VRD_TEMPLATE
 
 
 // from here VRD_TEMPLATE(...) expands to vrd_Cov
+/**
+ * A covered region as returned by vrd_Cov_table_query_region(): a copy,
+ * valid independent of later updates of the table.
+ */
+typedef struct vrd_Cov_Entry
+{
+    size_t start;
+    size_t end;
+    size_t allele_count;
+    size_t sample_id;
+} vrd_Cov_Entry;
+
+
 #define VRD_TYPENAME Cov
 
 
@@ -87,6 +101,16 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_stab)(VRD_TEMPLATE(VRD_TYPENAME, _Table)
                                               vrd_AVL_Tree const* const subset);
 
 
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_stab_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                      size_t const len,
+                                                      char const reference[len],
+                                                      size_t const start,
+                                                      size_t const end,
+                                                      vrd_Cohort_Table const* const cohorts,
+                                                      size_t count[]);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                 size_t const len_ref,
@@ -95,7 +119,7 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tabl
                                                 size_t const end,
                                                 vrd_AVL_Tree const* const subset,
                                                 size_t const len_res,
-                                                void* result[len_res]);
+                                                vrd_Cov_Entry result[len_res]);
 
 
 #undef VRD_TYPENAME
@@ -7,9 +7,12 @@ extern "C"
 #endif
 
 
+#include <stdbool.h>    // bool
 #include <stddef.h>     // size_t
 
 
+// The IUPAC index doubles as a nucleotide bitmask: A = 1, C = 2, G = 4
+// and T = 8; ambiguity codes are the union of their nucleotides.
 static size_t const VRD_IUPAC_SIZE = 16;
 
 
@@ -77,7 +80,7 @@ vrd_iupac_to_idx(char const ch)
 static inline char
 vrd_idx_to_iupac(size_t const idx)
 {
-    char const iupac[] = ".ACMGRSVTUWYHKDBN";
+    char const iupac[] = ".ACMGRSVTWYHKDBN";
 
     if (idx < VRD_IUPAC_SIZE)
     {
@@ -87,6 +90,13 @@ vrd_idx_to_iupac(size_t const idx)
 } // vrd_to_iupac
 
 
+static inline bool
+vrd_iupac_match(size_t const lhs, size_t const rhs)
+{
+    return lhs == rhs || 0 != (lhs & rhs);
+} // vrd_iupac_match
+
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
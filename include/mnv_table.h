@@ -12,10 +12,26 @@ extern "C"
 #include <stdio.h>      // FILE
 
 #include "avl_tree.h"   // vrd_AVL_Tree
+#include "cohort_table.h"   // vrd_Cohort_Table
 #include "seq_table.h"  // vrd_Seq_Table
 #include "template.h"   // VRD_TEMPLATE
 
 
+/**
+ * An MNV as returned by vrd_MNV_table_query_region(): a copy, valid
+ * independent of later updates of the table.
+ */
+typedef struct vrd_MNV_Entry
+{
+    size_t start;
+    size_t end;
+    size_t allele_count;
+    size_t sample_id;
+    size_t phase;       // (size_t) -1 if homozygous
+    size_t inserted;    // index in the sequence table
+} vrd_MNV_Entry;
+
+
 #define VRD_TYPENAME MNV
 
 
@@ -45,6 +61,34 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query)(VRD_TEMPLATE(VRD_TYPENAME, _Table) cons
                                          vrd_AVL_Tree const* const subset);
 
 
+/**
+ * The MNV counterpart of vrd_SNV_table_query_zygosity(): total and
+ * homozygous allele counts and the number of distinct samples carrying
+ * an exactly matching MNV, from one traversal.
+ */
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                  size_t const len,
+                                                  char const reference[len],
+                                                  size_t const start,
+                                                  size_t const end,
+                                                  size_t const inserted,
+                                                  vrd_AVL_Tree const* const subset,
+                                                  size_t* const homozygous,
+                                                  size_t* const carriers);
+
+
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                 size_t const len,
+                                                 char const reference[len],
+                                                 size_t const start,
+                                                 size_t const end,
+                                                 size_t const inserted,
+                                                 vrd_Cohort_Table const* const cohorts,
+                                                 size_t count[]);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                 size_t const len_ref,
@@ -53,7 +97,7 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tabl
                                                 size_t const end,
                                                 vrd_AVL_Tree const* const subset,
                                                 size_t const len_res,
-                                                void* result[len_res]);
+                                                vrd_MNV_Entry result[len_res]);
 
 
 size_t
@@ -62,6 +106,48 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_remove_seq)(VRD_TEMPLATE(VRD_TYPENAME, _Table)
                                               vrd_Seq_Table* const seq_table);
 
 
+/**
+ * As vrd_MNV_table_remove_seq() for a single reference (as logged).
+ */
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_remove_seq_reference)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                                        size_t const len,
+                                                        char const reference[len],
+                                                        vrd_AVL_Tree const* const subset,
+                                                        vrd_Seq_Table* const seq_table);
+
+
+/**
+ * Renumber the `inserted` indices in all trees according to `map`.
+ * The trees are published one by one, so this needs exclusive access
+ * to the table: no queries or updates may run meanwhile.
+ *
+ * @return 0 on success, -1 if not all trees could be updated; the table
+ *         is left untouched on failure.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_renumber)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                            size_t const count,
+                                            size_t const map[count]);
+
+
+/**
+ * Compact the sequence table (vrd_Seq_table_compact) and renumber the
+ * `inserted` indices in all trees accordingly.
+ *
+ * This needs exclusive access to both tables: the sequence table is not
+ * synchronized and is compacted in place, and the renumbered trees are
+ * published one by one, so a concurrent query could see old and new
+ * indices mixed.
+ *
+ * @return 0 on success, -1 on failure; the tables are left untouched on
+ *         failure.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_compact_seq)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                               vrd_Seq_Table* const seq_table);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_export)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                           FILE* stream,
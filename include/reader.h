@@ -0,0 +1,57 @@
+/**
+ * @file: reader.h
+ *
+ * Defines a reader that transparently decompresses an input stream.
+ * gzip streams (including concatenated members) are inflated on a
+ * background thread; BGZF streams (as written by bgzip) are inflated
+ * block-wise by a number of worker threads. The decompressed data is
+ * presented as a regular stream (the read end of a pipe), so the
+ * `vrd_*_from_file` loaders parse it unchanged while decompression runs
+ * concurrently. Uncompressed streams are passed through.
+ *
+ * The reader does not close the underlying stream.
+ */
+
+
+#ifndef VRD_READER_H
+#define VRD_READER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stddef.h>     // size_t
+#include <stdio.h>      // FILE
+
+
+typedef struct vrd_Reader vrd_Reader;
+
+
+vrd_Reader*
+vrd_reader_open(FILE* const stream, size_t const threads);
+
+
+/**
+ * @return The (decompressed) stream to read from.
+ */
+FILE*
+vrd_reader_stream(vrd_Reader const* const self);
+
+
+/**
+ * Close the reader, stop decompression and join the threads.
+ *
+ * @return 0 on success, -1 on corrupt input, or an error number
+ *         otherwise.
+ */
+int
+vrd_reader_close(vrd_Reader** const self);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file: sample_attributes.h
+ *
+ * Defines a store of sample attributes, e.g., `sex=female` or
+ * `population=X`. Every distinct attribute value (label) is indexed by a
+ * bitmap over the sample identifiers, so a boolean predicate over labels
+ * is evaluated with word-wise bitmap operations. The result is compiled
+ * into a sample set (vrd_AVL_Tree) that can be used as the `subset` of
+ * any table query, or registered in a vrd_Sample_Registry.
+ *
+ * Predicates are given in postfix order, e.g., the predicate
+ * `sex=female AND NOT population=X` is:
+ *
+ *     {{VRD_PREDICATE_LABEL, 11, "sex=female"},
+ *      {VRD_PREDICATE_LABEL, 13, "population=X"},
+ *      {VRD_PREDICATE_NOT, 0, NULL},
+ *      {VRD_PREDICATE_AND, 0, NULL}}
+ *
+ * The capacity bounds the sample identifiers that can be stored. Labels
+ * that are not in the store select no samples.
+ */
+
+
+#ifndef VRD_SAMPLE_ATTRIBUTES_H
+#define VRD_SAMPLE_ATTRIBUTES_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stddef.h>     // size_t
+
+#include "avl_tree.h"   // vrd_AVL_Tree
+
+
+static int const VRD_PREDICATE_LABEL = 0;
+static int const VRD_PREDICATE_AND   = 1;
+static int const VRD_PREDICATE_OR    = 2;
+static int const VRD_PREDICATE_NOT   = 3;
+
+
+typedef struct vrd_Predicate
+{
+    int op;
+    size_t len;
+    char const* label;  // only for VRD_PREDICATE_LABEL
+} vrd_Predicate;
+
+
+typedef struct vrd_Sample_Attributes vrd_Sample_Attributes;
+
+
+vrd_Sample_Attributes*
+vrd_Sample_attributes_init(size_t const capacity,
+                           size_t const label_capacity);
+
+
+void
+vrd_Sample_attributes_destroy(vrd_Sample_Attributes** const self);
+
+
+/**
+ * Assign a label to a sample identifier.
+ *
+ * @return 0 on success, -1 if the sample identifier exceeds the capacity
+ *         or the store is out of labels, or an error number otherwise.
+ */
+int
+vrd_Sample_attributes_insert(vrd_Sample_Attributes* const self,
+                             size_t const len,
+                             char const label[len],
+                             size_t const sample_id);
+
+
+/**
+ * Evaluate a predicate (in postfix order) and compile the selected
+ * sample identifiers into a sample set.
+ *
+ * @return A sample set owned by the caller, or NULL if the predicate is
+ *         malformed or on allocation failure.
+ */
+vrd_AVL_Tree*
+vrd_Sample_attributes_select(vrd_Sample_Attributes const* const self,
+                             size_t const count,
+                             vrd_Predicate const predicate[count]);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file: sample_registry.h
+ *
+ * Defines a registry of named sample sets. A sample set (vrd_AVL_Tree) is
+ * compiled once, registered under a name and can from then on be used as
+ * the `subset` of any table query without rebuilding it. The registry can
+ * be written along with the tables and read back later.
+ *
+ * Registered sample sets are immutable and owned by the registry; they
+ * can be queried concurrently. Inserting into the registry while other
+ * threads look up names is not safe.
+ */
+
+
+#ifndef VRD_SAMPLE_REGISTRY_H
+#define VRD_SAMPLE_REGISTRY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stddef.h>     // size_t
+
+#include "avl_tree.h"   // vrd_AVL_Tree
+
+
+typedef struct vrd_Sample_Registry vrd_Sample_Registry;
+
+
+vrd_Sample_Registry*
+vrd_Sample_registry_init(size_t const capacity);
+
+
+void
+vrd_Sample_registry_destroy(vrd_Sample_Registry** const self);
+
+
+/**
+ * Register a sample set under a name. On success the registry takes
+ * ownership of `subset`.
+ *
+ * @return 0 on success, -1 if the name is already in use or the
+ *         registry is full, or an error number otherwise.
+ */
+int
+vrd_Sample_registry_insert(vrd_Sample_Registry* const self,
+                           size_t const len,
+                           char const name[len],
+                           vrd_AVL_Tree* const subset);
+
+
+vrd_AVL_Tree const*
+vrd_Sample_registry_find(vrd_Sample_Registry const* const self,
+                         size_t const len,
+                         char const name[len]);
+
+
+int
+vrd_Sample_registry_read(vrd_Sample_Registry* const self,
+                         char const* const path);
+
+
+int
+vrd_Sample_registry_write(vrd_Sample_Registry const* const self,
+                          char const* const path);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
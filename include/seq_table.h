@@ -16,6 +16,11 @@ extern "C"
 typedef struct vrd_Seq_Table vrd_Seq_Table;
 
 
+/**
+ * Create a sequence table with an initial capacity. The table grows on
+ * demand; the index of a sequence never changes while it is in the
+ * table.
+ */
 vrd_Seq_Table*
 vrd_Seq_table_init(size_t const capacity);
 
@@ -46,6 +51,27 @@ int
 vrd_Seq_table_remove(vrd_Seq_Table* const self, size_t const elem);
 
 
+/**
+ * Renumber the sequences densely, keeping their order, and shrink the
+ * table to fit. On success `map` points to an array (to be freed by the
+ * caller) that maps every old index below the returned size onto its new
+ * index, or onto -1 for unused indices. All stored references must be
+ * renumbered with this map, see vrd_MNV_table_compact_seq.
+ *
+ * @return The number of entries in `map`, or -1 on failure.
+ */
+size_t
+vrd_Seq_table_compact(vrd_Seq_Table* const self, size_t** const map);
+
+
+/**
+ * A copy with the same indices and reference counts, e.g., to write in
+ * the background.
+ */
+vrd_Seq_Table*
+vrd_Seq_table_copy(vrd_Seq_Table const* const self);
+
+
 int
 vrd_Seq_table_read(vrd_Seq_Table* const self, char const* const path);
 
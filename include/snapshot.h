@@ -0,0 +1,93 @@
+/**
+ * @file: snapshot.h
+ *
+ * Writing a snapshot of the tables in the background. Starting a
+ * snapshot freezes the tables: the trees changed since the last snapshot
+ * at the same path and the sequence table are copied. The copies are
+ * written (incrementally) by a thread of its own, while the tables are
+ * updated and queried as usual.
+ *
+ * With a write-ahead log the updates are held off during the freeze, so
+ * the snapshot is a point in time of all tables, and the log is
+ * checkpointed once the snapshot is written. Without a log every tree is
+ * copied at a point where no update of it is in progress; the caller
+ * holds off updates during vrd_snapshot_start() for a point in time.
+ *
+ * The sequence table is not synchronized: as always the caller holds off
+ * updates of it during vrd_snapshot_start().
+ */
+
+
+#ifndef VRD_SNAPSHOT_H
+#define VRD_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stdbool.h>    // bool
+#include <stddef.h>     // size_t
+
+#include "../include/cov_table.h"   // vrd_Cov_Table
+#include "../include/mnv_table.h"   // vrd_MNV_Table
+#include "../include/seq_table.h"   // vrd_Seq_Table
+#include "../include/snv_table.h"   // vrd_SNV_Table
+#include "../include/wal.h"         // vrd_WAL
+
+
+typedef struct vrd_Snapshot vrd_Snapshot;
+
+
+/**
+ * Called from the snapshot thread after each table written (`done` out
+ * of `total`), and on failure with the error.
+ */
+typedef void vrd_Snapshot_Progress(void* const data,
+                                   size_t const done,
+                                   size_t const total,
+                                   int const error);
+
+
+/**
+ * Freezes the tables (NULL tables are skipped) and starts writing them
+ * to `<path>_snv`, `<path>_mnv`, `<path>_seq` and `<path>_cov`.
+ *
+ * @param wal: the log the tables are attached to (can be NULL).
+ * @param progress: can be NULL.
+ */
+vrd_Snapshot*
+vrd_snapshot_start(char const* const path,
+                   vrd_SNV_Table const* const snv,
+                   vrd_MNV_Table const* const mnv,
+                   vrd_Seq_Table const* const seq,
+                   vrd_Cov_Table const* const cov,
+                   vrd_WAL* const wal,
+                   vrd_Snapshot_Progress* const progress,
+                   void* const data);
+
+
+/**
+ * @return Whether the snapshot is done (written or failed).
+ */
+bool
+vrd_snapshot_poll(vrd_Snapshot const* const self,
+                  size_t* const done,
+                  size_t* const total);
+
+
+/**
+ * Waits for the snapshot to be done.
+ *
+ * @return 0 if the snapshot is written, the error otherwise.
+ */
+int
+vrd_snapshot_finish(vrd_Snapshot** const self);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
@@ -12,9 +12,24 @@ extern "C"
 #include <stdio.h>      // FILE
 
 #include "avl_tree.h"   // vrd_AVL_Tree
+#include "cohort_table.h"   // vrd_Cohort_Table
 #include "template.h"   // VRD_TEMPLATE
 
 
+/**
+ * An SNV as returned by vrd_SNV_table_query_region(): a copy, valid
+ * independent of later updates of the table.
+ */
+typedef struct vrd_SNV_Entry
+{
+    size_t position;
+    size_t allele_count;
+    size_t sample_id;
+    size_t phase;       // (size_t) -1 if homozygous
+    char inserted;      // IUPAC
+} vrd_SNV_Entry;
+
+
 #define VRD_TYPENAME SNV
 
 
@@ -42,6 +57,69 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query)(VRD_TEMPLATE(VRD_TYPENAME, _Table) cons
                                          vrd_AVL_Tree const* const subset);
 
 
+/**
+ * Count the SNVs for every inserted nucleotide at a position in a single
+ * traversal.
+ *
+ * The allele counts are added to the `heterozygous` and `homozygous`
+ * arrays indexed by the IUPAC index of the inserted nucleotide (see:
+ * vrd_iupac_to_idx()). Both arrays must hold at least `VRD_IUPAC_SIZE`
+ * elements and are not cleared by this function.
+ *
+ * @return The total allele count at the position, or `(size_t) -1` if
+ *         the reference sequence identifier is not found.
+ */
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_spectrum)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                  size_t const len,
+                                                  char const reference[len],
+                                                  size_t const position,
+                                                  vrd_AVL_Tree const* const subset,
+                                                  size_t heterozygous[],
+                                                  size_t homozygous[]);
+
+
+/**
+ * Query the total allele count, the homozygous allele count and the
+ * number of carriers of a variant in a single traversal.
+ *
+ * Carriers are the number of distinct samples with at least one
+ * matching entry; a sample matching more than once (e.g., through an
+ * ambiguity code or on both haplotypes) is counted once.
+ *
+ * @return The total allele count, or `(size_t) -1` if the reference
+ *         sequence identifier is not found or the carriers could not be
+ *         counted.
+ */
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                  size_t const len,
+                                                  char const reference[len],
+                                                  size_t const position,
+                                                  size_t const inserted,
+                                                  vrd_AVL_Tree const* const subset,
+                                                  size_t* const homozygous,
+                                                  size_t* const carriers);
+
+
+/**
+ * Stratified query: adds the allele counts of the matching SNVs to
+ * `count[i]` for every cohort `i` the carrier belongs to. The `count`
+ * array must hold vrd_Cohort_table_count() elements and is not cleared.
+ *
+ * @return 0 on success, -1 if the reference sequence identifier is not
+ *         found.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                 size_t const len,
+                                                 char const reference[len],
+                                                 size_t const position,
+                                                 size_t const inserted,
+                                                 vrd_Cohort_Table const* const cohorts,
+                                                 size_t count[]);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                 size_t const len_ref,
@@ -50,7 +128,7 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tabl
                                                 size_t const end,
                                                 vrd_AVL_Tree const* const subset,
                                                 size_t const len_res,
-                                                void* result[len_res]);
+                                                vrd_SNV_Entry result[len_res]);
 
 
 size_t
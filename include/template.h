@@ -6,5 +6,9 @@
 
 #define VRD_TEMPLATE(type, suffix) VRD_TEMPLATE_WRAP(suffix, type)
 
+#define VRD_TEMPLATE_STRING_WRAP(type) #type
+
+#define VRD_TEMPLATE_STRING(type) VRD_TEMPLATE_STRING_WRAP(type)
+
 
 #endif
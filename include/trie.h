@@ -52,6 +52,12 @@ size_t
 vrd_trie_key(vrd_Trie_Node const* const ptr, char** key);
 
 
+bool
+vrd_trie_key_equal(vrd_Trie_Node const* const ptr,
+                   size_t const len,
+                   char const key[len]);
+
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -7,10 +7,12 @@ extern "C"
 #endif
 
 
+#include <stdbool.h>    // bool
 #include <stddef.h>     // size_t
 #include <stdio.h>      // FILE
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/cohort_table.h"    // vrd_Cohort_Table
 #include "../include/cov_table.h"   // vrd_Cov_Table
 #include "../include/mnv_table.h"   // vrd_MNV_Table
 #include "../include/seq_table.h"   // vrd_Seq_Table
@@ -38,7 +40,18 @@ vrd_annotate_from_file(FILE* ostream,
                        vrd_SNV_Table const* const snv,
                        vrd_MNV_Table const* const mnv,
                        vrd_Seq_Table const* const seq,
-                       vrd_AVL_Tree const* const subset);
+                       vrd_AVL_Tree const* const subset,
+                       bool const zygosity);
+
+
+size_t
+vrd_annotate_cohorts_from_file(FILE* ostream,
+                               FILE* istream,
+                               vrd_Cov_Table const* const cov,
+                               vrd_SNV_Table const* const snv,
+                               vrd_MNV_Table const* const mnv,
+                               vrd_Seq_Table const* const seq,
+                               vrd_Cohort_Table const* const cohorts);
 
 
 #ifdef __cplusplus
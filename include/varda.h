@@ -32,18 +32,33 @@ vrd_version(int* const major,
 
 
 #include "avl_tree.h"       // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "batch.h"          // vrd_variants_from_files,
+                            // vrd_coverage_from_files
+#include "cohort_table.h"   // VRD_MAX_COHORTS, vrd_Cohort_Table,
+                            // vrd_Cohort_table_*
 #include "constants.h"      // VRD_MAX_*
 #include "cov_table.h"      // vrd_Cov_Table, vrd_Cov_table_*
 #include "diagnostics.h"    // vrd_Diagnostics
 #include "iupac.h"          // VRD_IUPAC_SIZE, vrd_iupac_to_idx,
-                            // vrd_idx_to_iupac
+                            // vrd_idx_to_iupac, vrd_iupac_match
 #include "mnv_table.h"      // vrd_MNV_Table, vrd_MNV_table_*
+#include "reader.h"         // vrd_Reader, vrd_reader_*
+#include "sample_attributes.h"  // VRD_PREDICATE_*, vrd_Predicate,
+                                // vrd_Sample_Attributes,
+                                // vrd_Sample_attributes_*
+#include "sample_registry.h"    // vrd_Sample_Registry,
+                                // vrd_Sample_registry_*
 #include "seq_table.h"      // vrd_Seq_Table, vrd_Seq_table_*
+#include "snapshot.h"       // vrd_Snapshot, vrd_snapshot_*
 #include "snv_table.h"      // vrd_SNV_Table, vrd_SNV_table_*
 #include "trie.h"           // vrd_Trie_Node, vrd_Trie, vrd_trie_*
 #include "utils.h"          // vrd_coverage_from_file,
                             // vrd_variants_from_file,
-                            // vrd_annotate_from_file
+                            // vrd_annotate_from_file,
+                            // vrd_annotate_cohorts_from_file
+#include "vcf.h"            // vrd_variants_from_vcf,
+                            // vrd_coverage_from_gvcf
+#include "wal.h"            // vrd_WAL, vrd_wal_*
 
 
 #ifdef __cplusplus
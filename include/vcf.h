@@ -0,0 +1,76 @@
+/**
+ * @file: vcf.h
+ *
+ * Streaming readers for VCF and gVCF files. Only the first sample column
+ * is used.
+ *
+ * Variants are normalized to the interbase (0-based, half-open) ranges
+ * used in the tables by trimming the common suffix and prefix of the
+ * reference and alternative alleles. Single nucleotide substitutions are
+ * inserted in the SNV table, all other variants in the MNV table.
+ * Symbolic alleles (e.g., `<NON_REF>`), breakends, and the overlapping
+ * deletion allele `*` are ignored.
+ *
+ * The allele count of a variant is the number of copies of its
+ * alternative allele in the genotype (GT). The phase is
+ *   - VRD_HOMOZYGOUS if all alleles of the genotype are equal;
+ *   - the phase set (PS) for phased genotypes (`|`);
+ *   - 0 for phased genotypes without phase set, i.e., all these
+ *     genotypes belong to the same phase set;
+ *   - the (1-based) position of the record for unphased genotypes.
+ * Phase sets are truncated to fit the range of the tables.
+ *
+ * On error all the entries of the sample are removed from the tables.
+ * Reading stops at the first malformed record.
+ */
+
+
+#ifndef VRD_VCF_H
+#define VRD_VCF_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stddef.h>     // size_t
+#include <stdio.h>      // FILE
+
+#include "../include/cov_table.h"   // vrd_Cov_Table
+#include "../include/mnv_table.h"   // vrd_MNV_Table
+#include "../include/seq_table.h"   // vrd_Seq_Table
+#include "../include/snv_table.h"   // vrd_SNV_Table
+
+
+/**
+ * @return The number of variants inserted.
+ */
+size_t
+vrd_variants_from_vcf(FILE* stream,
+                      vrd_SNV_Table* const snv,
+                      vrd_MNV_Table* const mnv,
+                      vrd_Seq_Table* const seq,
+                      size_t const sample_id);
+
+
+/**
+ * Inserts the regions covered by records with a called genotype, i.e.,
+ * the reference blocks (up to the END position) and the reference
+ * alleles of variant records. The allele count is the number of called
+ * alleles. Adjacent or overlapping regions with the same allele count
+ * are merged.
+ *
+ * @return The number of regions inserted.
+ */
+size_t
+vrd_coverage_from_gvcf(FILE* stream,
+                       vrd_Cov_Table* const cov,
+                       size_t const sample_id);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file: wal.h
+ *
+ * Write-ahead log of the updates of the tables. A table attached to a
+ * log (vrd_*_table_log()) appends a record for every insert, sample
+ * removal and sequence compaction. The log is replayed on top of the
+ * tables read from the last checkpoint. A checkpoint writes the tables
+ * and empties the log, so in between persisting a sample costs only the
+ * records of that sample.
+ *
+ * The inserted sequences of MNVs are logged with the MNVs; the sequence
+ * table itself is not logged.
+ *
+ * Records are buffered until vrd_wal_sync(). A torn record at the end of
+ * the log (a crash while appending) is discarded when the log is opened.
+ */
+
+
+#ifndef VRD_WAL_H
+#define VRD_WAL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stdbool.h>    // bool
+#include <stddef.h>     // size_t
+
+#include "../include/cov_table.h"   // vrd_Cov_Table
+#include "../include/mnv_table.h"   // vrd_MNV_Table
+#include "../include/seq_table.h"   // vrd_Seq_Table
+#include "../include/snv_table.h"   // vrd_SNV_Table
+
+
+typedef struct vrd_WAL vrd_WAL;
+
+
+/**
+ * Opens (or creates) the log at `path`. The sequence table is used to
+ * log the inserted sequences of MNVs (can be NULL without MNV tables).
+ */
+vrd_WAL*
+vrd_wal_open(char const* const path, vrd_Seq_Table const* const seq);
+
+
+void
+vrd_wal_close(vrd_WAL** const self);
+
+
+/**
+ * Applies the records of the log to the tables (records for a NULL
+ * table are skipped). Replayed updates are not logged again, nor are
+ * any other updates during the replay: replay before updating.
+ *
+ * @return The number of records applied or `(size_t) -1` on error.
+ */
+size_t
+vrd_wal_replay(vrd_WAL* const self,
+               vrd_SNV_Table* const snv,
+               vrd_MNV_Table* const mnv,
+               vrd_Seq_Table* const seq,
+               vrd_Cov_Table* const cov);
+
+
+/**
+ * Makes the records appended so far durable.
+ */
+int
+vrd_wal_sync(vrd_WAL* const self);
+
+
+/**
+ * A checkpoint: vrd_wal_checkpoint_begin() waits for the updates in
+ * progress and blocks new ones, then the caller writes all tables, and
+ * vrd_wal_checkpoint_end() empties the log. A crash in between leaves
+ * the log intact; the tables written record the position in the log up
+ * to which they contain the records, and a replay on top of them skips
+ * those records.
+ */
+int
+vrd_wal_checkpoint_begin(vrd_WAL* const self);
+
+
+/**
+ * @param written: whether the tables were written; if not the log is
+ *                 kept and the updates are unblocked.
+ */
+int
+vrd_wal_checkpoint_end(vrd_WAL* const self, bool const written);
+
+
+/**
+ * Ends the blocking part of a checkpoint in the background (instead of
+ * vrd_wal_checkpoint_end()): once the caller has frozen the tables, the
+ * log is moved aside and the updates continue in a new log. The tables
+ * are then written in the background and the checkpoint completes with
+ * vrd_wal_checkpoint_done(). On failure the updates are still blocked.
+ *
+ * One checkpoint in the background at the time: until it completes
+ * this fails.
+ */
+int
+vrd_wal_checkpoint_freeze(vrd_WAL* const self);
+
+
+/**
+ * @param written: whether the frozen tables were written; if not both
+ *                 logs are kept (and replayed) until the next
+ *                 vrd_wal_checkpoint_end().
+ */
+int
+vrd_wal_checkpoint_done(vrd_WAL* const self, bool const written);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
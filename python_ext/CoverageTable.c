@@ -14,7 +14,6 @@
 
 
 #include "template_table.inc"   // CoverageTable_*
-#include "../src/cov_tree.h"    // vrd_Cov_unpack
 
 
 #undef VRD_TYPENAME
@@ -60,15 +59,16 @@ CoverageTable_query_stab(CoverageTableObject* const self, PyObject* const args)
     size_t end = 0;
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "s#nn|O!:CoverageTable.query_stab", &reference, &len, &start, &end, &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "s#nn|O:CoverageTable.query_stab", &reference, &len, &start, &end, &list))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = NULL;
-    if (NULL != list)
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
     {
-        subset = sample_set(list);
+        subset = sample_set(list, &owned);
         if (NULL == subset)
         {
             return NULL;
@@ -78,7 +78,7 @@ CoverageTable_query_stab(CoverageTableObject* const self, PyObject* const args)
     size_t result = 0;
     Py_BEGIN_ALLOW_THREADS
     result = vrd_Cov_table_query_stab(self->table, len + 1, reference, start, end, subset);
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
     Py_END_ALLOW_THREADS
 
     if ((size_t) -1 == result)
@@ -101,15 +101,16 @@ CoverageTable_query_region(CoverageTableObject* const self, PyObject* const args
     size_t size = 0;
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "s#nnn|O!:CoverageTable.query_region", &reference, &len, &start, &end, &size, &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "s#nnn|O:CoverageTable.query_region", &reference, &len, &start, &end, &size, &list))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = NULL;
-    if (NULL != list)
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
     {
-        subset = sample_set(list);
+        subset = sample_set(list, &owned);
         if (NULL == subset)
         {
             return NULL;
@@ -117,10 +118,10 @@ CoverageTable_query_region(CoverageTableObject* const self, PyObject* const args
     } // if
 
     // FIXME: overflow
-    void** const variant = malloc(size * sizeof(*variant));
+    vrd_Cov_Entry* const variant = malloc(size * sizeof(*variant));
     if (NULL == variant)
     {
-        vrd_AVL_tree_destroy(&subset);
+        vrd_AVL_tree_destroy(&owned);
         return PyErr_NoMemory();
     } // if
 
@@ -129,7 +130,7 @@ CoverageTable_query_region(CoverageTableObject* const self, PyObject* const args
     count = vrd_Cov_table_query_region(self->table, len + 1, reference, start, end, subset, size, variant);
     Py_END_ALLOW_THREADS
 
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
 
     if ((size_t) -1 == count)
     {
@@ -147,17 +148,11 @@ CoverageTable_query_region(CoverageTableObject* const self, PyObject* const args
 
     for (size_t i = 0; i < count; ++i)
     {
-        size_t v_start = 0;
-        size_t v_end = 0;
-        size_t allele_count = 0;
-        size_t sample_id = 0;
-
-        vrd_Cov_unpack(variant[i], &v_start, &v_end, &allele_count, &sample_id);
         PyObject* const item = Py_BuildValue("{s:i,s:i,s:i,s:i}",
-                                             "start", v_start,
-                                             "end", v_end,
-                                             "allele_count", allele_count,
-                                             "sample_id", sample_id);
+                                             "start", variant[i].start,
+                                             "end", variant[i].end,
+                                             "allele_count", variant[i].allele_count,
+                                             "sample_id", variant[i].sample_id);
         if (NULL == item)
         {
             Py_DECREF(result);
@@ -185,12 +180,13 @@ CoverageTable_remove(CoverageTableObject* const self, PyObject* const args)
 {
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "O!:CoverageTable.remove", &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "O:CoverageTable.remove", &list))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = sample_set(list);
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* const subset = sample_set(list, &owned);
     if (NULL == subset)
     {
         return NULL;
@@ -199,7 +195,7 @@ CoverageTable_remove(CoverageTableObject* const self, PyObject* const args)
     size_t result = 0;
     Py_BEGIN_ALLOW_THREADS
     result = vrd_Cov_table_remove(self->table, subset);
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
     Py_END_ALLOW_THREADS
 
     return Py_BuildValue("i", result);
@@ -223,8 +219,8 @@ static PyMethodDef CoverageTable_methods[] =
      ":param string reference: The reference sequence ID\n"
      ":param integer start: The start position of the region (included)\n"
      ":param integer end: The end position of the region (excluded)\n"
-     ":param subset: A list of sample IDs (`integer`), defaults to `None`\n"
-     ":type subset: list, optional\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
      ":return: The number of contained covered regions\n"
      ":rtype: integer\n"},
 
@@ -235,16 +231,16 @@ static PyMethodDef CoverageTable_methods[] =
      ":param integer start: The start of the region\n"
      ":param integer end: The end of the region\n"
      ":param integer size: The maximum size of the result vector\n"
-     ":param subset: A list of sample IDs (`integer`), defaults to `None`\n"
-     ":type subset: list, optional\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
      ":return: A list of MNVs containted in the query interval\n"
      ":rtype: list of dictionaries\n"},
 
     {"remove", (PyCFunction) CoverageTable_remove, METH_VARARGS,
      "remove(subset)\n"
      "Remove for covered regions in the :py:class:`CoverageTable`\n\n"
-     ":param subset: A list of sample IDs (`integer`)\n"
-     ":type subset: list\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`\n"
+     ":type subset: list or :py:class:`SampleSet`\n"
      ":return: The number of removed covered regions\n"
      ":rtype: integer\n"},
 
@@ -253,14 +249,18 @@ static PyMethodDef CoverageTable_methods[] =
      "Reorders all structures in the :py:class:`CoverageTable`\n\n"},
 
     {"read", (PyCFunction) CoverageTable_read, METH_VARARGS,
-     "read(path)\n"
+     "read(path[, threads])\n"
      "Read a :py:class:`CoverageTable` from files\n\n"
-     ":param string path: A path including a prefix that identifies the files\n"},
+     ":param string path: A path including a prefix that identifies the files\n"
+     ":param integer threads: The number of threads reading the trees\n"
+     "    (default: 1)\n"},
 
     {"write", (PyCFunction) CoverageTable_write, METH_VARARGS,
-     "write(path)\n"
+     "write(path[, incremental])\n"
      "Write a :py:class:`CoverageTable` to files\n\n"
-     ":param string path: A path including a prefix that identifies the files\n"},
+     ":param string path: A path including a prefix that identifies the files\n"
+     ":param boolean incremental: Only write the trees changed since they were\n"
+     "    written to `path` (default: False)\n"},
 
     {"diagnostics", (PyCFunction) CoverageTable_diagnostics, METH_NOARGS,
      "diagnostics()\n"
@@ -17,7 +17,6 @@
 
 
 #include "template_table.inc"   // MNVTable_*
-#include "../src/mnv_tree.h"    // vrd_MNV_unpack
 
 
 #undef VRD_TYPENAME
@@ -62,15 +61,16 @@ MNVTable_query(MNVTableObject* const self, PyObject* const args)
     int homozygous = 0;
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "s#nn|npO!:MNVTable.query", &reference, &len, &start, &end, &inserted, &homozygous, &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "s#nn|npO:MNVTable.query", &reference, &len, &start, &end, &inserted, &homozygous, &list))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = NULL;
-    if (NULL != list)
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
     {
-        subset = sample_set(list);
+        subset = sample_set(list, &owned);
         if (NULL == subset)
         {
             return NULL;
@@ -80,7 +80,7 @@ MNVTable_query(MNVTableObject* const self, PyObject* const args)
     size_t result = 0;
     Py_BEGIN_ALLOW_THREADS
     result = vrd_MNV_table_query(self->table, len + 1, reference, start, end, inserted, homozygous != 0, subset);
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
     Py_END_ALLOW_THREADS
 
     if ((size_t) -1 == result)
@@ -99,12 +99,13 @@ MNVTable_remove(MNVTableObject* const self, PyObject* const args)
     PyObject* list = NULL;
     SequenceTableObject* seq = NULL;
 
-    if (!PyArg_ParseTuple(args, "O!O!:MNVTable.remove", &PyList_Type, &list, &SequenceTable, &seq))
+    if (!PyArg_ParseTuple(args, "OO!:MNVTable.remove", &list, &SequenceTable, &seq))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = sample_set(list);
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* const subset = sample_set(list, &owned);
     if (NULL == subset)
     {
         return NULL;
@@ -113,13 +114,38 @@ MNVTable_remove(MNVTableObject* const self, PyObject* const args)
     size_t result = 0;
     Py_BEGIN_ALLOW_THREADS
     result = vrd_MNV_table_remove_seq(self->table, subset, seq->table);
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
     Py_END_ALLOW_THREADS
 
     return Py_BuildValue("i", result);
 } // MNVTable_remove
 
 
+static PyObject*
+MNVTable_compact(MNVTableObject* const self, PyObject* const args)
+{
+    SequenceTableObject* seq = NULL;
+
+    if (!PyArg_ParseTuple(args, "O!:MNVTable.compact", &SequenceTable, &seq))
+    {
+        return NULL;
+    } // if
+
+    int ret = 0;
+    Py_BEGIN_ALLOW_THREADS
+    ret = vrd_MNV_table_compact_seq(self->table, seq->table);
+    Py_END_ALLOW_THREADS
+
+    if (0 != ret)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "MNVTable.compact: vrd_MNV_table_compact_seq() failed");
+        return NULL;
+    } // if
+
+    Py_RETURN_NONE;
+} // MNVTable_compact
+
+
 static PyObject*
 MNVTable_query_region(MNVTableObject* const self, PyObject* const args)
 {
@@ -131,15 +157,16 @@ MNVTable_query_region(MNVTableObject* const self, PyObject* const args)
     SequenceTableObject* seq = NULL;
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "s#nnnO!|O!:MNVTable.query_region", &reference, &len, &start, &end, &size, &SequenceTable, &seq, &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "s#nnnO!|O:MNVTable.query_region", &reference, &len, &start, &end, &size, &SequenceTable, &seq, &list))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = NULL;
-    if (NULL != list)
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
     {
-        subset = sample_set(list);
+        subset = sample_set(list, &owned);
         if (NULL == subset)
         {
             return NULL;
@@ -147,10 +174,10 @@ MNVTable_query_region(MNVTableObject* const self, PyObject* const args)
     } // if
 
     // FIXME: overflow
-    void** const variant = malloc(size * sizeof(*variant));
+    vrd_MNV_Entry* const variant = malloc(size * sizeof(*variant));
     if (NULL == variant)
     {
-        vrd_AVL_tree_destroy(&subset);
+        vrd_AVL_tree_destroy(&owned);
         return PyErr_NoMemory();
     } // if
 
@@ -159,7 +186,7 @@ MNVTable_query_region(MNVTableObject* const self, PyObject* const args)
     count = vrd_MNV_table_query_region(self->table, len + 1, reference, start, end, subset, size, variant);
     Py_END_ALLOW_THREADS
 
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
 
     if ((size_t) -1 == count)
     {
@@ -177,22 +204,14 @@ MNVTable_query_region(MNVTableObject* const self, PyObject* const args)
 
     for (size_t i = 0; i < count; ++i)
     {
-        size_t v_start = 0;
-        size_t v_end = 0;
-        size_t allele_count = 0;
-        size_t sample_id = 0;
-        size_t phase = 0;
-        size_t inserted = 0;
-
-        vrd_MNV_unpack(variant[i], &v_start, &v_end, &allele_count, &sample_id, &phase, &inserted);
         char* seq_inserted = NULL;
-        size_t const len = vrd_Seq_table_key(seq->table, inserted, &seq_inserted);
+        size_t const len = vrd_Seq_table_key(seq->table, variant[i].inserted, &seq_inserted);
         PyObject* const item = Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:s}",
-                                             "start", v_start,
-                                             "end", v_end,
-                                             "allele_count", allele_count,
-                                             "sample_id", sample_id,
-                                             "phase", phase,
+                                             "start", variant[i].start,
+                                             "end", variant[i].end,
+                                             "allele_count", variant[i].allele_count,
+                                             "sample_id", variant[i].sample_id,
+                                             "phase", variant[i].phase,
                                              "inserted", len == 1 ? "." : seq_inserted);
         free(seq_inserted);
         if (NULL == item)
@@ -272,8 +291,8 @@ static PyMethodDef MNVTable_methods[] =
      ":param integer end: The end position of the deleted part of the MNV\n"
      ":param integer inserted: The index for a sequence stored in :py:class:`SequenceTable`\n"
      ":param bool homozygous: Toggle to only count homozygous variants\n"
-     ":param subset: A list of sample IDs (`integer`), defaults to `None`\n"
-     ":type subset: list, optional\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
      ":return: The number of contained MNVs\n"
      ":rtype: integer\n"},
 
@@ -286,34 +305,44 @@ static PyMethodDef MNVTable_methods[] =
      ":param integer size: The maximum size of the result vector\n"
      ":param seq_table: The sequence table\n"
      ":type seq_table: :py:class:`SequenceTable`\n"
-     ":param subset: A list of sample IDs (`integer`), defaults to `None`\n"
-     ":type subset: list, optional\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
      ":return: A list of MNVs containted in the query interval\n"
      ":rtype: list of dictionaries\n"},
 
     {"remove", (PyCFunction) MNVTable_remove, METH_VARARGS,
      "remove(subset, seq_table)\n"
      "Remove for MNVs in the :py:class:`MNVTable`\n\n"
-     ":param subset: A list of sample IDs (`integer`)\n"
-     ":type subset: list\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`\n"
+     ":type subset: list or :py:class:`SampleSet`\n"
      ":param seq_table: The sequence table\n"
      ":type seq_table: :py:class:`SequenceTable`\n"
      ":return: The number of removed MNVs\n"
      ":rtype: integer\n"},
 
+    {"compact", (PyCFunction) MNVTable_compact, METH_VARARGS,
+     "compact(seq_table)\n"
+     "Renumber the sequences in the :py:class:`SequenceTable` densely and update the references in the :py:class:`MNVTable`. No other operation on either table may run meanwhile.\n\n"
+     ":param seq_table: The sequence table\n"
+     ":type seq_table: :py:class:`SequenceTable`\n"},
+
     {"reorder", (PyCFunction) MNVTable_reorder, METH_NOARGS,
      "reorder()\n"
      "Reorders all structures in the :py:class:`MNVTable`\n\n"},
 
     {"read", (PyCFunction) MNVTable_read, METH_VARARGS,
-     "read(path)\n"
+     "read(path[, threads])\n"
      "Read a :py:class:`MNVTable` from files\n\n"
-     ":param string path: A path including a prefix that identifies the files\n"},
+     ":param string path: A path including a prefix that identifies the files\n"
+     ":param integer threads: The number of threads reading the trees\n"
+     "    (default: 1)\n"},
 
     {"write", (PyCFunction) MNVTable_write, METH_VARARGS,
-     "write(path)\n"
+     "write(path[, incremental])\n"
      "Write a :py:class:`MNVTable` to files\n\n"
-     ":param string path: A path including a prefix that identifies the files\n"},
+     ":param string path: A path including a prefix that identifies the files\n"
+     ":param boolean incremental: Only write the trees changed since they were\n"
+     "    written to `path` (default: False)\n"},
 
     {"export", (PyCFunction) MNVTable_export, METH_VARARGS,
      "export(path, seq_table)\n"
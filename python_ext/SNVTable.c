@@ -5,7 +5,8 @@
 #include <stdlib.h>     // free, malloc
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
-#include "../include/iupac.h"       // vrd_iuapc_to_idx
+#include "../include/iupac.h"       // VRD_IUPAC_SIZE, vrd_iupac_to_idx,
+                                    // vrd_idx_to_iupac
 #include "../include/snv_table.h"   // vrd_SNV_Table, vrd_SNV_table_*
 #include "utils.h"      // CFG_*, sample_set
 #include "SNVTable.h"   // SNVTable*
@@ -15,7 +16,6 @@
 #define VRD_OBJNAME SNVTable
 
 #include "template_table.inc"   // SNVTable_*
-#include "../src/snv_tree.h"    // vrd_SNV_unpack
 
 #undef VRD_TYPENAME
 #undef VRD_OBJNAME
@@ -65,7 +65,7 @@ SNVTable_query(SNVTableObject* const self, PyObject* const args)
     int homozygous = 0;
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "s#ns#|pO!:SNVTable.query", &reference, &len, &position, &inserted, &len_inserted, &homozygous, &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "s#ns#|pO:SNVTable.query", &reference, &len, &position, &inserted, &len_inserted, &homozygous, &list))
     {
         return NULL;
     } // if
@@ -76,10 +76,11 @@ SNVTable_query(SNVTableObject* const self, PyObject* const args)
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = NULL;
-    if (NULL != list)
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
     {
-        subset = sample_set(list);
+        subset = sample_set(list, &owned);
         if (NULL == subset)
         {
             return NULL;
@@ -89,7 +90,7 @@ SNVTable_query(SNVTableObject* const self, PyObject* const args)
     size_t result = 0;
     Py_BEGIN_ALLOW_THREADS
     result = vrd_SNV_table_query(self->table, len + 1, reference, position, vrd_iupac_to_idx(inserted[0]), homozygous != 0, subset);
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
     Py_END_ALLOW_THREADS
 
     if ((size_t) -1 == result)
@@ -102,6 +103,86 @@ SNVTable_query(SNVTableObject* const self, PyObject* const args)
 } // SNVTable_query
 
 
+static PyObject*
+SNVTable_query_spectrum(SNVTableObject* const self, PyObject* const args)
+{
+    char const* reference = NULL;
+    size_t len = 0;
+    size_t position = 0;
+    PyObject* list = NULL;
+
+    if (!PyArg_ParseTuple(args, "s#n|O:SNVTable.query_spectrum", &reference, &len, &position, &list))
+    {
+        return NULL;
+    } // if
+
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
+    {
+        subset = sample_set(list, &owned);
+        if (NULL == subset)
+        {
+            return NULL;
+        } // if
+    } // if
+
+    size_t heterozygous[VRD_IUPAC_SIZE];
+    size_t homozygous[VRD_IUPAC_SIZE];
+    for (size_t i = 0; i < VRD_IUPAC_SIZE; ++i)
+    {
+        heterozygous[i] = 0;
+        homozygous[i] = 0;
+    } // for
+
+    size_t count = 0;
+    Py_BEGIN_ALLOW_THREADS
+    count = vrd_SNV_table_query_spectrum(self->table, len + 1, reference, position, subset, heterozygous, homozygous);
+    vrd_AVL_tree_destroy(&owned);
+    Py_END_ALLOW_THREADS
+
+    if ((size_t) -1 == count)
+    {
+        PyErr_SetString(PyExc_ValueError, "SNVTable.query_spectrum: reference not found");
+        return NULL;
+    } // if
+
+    PyObject* const result = PyDict_New();
+    if (NULL == result)
+    {
+        return PyErr_NoMemory();
+    } // if
+
+    for (size_t i = 0; i < VRD_IUPAC_SIZE; ++i)
+    {
+        if (0 == heterozygous[i] && 0 == homozygous[i])
+        {
+            continue;
+        } // if
+
+        char const key[2] = {vrd_idx_to_iupac(i), '\0'};
+        PyObject* const item = Py_BuildValue("{s:i,s:i}",
+                                             "heterozygous", heterozygous[i],
+                                             "homozygous", homozygous[i]);
+        if (NULL == item)
+        {
+            Py_DECREF(result);
+            return PyErr_NoMemory();
+        } // if
+
+        int const ret = PyDict_SetItemString(result, key, item);
+        Py_DECREF(item);
+        if (-1 == ret)
+        {
+            Py_DECREF(result);
+            return PyErr_NoMemory();
+        } // if
+    } // for
+
+    return result;
+} // SNVTable_query_spectrum
+
+
 static PyObject*
 SNVTable_query_region(SNVTableObject* const self, PyObject* const args)
 {
@@ -112,15 +193,16 @@ SNVTable_query_region(SNVTableObject* const self, PyObject* const args)
     size_t size = 0;
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "s#nnn|O!:SNVTable.query_region", &reference, &len, &start, &end, &size, &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "s#nnn|O:SNVTable.query_region", &reference, &len, &start, &end, &size, &list))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = NULL;
-    if (NULL != list)
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
     {
-        subset = sample_set(list);
+        subset = sample_set(list, &owned);
         if (NULL == subset)
         {
             return NULL;
@@ -128,10 +210,10 @@ SNVTable_query_region(SNVTableObject* const self, PyObject* const args)
     } // if
 
     // FIXME: overflow
-    void** const variant = malloc(size * sizeof(*variant));
+    vrd_SNV_Entry* const variant = malloc(size * sizeof(*variant));
     if (NULL == variant)
     {
-        vrd_AVL_tree_destroy(&subset);
+        vrd_AVL_tree_destroy(&owned);
         return PyErr_NoMemory();
     } // if
 
@@ -140,7 +222,7 @@ SNVTable_query_region(SNVTableObject* const self, PyObject* const args)
     count = vrd_SNV_table_query_region(self->table, len + 1, reference, start, end, subset, size, variant);
     Py_END_ALLOW_THREADS
 
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
 
     if ((size_t) -1 == count)
     {
@@ -158,19 +240,12 @@ SNVTable_query_region(SNVTableObject* const self, PyObject* const args)
 
     for (size_t i = 0; i < count; ++i)
     {
-        size_t position = 0;
-        size_t allele_count = 0;
-        size_t sample_id = 0;
-        size_t phase = 0;
-        char inserted = '\0';
-
-        vrd_SNV_unpack(variant[i], &position, &allele_count, &sample_id, &phase, &inserted);
         PyObject* const item = Py_BuildValue("{s:i,s:i,s:i,s:i,s:C}",
-                                             "position", position,
-                                             "allele_count", allele_count,
-                                             "sample_id", sample_id,
-                                             "phase", phase,
-                                             "inserted", inserted);
+                                             "position", variant[i].position,
+                                             "allele_count", variant[i].allele_count,
+                                             "sample_id", variant[i].sample_id,
+                                             "phase", variant[i].phase,
+                                             "inserted", variant[i].inserted);
         if (NULL == item)
         {
             Py_DECREF(result);
@@ -198,12 +273,13 @@ SNVTable_remove(SNVTableObject* const self, PyObject* const args)
 {
     PyObject* list = NULL;
 
-    if (!PyArg_ParseTuple(args, "O!:SNVTable.remove", &PyList_Type, &list))
+    if (!PyArg_ParseTuple(args, "O:SNVTable.remove", &list))
     {
         return NULL;
     } // if
 
-    vrd_AVL_Tree* subset = sample_set(list);
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* const subset = sample_set(list, &owned);
     if (NULL == subset)
     {
         return NULL;
@@ -212,7 +288,7 @@ SNVTable_remove(SNVTableObject* const self, PyObject* const args)
     size_t result = 0;
     Py_BEGIN_ALLOW_THREADS
     result = vrd_SNV_table_remove(self->table, subset);
-    vrd_AVL_tree_destroy(&subset);
+    vrd_AVL_tree_destroy(&owned);
     Py_END_ALLOW_THREADS
 
     return Py_BuildValue("i", result);
@@ -271,11 +347,21 @@ static PyMethodDef SNVTable_methods[] =
      ":param integer position: The position of the SNV\n"
      ":param string inserted: The inserted nucleotide from IUPAC\n"
      ":param bool homozygous: Toggle to only count homozygous variants\n"
-     ":param subset: A list of sample IDs (`integer`), defaults to `None`\n"
-     ":type subset: list, optional\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
      ":return: The number of contained SNVs\n"
      ":rtype: integer\n"},
 
+    {"query_spectrum", (PyCFunction) SNVTable_query_spectrum, METH_VARARGS,
+     "query_spectrum(reference, position[, subset])\n"
+     "Query for all inserted nucleotides at a position in the :py:class:`SNVTable`\n\n"
+     ":param string reference: The reference sequence ID\n"
+     ":param integer position: The position of the SNVs\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
+     ":return: The heterozygous and homozygous counts per inserted nucleotide\n"
+     ":rtype: dictionary\n"},
+
     {"query_region", (PyCFunction) SNVTable_query_region, METH_VARARGS,
      "query_region(reference, start, end, size[, subset])\n"
      "Query for SNVs in a region [start, end) in the :py:class:`SNVTable`\n\n"
@@ -283,16 +369,16 @@ static PyMethodDef SNVTable_methods[] =
      ":param integer start: The start of the region\n"
      ":param integer end: The end of the region\n"
      ":param integer size: The maximum size of the result vector\n"
-     ":param subset: A list of sample IDs (`integer`), defaults to `None`\n"
-     ":type subset: list, optional\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
      ":return: A list of SNVs containted in the query interval\n"
      ":rtype: list of dictionaries\n"},
 
     {"remove", (PyCFunction) SNVTable_remove, METH_VARARGS,
      "remove(subset)\n"
      "Remove for SNVs in the :py:class:`SNVTable`\n\n"
-     ":param subset: A list of sample IDs (`integer`)\n"
-     ":type subset: list\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`\n"
+     ":type subset: list or :py:class:`SampleSet`\n"
      ":return: The number of removed SNVs\n"
      ":rtype: integer\n"},
 
@@ -301,14 +387,18 @@ static PyMethodDef SNVTable_methods[] =
      "Reorders all structures in the :py:class:`SNVTable`\n\n"},
 
     {"read", (PyCFunction) SNVTable_read, METH_VARARGS,
-     "read(path)\n"
+     "read(path[, threads])\n"
      "Read a :py:class:`SNVTable` from files\n\n"
-     ":param string path: A path including a prefix that identifies the files\n"},
+     ":param string path: A path including a prefix that identifies the files\n"
+     ":param integer threads: The number of threads reading the trees\n"
+     "    (default: 1)\n"},
 
     {"write", (PyCFunction) SNVTable_write, METH_VARARGS,
-     "write(path)\n"
+     "write(path[, incremental])\n"
      "Write a :py:class:`SNVTable` to files\n\n"
-     ":param string path: A path including a prefix that identifies the files\n"},
+     ":param string path: A path including a prefix that identifies the files\n"
+     ":param boolean incremental: Only write the trees changed since they were\n"
+     "    written to `path` (default: False)\n"},
 
     {"export", (PyCFunction) SNVTable_export, METH_VARARGS,
      "export(path, seq_table)\n"
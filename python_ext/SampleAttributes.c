@@ -0,0 +1,241 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>     // Py*, METH_VARARGS, destructor
+
+#include <stddef.h>     // NULL, size_t
+#include <stdlib.h>     // free, realloc
+#include <string.h>     // strcmp
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/sample_attributes.h"   // VRD_PREDICATE_*,
+                                            // vrd_Predicate,
+                                            // vrd_Sample_Attributes,
+                                            // vrd_Sample_attributes_*
+#include "utils.h"      // CFG_*
+#include "SampleAttributes.h"   // SampleAttributes*
+#include "SampleSet.h"  // SampleSet_from_tree
+
+
+static PyObject*
+SampleAttributes_new(PyTypeObject* const type,
+                     PyObject* const args,
+                     PyObject* const kwds)
+{
+    (void) kwds;
+
+    size_t capacity = CFG_SAMPLE_CAPACITY;
+    size_t label_capacity = CFG_LABEL_CAPACITY;
+
+    if (!PyArg_ParseTuple(args, "|nn:SampleAttributes", &capacity, &label_capacity))
+    {
+        return NULL;
+    } // if
+
+    SampleAttributesObject* const self = (SampleAttributesObject*) type->tp_alloc(type, 0);
+
+    self->attributes = vrd_Sample_attributes_init(capacity, label_capacity);
+    if (NULL == self->attributes)
+    {
+        Py_TYPE(self)->tp_free((PyObject*) self);
+        PyErr_SetString(PyExc_RuntimeError, "SampleAttributes: vrd_Sample_attributes_init() failed");
+        return NULL;
+    } // if
+
+    return (PyObject*) self;
+} // SampleAttributes_new
+
+
+static void
+SampleAttributes_dealloc(SampleAttributesObject* const self)
+{
+    vrd_Sample_attributes_destroy(&self->attributes);
+    Py_TYPE(self)->tp_free((PyObject*) self);
+} // SampleAttributes_dealloc
+
+
+static PyObject*
+SampleAttributes_insert(SampleAttributesObject* const self, PyObject* const args)
+{
+    char const* label = NULL;
+    size_t len = 0;
+    size_t sample_id = 0;
+
+    if (!PyArg_ParseTuple(args, "s#n:SampleAttributes.insert", &label, &len, &sample_id))
+    {
+        return NULL;
+    } // if
+
+    if (0 != vrd_Sample_attributes_insert(self->attributes, len + 1, label, sample_id))
+    {
+        PyErr_SetString(PyExc_RuntimeError, "SampleAttributes.insert: vrd_Sample_attributes_insert() failed");
+        return NULL;
+    } // if
+
+    Py_RETURN_NONE;
+} // SampleAttributes_insert
+
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    vrd_Predicate* terms;
+} Predicate_Buffer;
+
+
+static int
+append(Predicate_Buffer* const buffer,
+       int const op,
+       size_t const len,
+       char const* const label)
+{
+    if (buffer->capacity <= buffer->count)
+    {
+        size_t const capacity = 0 == buffer->capacity ? 16 : buffer->capacity * 2;
+        vrd_Predicate* const terms = realloc(buffer->terms, sizeof(*terms) * capacity);
+        if (NULL == terms)
+        {
+            PyErr_NoMemory();
+            return -1;
+        } // if
+        buffer->terms = terms;
+        buffer->capacity = capacity;
+    } // if
+
+    buffer->terms[buffer->count].op = op;
+    buffer->terms[buffer->count].len = len;
+    buffer->terms[buffer->count].label = label;
+    buffer->count += 1;
+
+    return 0;
+} // append
+
+
+// Translates a nested predicate into postfix order; the labels are
+// borrowed from the predicate object
+static int
+compile(PyObject* const obj, Predicate_Buffer* const buffer)
+{
+    if (PyUnicode_Check(obj))
+    {
+        Py_ssize_t len = 0;
+        char const* const label = PyUnicode_AsUTF8AndSize(obj, &len);
+        if (NULL == label)
+        {
+            return -1;
+        } // if
+        return append(buffer, VRD_PREDICATE_LABEL, len + 1, label);
+    } // if
+
+    Py_ssize_t const size = PyTuple_Check(obj) ? PyTuple_GET_SIZE(obj) : 0;
+    char const* const name = 0 < size && PyUnicode_Check(PyTuple_GET_ITEM(obj, 0)) ? PyUnicode_AsUTF8(PyTuple_GET_ITEM(obj, 0)) : NULL;
+    if (NULL == name)
+    {
+        PyErr_SetString(PyExc_ValueError, "SampleAttributes.select: expected a label or an ('and' | 'or' | 'not', ...) tuple");
+        return -1;
+    } // if
+
+    int op = -1;
+    if (0 == strcmp(name, "and"))
+    {
+        op = VRD_PREDICATE_AND;
+    } // if
+    else if (0 == strcmp(name, "or"))
+    {
+        op = VRD_PREDICATE_OR;
+    } // if
+    else if (0 == strcmp(name, "not") && 2 == size)
+    {
+        op = VRD_PREDICATE_NOT;
+    } // if
+
+    if (-1 == op || 2 > size)
+    {
+        PyErr_SetString(PyExc_ValueError, "SampleAttributes.select: malformed predicate");
+        return -1;
+    } // if
+
+    for (Py_ssize_t i = 1; i < size; ++i)
+    {
+        if (0 != compile(PyTuple_GET_ITEM(obj, i), buffer))
+        {
+            return -1;
+        } // if
+        if (VRD_PREDICATE_NOT == op || 1 < i)
+        {
+            if (0 != append(buffer, op, 0, NULL))
+            {
+                return -1;
+            } // if
+        } // if
+    } // for
+
+    return 0;
+} // compile
+
+
+static PyObject*
+SampleAttributes_select(SampleAttributesObject* const self, PyObject* const args)
+{
+    PyObject* predicate = NULL;
+
+    if (!PyArg_ParseTuple(args, "O:SampleAttributes.select", &predicate))
+    {
+        return NULL;
+    } // if
+
+    Predicate_Buffer buffer = {0, 0, NULL};
+    if (0 != compile(predicate, &buffer))
+    {
+        free(buffer.terms);
+        return NULL;
+    } // if
+
+    vrd_AVL_Tree* const tree = vrd_Sample_attributes_select(self->attributes, buffer.count, buffer.terms);
+    free(buffer.terms);
+    if (NULL == tree)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "SampleAttributes.select: vrd_Sample_attributes_select() failed");
+        return NULL;
+    } // if
+
+    return SampleSet_from_tree(tree, NULL);
+} // SampleAttributes_select
+
+
+static PyMethodDef SampleAttributes_methods[] =
+{
+    {"insert", (PyCFunction) SampleAttributes_insert, METH_VARARGS,
+     "insert(label, sample_id)\n"
+     "Assign a label (e.g., `'sex=female'`) to a sample ID\n\n"
+     ":param string label: The label\n"
+     ":param integer sample_id: The sample ID\n"},
+
+    {"select", (PyCFunction) SampleAttributes_select, METH_VARARGS,
+     "select(predicate)\n"
+     "Select the sample IDs that satisfy a boolean predicate over labels\n\n"
+     ":param predicate: A label, or a tuple `('and', p, q, ...)`, `('or', p, q, ...)` or `('not', p)` of predicates\n"
+     ":type predicate: string or tuple\n"
+     ":return: The selected sample IDs\n"
+     ":rtype: :py:class:`SampleSet`\n"},
+
+    {NULL, NULL, 0, NULL}  // sentinel
+}; // SampleAttributes_methods
+
+
+PyTypeObject SampleAttributes =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cvarda.ext.SampleAttributes",
+    .tp_doc = "SampleAttributes([capacity[, label_capacity]])\n"
+              "Bitmap indexed sample attributes.\n\n"
+              ":param capacity: The maximum sample ID + 1, defaults to :c:data:`CFG_SAMPLE_CAPACITY`\n"
+              ":type capacity: integer, optional\n"
+              ":param label_capacity: defaults to :c:data:`CFG_LABEL_CAPACITY`\n"
+              ":type label_capacity: integer, optional\n",
+    .tp_basicsize = sizeof(SampleAttributesObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = SampleAttributes_new,
+    .tp_dealloc = (destructor) SampleAttributes_dealloc,
+    .tp_methods = SampleAttributes_methods
+}; // SampleAttributes
@@ -0,0 +1,21 @@
+#ifndef VRD_EXT_SAMPLE_ATTRIBUTES_H
+#define VRD_EXT_SAMPLE_ATTRIBUTES_H
+
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>     // PyObject
+
+#include "../include/sample_attributes.h"   // vrd_Sample_Attributes
+
+
+typedef struct
+{
+    PyObject_HEAD
+    vrd_Sample_Attributes* attributes;
+} SampleAttributesObject;
+
+
+extern PyTypeObject SampleAttributes;
+
+
+#endif
@@ -0,0 +1,188 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>     // Py*, METH_VARARGS, destructor
+
+#include <stddef.h>     // NULL, size_t
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/sample_registry.h"     // vrd_Sample_Registry,
+                                            // vrd_Sample_registry_*
+#include "utils.h"      // CFG_*, sample_set_compile
+#include "SampleRegistry.h"     // SampleRegistry*
+#include "SampleSet.h"  // SampleSet_from_tree
+
+
+static PyObject*
+SampleRegistry_new(PyTypeObject* const type,
+                   PyObject* const args,
+                   PyObject* const kwds)
+{
+    (void) kwds;
+
+    size_t capacity = CFG_REGISTRY_CAPACITY;
+
+    if (!PyArg_ParseTuple(args, "|n:SampleRegistry", &capacity))
+    {
+        return NULL;
+    } // if
+
+    SampleRegistryObject* const self = (SampleRegistryObject*) type->tp_alloc(type, 0);
+
+    self->registry = vrd_Sample_registry_init(capacity);
+    if (NULL == self->registry)
+    {
+        Py_TYPE(self)->tp_free((PyObject*) self);
+        PyErr_SetString(PyExc_RuntimeError, "SampleRegistry: vrd_Sample_registry_init() failed");
+        return NULL;
+    } // if
+
+    return (PyObject*) self;
+} // SampleRegistry_new
+
+
+static void
+SampleRegistry_dealloc(SampleRegistryObject* const self)
+{
+    vrd_Sample_registry_destroy(&self->registry);
+    Py_TYPE(self)->tp_free((PyObject*) self);
+} // SampleRegistry_dealloc
+
+
+static PyObject*
+SampleRegistry_insert(SampleRegistryObject* const self, PyObject* const args)
+{
+    char const* name = NULL;
+    size_t len = 0;
+    PyObject* list = NULL;
+
+    if (!PyArg_ParseTuple(args, "s#O!:SampleRegistry.insert", &name, &len, &PyList_Type, &list))
+    {
+        return NULL;
+    } // if
+
+    vrd_AVL_Tree* tree = sample_set_compile(list);
+    if (NULL == tree)
+    {
+        return NULL;
+    } // if
+
+    if (0 != vrd_Sample_registry_insert(self->registry, len + 1, name, tree))
+    {
+        vrd_AVL_tree_destroy(&tree);
+        PyErr_SetString(PyExc_KeyError, "SampleRegistry.insert: name already in use or registry full");
+        return NULL;
+    } // if
+
+    return SampleSet_from_tree(tree, (PyObject*) self);
+} // SampleRegistry_insert
+
+
+static PyObject*
+SampleRegistry_get(SampleRegistryObject* const self, PyObject* const args)
+{
+    char const* name = NULL;
+    size_t len = 0;
+
+    if (!PyArg_ParseTuple(args, "s#:SampleRegistry.get", &name, &len))
+    {
+        return NULL;
+    } // if
+
+    vrd_AVL_Tree const* const tree = vrd_Sample_registry_find(self->registry, len + 1, name);
+    if (NULL == tree)
+    {
+        PyErr_SetString(PyExc_KeyError, "SampleRegistry.get: name not found");
+        return NULL;
+    } // if
+
+    // the tree is never modified through a borrowed sample set
+    return SampleSet_from_tree((vrd_AVL_Tree*) tree, (PyObject*) self);
+} // SampleRegistry_get
+
+
+static PyObject*
+SampleRegistry_read(SampleRegistryObject* const self, PyObject* const args)
+{
+    char const* path = NULL;
+
+    if (!PyArg_ParseTuple(args, "s:SampleRegistry.read", &path))
+    {
+        return NULL;
+    } // if
+
+    if (0 != vrd_Sample_registry_read(self->registry, path))
+    {
+        PyErr_SetString(PyExc_RuntimeError, "SampleRegistry.read: vrd_Sample_registry_read() failed");
+        return NULL;
+    } // if
+
+    Py_RETURN_NONE;
+} // SampleRegistry_read
+
+
+static PyObject*
+SampleRegistry_write(SampleRegistryObject* const self, PyObject* const args)
+{
+    char const* path = NULL;
+
+    if (!PyArg_ParseTuple(args, "s:SampleRegistry.write", &path))
+    {
+        return NULL;
+    } // if
+
+    if (0 != vrd_Sample_registry_write(self->registry, path))
+    {
+        PyErr_SetString(PyExc_RuntimeError, "SampleRegistry.write: vrd_Sample_registry_write() failed");
+        return NULL;
+    } // if
+
+    Py_RETURN_NONE;
+} // SampleRegistry_write
+
+
+static PyMethodDef SampleRegistry_methods[] =
+{
+    {"insert", (PyCFunction) SampleRegistry_insert, METH_VARARGS,
+     "insert(name, sample_ids)\n"
+     "Compile a list of sample IDs and register it in the :py:class:`SampleRegistry`\n\n"
+     ":param string name: The name of the sample set\n"
+     ":param sample_ids: A list of sample IDs (`integer`)\n"
+     ":type sample_ids: list\n"
+     ":return: The registered sample set\n"
+     ":rtype: :py:class:`SampleSet`\n"},
+
+    {"get", (PyCFunction) SampleRegistry_get, METH_VARARGS,
+     "get(name)\n"
+     "Look up a sample set by name in the :py:class:`SampleRegistry`\n\n"
+     ":param string name: The name of the sample set\n"
+     ":return: The registered sample set\n"
+     ":rtype: :py:class:`SampleSet`\n"},
+
+    {"read", (PyCFunction) SampleRegistry_read, METH_VARARGS,
+     "read(path)\n"
+     "Read a :py:class:`SampleRegistry` from files\n\n"
+     ":param string path: A path including a prefix that identifies the files\n"},
+
+    {"write", (PyCFunction) SampleRegistry_write, METH_VARARGS,
+     "write(path)\n"
+     "Write a :py:class:`SampleRegistry` to files\n\n"
+     ":param string path: A path including a prefix that identifies the files\n"},
+
+    {NULL, NULL, 0, NULL}  // sentinel
+}; // SampleRegistry_methods
+
+
+PyTypeObject SampleRegistry =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cvarda.ext.SampleRegistry",
+    .tp_doc = "SampleRegistry([capacity])\n"
+              "Registry of named, precompiled sample sets.\n\n"
+              ":param capacity:  defaults to :c:data:`CFG_REGISTRY_CAPACITY`\n"
+              ":type capacity: integer, optional\n",
+    .tp_basicsize = sizeof(SampleRegistryObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = SampleRegistry_new,
+    .tp_dealloc = (destructor) SampleRegistry_dealloc,
+    .tp_methods = SampleRegistry_methods
+}; // SampleRegistry
@@ -0,0 +1,21 @@
+#ifndef VRD_EXT_SAMPLE_REGISTRY_H
+#define VRD_EXT_SAMPLE_REGISTRY_H
+
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>     // PyObject
+
+#include "../include/sample_registry.h"     // vrd_Sample_Registry
+
+
+typedef struct
+{
+    PyObject_HEAD
+    vrd_Sample_Registry* registry;
+} SampleRegistryObject;
+
+
+extern PyTypeObject SampleRegistry;
+
+
+#endif
@@ -0,0 +1,117 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>     // Py*, METH_VARARGS, destructor
+
+#include <stddef.h>     // NULL, size_t
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "utils.h"      // sample_set_compile
+#include "SampleSet.h"  // SampleSet*
+
+
+static PyObject*
+SampleSet_new(PyTypeObject* const type,
+              PyObject* const args,
+              PyObject* const kwds)
+{
+    (void) kwds;
+
+    PyObject* list = NULL;
+
+    if (!PyArg_ParseTuple(args, "O!:SampleSet", &PyList_Type, &list))
+    {
+        return NULL;
+    } // if
+
+    vrd_AVL_Tree* const tree = sample_set_compile(list);
+    if (NULL == tree)
+    {
+        return NULL;
+    } // if
+
+    SampleSetObject* const self = (SampleSetObject*) type->tp_alloc(type, 0);
+    if (NULL == self)
+    {
+        vrd_AVL_Tree* tmp = tree;
+        vrd_AVL_tree_destroy(&tmp);
+        return NULL;
+    } // if
+
+    self->tree = tree;
+    self->owner = NULL;
+
+    return (PyObject*) self;
+} // SampleSet_new
+
+
+static void
+SampleSet_dealloc(SampleSetObject* const self)
+{
+    if (NULL == self->owner)
+    {
+        vrd_AVL_tree_destroy(&self->tree);
+    } // if
+    Py_XDECREF(self->owner);
+    Py_TYPE(self)->tp_free((PyObject*) self);
+} // SampleSet_dealloc
+
+
+// Wraps a tree; if `owner` is NULL the sample set takes ownership of the
+// tree, otherwise the tree is borrowed from (and keeps alive) `owner`
+PyObject*
+SampleSet_from_tree(vrd_AVL_Tree* const tree, PyObject* const owner)
+{
+    SampleSetObject* const self = PyObject_New(SampleSetObject, &SampleSet);
+    if (NULL == self)
+    {
+        return NULL;
+    } // if
+
+    self->tree = tree;
+    Py_XINCREF(owner);
+    self->owner = owner;
+
+    return (PyObject*) self;
+} // SampleSet_from_tree
+
+
+static PyObject*
+SampleSet_is_element(SampleSetObject* const self, PyObject* const args)
+{
+    size_t sample_id = 0;
+
+    if (!PyArg_ParseTuple(args, "n:SampleSet.is_element", &sample_id))
+    {
+        return NULL;
+    } // if
+
+    return PyBool_FromLong(vrd_AVL_tree_is_element(self->tree, sample_id));
+} // SampleSet_is_element
+
+
+static PyMethodDef SampleSet_methods[] =
+{
+    {"is_element", (PyCFunction) SampleSet_is_element, METH_VARARGS,
+     "is_element(sample_id)\n"
+     "Test whether a sample ID is in the :py:class:`SampleSet`\n\n"
+     ":param integer sample_id: The sample ID\n"
+     ":rtype: bool\n"},
+
+    {NULL, NULL, 0, NULL}  // sentinel
+}; // SampleSet_methods
+
+
+PyTypeObject SampleSet =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cvarda.ext.SampleSet",
+    .tp_doc = "SampleSet(sample_ids)\n"
+              "A compiled set of sample IDs that can be used as `subset` in any query.\n\n"
+              ":param sample_ids: A list of sample IDs (`integer`)\n"
+              ":type sample_ids: list\n",
+    .tp_basicsize = sizeof(SampleSetObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = SampleSet_new,
+    .tp_dealloc = (destructor) SampleSet_dealloc,
+    .tp_methods = SampleSet_methods
+}; // SampleSet
@@ -0,0 +1,26 @@
+#ifndef VRD_EXT_SAMPLE_SET_H
+#define VRD_EXT_SAMPLE_SET_H
+
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>     // PyObject
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree
+
+
+typedef struct
+{
+    PyObject_HEAD
+    vrd_AVL_Tree* tree;
+    PyObject* owner;    // NULL if the tree is owned by this object
+} SampleSetObject;
+
+
+extern PyTypeObject SampleSet;
+
+
+PyObject*
+SampleSet_from_tree(vrd_AVL_Tree* const tree, PyObject* const owner);
+
+
+#endif
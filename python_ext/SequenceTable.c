@@ -221,7 +221,7 @@ PyTypeObject SequenceTable =
     .tp_name = "cvarda.ext.SequenceTable",
     .tp_doc = "SequenceTable([ref_capacity])\n"
               "Table containing (inserted) sequences.\n\n"
-              ":param ref_capacity:  defaults to :c:data:`CFG_SEQ_CAPACITY`\n"
+              ":param ref_capacity: The initial capacity, the table grows on demand, defaults to :c:data:`CFG_SEQ_CAPACITY`\n"
               ":type ref_capacity: integer, optional\n",
     .tp_basicsize = sizeof(SequenceTableObject),
     .tp_itemsize = 0,
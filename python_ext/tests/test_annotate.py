@@ -0,0 +1,48 @@
+import cvarda.ext as cvarda
+
+
+def test_annotate_zygosity(tmp_path):
+    cov_table = cvarda.CoverageTable()
+    snv_table = cvarda.SNVTable()
+    mnv_table = cvarda.MNVTable()
+    seq_table = cvarda.SequenceTable()
+
+    cov_table.insert('chr1', 0, 10, 2, 1)
+    cov_table.insert('chr1', 0, 10, 2, 2)
+    snv_table.insert('chr1', 3, 1, 1, "G", 1)
+    snv_table.insert('chr1', 3, 2, 2, "G", -1)
+
+    in_path = tmp_path / 'in.varda'
+    in_path.write_text('chr1 3 4 1 1 1 G\n')
+
+    out_path = tmp_path / 'out.varda'
+    assert cvarda.annotate_from_file(str(out_path), str(in_path), cov_table, snv_table, mnv_table, seq_table) == 1
+    assert out_path.read_text() == 'chr1\t3\t4\tG\t3:4\n'
+
+    assert cvarda.annotate_from_file(str(out_path), str(in_path), cov_table, snv_table, mnv_table, seq_table, zygosity=True) == 1
+    assert out_path.read_text() == 'chr1\t3\t4\tG\t3:2:2:4\n'
+
+    assert cvarda.annotate_from_file(str(out_path), str(in_path), cov_table, snv_table, mnv_table, seq_table, [2], True) == 1
+    assert out_path.read_text() == 'chr1\t3\t4\tG\t2:2:1:2\n'
+
+
+def test_annotate_cohorts(tmp_path):
+    cov_table = cvarda.CoverageTable()
+    snv_table = cvarda.SNVTable()
+    mnv_table = cvarda.MNVTable()
+    seq_table = cvarda.SequenceTable()
+
+    for sample_id in range(1, 4):
+        cov_table.insert('chr1', 0, 10, 2, sample_id)
+    snv_table.insert('chr1', 3, 1, 1, "G", 1)
+    snv_table.insert('chr1', 3, 2, 2, "G", -1)
+    seq_index = seq_table.insert("AC")
+    mnv_table.insert('chr1', 5, 7, 1, 3, seq_index, 1)
+
+    in_path = tmp_path / 'in.varda'
+    in_path.write_text('chr1 3 4 1 1 1 G\nchr1 5 7 1 1 2 AC\n')
+
+    out_path = tmp_path / 'out.varda'
+    assert cvarda.annotate_cohorts_from_file(str(out_path), str(in_path), cov_table, snv_table, mnv_table, seq_table, [[1, 2, 3], [2], [1, 3]]) == 2
+    assert out_path.read_text() == ('chr1\t3\t4\tG\t3:6\t2:2\t1:4\n'
+                                    'chr1\t5\t7\tAC\t1:6\t0:2\t1:4\n')
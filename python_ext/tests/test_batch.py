@@ -0,0 +1,55 @@
+import pytest
+
+import cvarda.ext as cvarda
+
+
+def test_variants_from_files(tmp_path):
+    snv_table = cvarda.SNVTable()
+    mnv_table = cvarda.MNVTable()
+    seq_table = cvarda.SequenceTable()
+
+    samples = []
+    for sample_id in range(1, 5):
+        path = tmp_path / f'sample_{sample_id}.varda'
+        path.write_text(f'chr1 {sample_id} {sample_id + 1} 1 -1 1 A\n'
+                        f'chr2 10 11 1 0 1 T\n'
+                        f'chr2 20 22 1 0 2 GG\n')
+        samples.append((str(path), sample_id))
+
+    ret = cvarda.variants_from_files(samples, snv_table, mnv_table, seq_table)
+    assert ret == 12
+
+    assert snv_table.query('chr1', 3, 'A') == 1
+    assert snv_table.query('chr2', 10, 'T') == 4
+    assert mnv_table.query('chr2', 20, 22, seq_table.query('GG')) == 4
+
+
+def test_coverage_from_files(tmp_path):
+    cov_table = cvarda.CoverageTable()
+
+    samples = []
+    for sample_id in range(1, 5):
+        path = tmp_path / f'sample_{sample_id}.varda'
+        path.write_text('chr1 0 100 2\nchr2 0 100 2\n')
+        samples.append((str(path), sample_id))
+
+    ret = cvarda.coverage_from_files(samples, cov_table)
+    assert ret == 8
+    assert cov_table.query_stab('chr1', 10, 20) == 8
+
+
+def test_variants_from_files_invalid(tmp_path):
+    snv_table = cvarda.SNVTable()
+    mnv_table = cvarda.MNVTable()
+    seq_table = cvarda.SequenceTable()
+
+    path = tmp_path / 'sample_1.varda'
+    path.write_text('chr1 10 11 1 0 1 A\n'
+                    f'chr1 20 22 1 0 2048 {"G" * 1023}\n')
+
+    with pytest.raises(ValueError):
+        cvarda.variants_from_files([(str(path), 1)], snv_table, mnv_table, seq_table)
+
+    # nothing of the batch is inserted
+    with pytest.raises(ValueError):
+        snv_table.query('chr1', 10, 'A')
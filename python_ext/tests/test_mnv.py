@@ -18,3 +18,20 @@ def test_mnv_common_end():
     assert mnv_table.query("chr1", 2, 4, index) == 1
 
     assert mnv_table.query("chr1", 3, 4, index) == 0
+
+
+def test_mnv_compact():
+    mnv_table = cvarda.MNVTable()
+    seq_table = cvarda.SequenceTable()
+
+    removed = seq_table.insert("CC")
+    kept = seq_table.insert("GG")
+    assert kept == 1
+
+    mnv_table.insert("chr1", 1, 2, 1, 1, removed, 0)
+    mnv_table.insert("chr1", 3, 4, 1, 2, kept, 0)
+    assert mnv_table.remove([1], seq_table) == 1
+
+    mnv_table.compact(seq_table)
+    assert seq_table.query("GG") == 0
+    assert mnv_table.query("chr1", 3, 4, 0) == 1
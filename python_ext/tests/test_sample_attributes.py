@@ -0,0 +1,34 @@
+import pytest
+
+import cvarda.ext as cvarda
+
+
+def test_sample_attributes():
+    attributes = cvarda.SampleAttributes()
+    attributes.insert('sex=female', 1)
+    attributes.insert('sex=female', 2)
+    attributes.insert('population=X', 2)
+    attributes.insert('population=Y', 3)
+
+    subset = attributes.select(('and', 'sex=female', ('not', 'population=X')))
+    assert subset.is_element(1)
+    assert not subset.is_element(2)
+
+    subset = attributes.select(('or', 'population=X', 'population=Y', 'sex=female'))
+    assert all(subset.is_element(i) for i in (1, 2, 3))
+    assert not subset.is_element(0)
+
+    snv_table = cvarda.SNVTable()
+    snv_table.insert('chr1', 10, 1, 1, 'A')
+    snv_table.insert('chr1', 10, 1, 2, 'A')
+    assert snv_table.query('chr1', 10, 'A', False, attributes.select('population=X')) == 1
+
+
+def test_sample_attributes_malformed():
+    attributes = cvarda.SampleAttributes()
+    with pytest.raises(ValueError):
+        attributes.select(('xor', 'a', 'b'))
+    with pytest.raises(ValueError):
+        attributes.select(('not', 'a', 'b'))
+    with pytest.raises(ValueError):
+        attributes.select(1)
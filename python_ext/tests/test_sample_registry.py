@@ -0,0 +1,47 @@
+import pytest
+
+import cvarda.ext as cvarda
+
+
+def test_sample_set():
+    snv_table = cvarda.SNVTable()
+    snv_table.insert('chr1', 10, 1, 1, 'A')
+    snv_table.insert('chr1', 10, 1, 2, 'A')
+
+    subset = cvarda.SampleSet([1])
+    assert subset.is_element(1)
+    assert not subset.is_element(2)
+    assert snv_table.query('chr1', 10, 'A', False, subset) == 1
+    assert snv_table.query('chr1', 10, 'A', False, [1, 2]) == 2
+
+
+def test_sample_set_type():
+    snv_table = cvarda.SNVTable()
+    with pytest.raises(TypeError):
+        snv_table.query('chr1', 10, 'A', False, 1)
+
+
+def test_sample_registry(tmp_path):
+    snv_table = cvarda.SNVTable()
+    snv_table.insert('chr1', 10, 1, 1, 'A')
+    snv_table.insert('chr1', 10, 1, 2, 'A')
+
+    registry = cvarda.SampleRegistry()
+    cases = registry.insert('cases', [2])
+    assert snv_table.query('chr1', 10, 'A', False, cases) == 1
+
+    with pytest.raises(KeyError):
+        registry.insert('cases', [1])
+    with pytest.raises(KeyError):
+        registry.get('controls')
+
+    path = str(tmp_path / 'registry')
+    registry.write(path)
+    del registry, cases
+
+    registry = cvarda.SampleRegistry()
+    registry.read(path)
+    cases = registry.get('cases')
+    del registry
+    assert cases.is_element(2)
+    assert snv_table.query('chr1', 10, 'A', False, cases) == 1
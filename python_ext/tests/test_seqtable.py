@@ -60,3 +60,13 @@ def test_seq_table_trie():
     for key in words:
         assert None is seq.query(key)
 
+
+
+def test_seq_table_grow():
+    seq_table = cvarda.SequenceTable(2)
+
+    for idx in range(100):
+        assert seq_table.insert(str(idx)) == idx
+
+    for idx in range(100):
+        assert seq_table.query(str(idx)) == idx
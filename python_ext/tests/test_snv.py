@@ -1,3 +1,5 @@
+import gzip
+
 import cvarda.ext as cvarda
 
 
@@ -26,3 +28,70 @@ def test_snv_entries():
 
     diag = mnv_table.diagnostics()
     assert diag == {'chr1': {'height': 1, 'entry_size': 32, 'entries': 1}}
+
+
+def test_snv_query_spectrum():
+    snv_table = cvarda.SNVTable()
+
+    snv_table.insert('chr1', 10, 1, 1, "A", 1)
+    snv_table.insert('chr1', 10, 2, 2, "A", -1)
+    snv_table.insert('chr1', 10, 1, 3, "G", 1)
+    snv_table.insert('chr1', 11, 1, 1, "T", 1)
+
+    spectrum = snv_table.query_spectrum('chr1', 10)
+    assert spectrum == {'A': {'heterozygous': 1, 'homozygous': 2},
+                        'G': {'heterozygous': 1, 'homozygous': 0}}
+
+    spectrum = snv_table.query_spectrum('chr1', 10, [3])
+    assert spectrum == {'G': {'heterozygous': 1, 'homozygous': 0}}
+
+
+def test_snv_query_iupac():
+    snv_table = cvarda.SNVTable()
+
+    snv_table.insert('chr1', 10, 1, 1, "A", 1)
+    snv_table.insert('chr1', 10, 2, 2, "G", 1)
+    snv_table.insert('chr1', 10, 1, 3, "T", 1)
+
+    assert snv_table.query('chr1', 10, "A") == 1
+    assert snv_table.query('chr1', 10, "R") == 3
+    assert snv_table.query('chr1', 10, "N") == 4
+    assert snv_table.query('chr1', 10, "C") == 0
+
+
+def test_variants_from_gzip(tmp_path):
+    snv_table = cvarda.SNVTable()
+    mnv_table = cvarda.MNVTable()
+    seq_table = cvarda.SequenceTable()
+
+    with open('python_ext/tests/test_variants_small.varda', 'rb') as file:
+        data = file.read()
+
+    path = str(tmp_path / 'variants.varda.gz')
+    with gzip.open(path, 'wb') as file:
+        file.write(data)
+
+    ret = cvarda.variants_from_file(path, 1, snv_table, mnv_table, seq_table)
+    assert ret == 3
+    diag = snv_table.diagnostics()
+    assert diag == {'chr1': {'height': 2, 'entry_size': 20, 'entries': 2}}
+
+
+def test_snv_write_incremental(tmp_path):
+    snv_table = cvarda.SNVTable()
+    snv_table.insert('chr1', 10, 1, 1, "A", 1)
+    snv_table.insert('chr2', 10, 1, 1, "A", 1)
+
+    path = str(tmp_path / 'snv')
+    snv_table.write(path, True)
+
+    snv_table.insert('chr1', 10, 1, 2, "A", 1)
+    (tmp_path / 'snv_tree_1.bin').unlink()
+    snv_table.write(path, True)
+    assert not (tmp_path / 'snv_tree_1.bin').exists()
+
+    snv_table.write(path)
+    copy = cvarda.SNVTable()
+    copy.read(path, 2)
+    assert copy.query('chr1', 10, "A") == 2
+    assert copy.query('chr2', 10, "A") == 1
@@ -0,0 +1,35 @@
+import gzip
+
+import cvarda.ext as cvarda
+
+
+VCF = '''##fileformat=VCFv4.2
+#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tsample
+chr1\t1\t.\tG\t<NON_REF>\t.\t.\tEND=99\tGT\t0/0
+chr1\t100\t.\tA\tG,<NON_REF>\t50\tPASS\t.\tGT:PS\t0|1:100
+chr1\t101\t.\tC\tT\t50\tPASS\t.\tGT\t1/1
+chr1\t102\t.\tACGT\tA\t50\tPASS\t.\tGT\t0/1
+chr1\t106\t.\tA\t<NON_REF>\t.\t.\tEND=200\tGT\t0/0
+'''
+
+
+def test_variants_from_vcf(tmp_path):
+    snv_table = cvarda.SNVTable()
+    mnv_table = cvarda.MNVTable()
+    seq_table = cvarda.SequenceTable()
+    cov_table = cvarda.CoverageTable()
+
+    path = str(tmp_path / 'sample.g.vcf.gz')
+    with gzip.open(path, 'wt') as file:
+        file.write(VCF)
+
+    ret = cvarda.variants_from_vcf(path, 1, snv_table, mnv_table, seq_table)
+    assert ret == 3
+
+    assert snv_table.query('chr1', 99, 'G') == 1
+    assert snv_table.query('chr1', 100, 'T', True) == 2
+    assert mnv_table.query('chr1', 102, 105, seq_table.query('')) == 1
+
+    ret = cvarda.coverage_from_gvcf(path, 1, cov_table)
+    assert ret == 1
+    assert cov_table.query_stab('chr1', 150, 151) == 2
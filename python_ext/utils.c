@@ -4,11 +4,14 @@
 #include <stddef.h>     // NULL, size_t
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
-#include "utils.h"  // sample_set
+#include "../include/cohort_table.h"    // VRD_MAX_COHORTS, vrd_Cohort_Table,
+                                        // vrd_Cohort_table_*
+#include "utils.h"  // cohort_table, sample_set, sample_set_compile
+#include "SampleSet.h"  // SampleSet, SampleSetObject
 
 
 vrd_AVL_Tree*
-sample_set(PyObject* const list)
+sample_set_compile(PyObject* const list)
 {
     size_t const n = PyList_Size(list);
     vrd_AVL_Tree* tree = vrd_AVL_tree_init(n);
@@ -31,17 +34,101 @@ sample_set(PyObject* const list)
         if (0 != overflow)
         {
             vrd_AVL_tree_destroy(&tree);
-            PyErr_SetString(PyExc_ValueError, "sample_set(): integer overflow");
+            PyErr_SetString(PyExc_ValueError, "sample_set_compile(): integer overflow");
             return NULL;
         } // if
 
         if (0 != vrd_AVL_tree_insert(tree, sample_id))
         {
             vrd_AVL_tree_destroy(&tree);
-            PyErr_SetString(PyExc_RuntimeError, "sample_set(): vrd_avl_tree_insert() failed");
+            PyErr_SetString(PyExc_RuntimeError, "sample_set_compile(): vrd_avl_tree_insert() failed");
             return NULL;
         } // if
     } // for
 
     return tree;
+} // sample_set_compile
+
+
+vrd_AVL_Tree const*
+sample_set(PyObject* const obj, vrd_AVL_Tree** const owned)
+{
+    *owned = NULL;
+
+    if (PyObject_TypeCheck(obj, &SampleSet))
+    {
+        return ((SampleSetObject*) obj)->tree;
+    } // if
+
+    if (!PyList_Check(obj))
+    {
+        PyErr_SetString(PyExc_TypeError, "sample_set(): expected a list or a SampleSet");
+        return NULL;
+    } // if
+
+    *owned = sample_set_compile(obj);
+    return *owned;
 } // sample_set
+
+
+vrd_Cohort_Table*
+cohort_table(PyObject* const list)
+{
+    size_t const n = PyList_Size(list);
+    if (VRD_MAX_COHORTS < n)
+    {
+        PyErr_SetString(PyExc_ValueError, "cohort_table(): too many cohorts");
+        return NULL;
+    } // if
+
+    size_t capacity = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        PyObject* const cohort = PyList_GetItem(list, i);
+        if (!PyList_Check(cohort))
+        {
+            PyErr_SetString(PyExc_TypeError, "cohort_table(): expected a list of sample IDs");
+            return NULL;
+        } // if
+
+        size_t const m = PyList_Size(cohort);
+        for (size_t j = 0; j < m; ++j)
+        {
+            size_t const sample_id = PyLong_AsSize_t(PyList_GetItem(cohort, j));
+            if (NULL != PyErr_Occurred())
+            {
+                return NULL;
+            } // if
+
+            if (sample_id >= capacity)
+            {
+                capacity = sample_id + 1;
+            } // if
+        } // for
+    } // for
+
+    vrd_Cohort_Table* table = vrd_Cohort_table_init(n, capacity);
+    if (NULL == table)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "cohort_table(): vrd_Cohort_table_init() failed");
+        return NULL;
+    } // if
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        PyObject* const cohort = PyList_GetItem(list, i);
+        size_t const m = PyList_Size(cohort);
+        for (size_t j = 0; j < m; ++j)
+        {
+            size_t const sample_id = PyLong_AsSize_t(PyList_GetItem(cohort, j));
+            if (0 != vrd_Cohort_table_insert(table, i, sample_id))
+            {
+                vrd_Cohort_table_destroy(&table);
+                PyErr_SetString(PyExc_RuntimeError, "cohort_table(): vrd_Cohort_table_insert() failed");
+                return NULL;
+            } // if
+        } // for
+    } // for
+
+    return table;
+} // cohort_table
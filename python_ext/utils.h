@@ -8,15 +8,29 @@
 #include <stddef.h>     // size_t
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/cohort_table.h"    // vrd_Cohort_Table
 
 
 static size_t const CFG_REF_CAPACITY = 1000;
 static size_t const CFG_SEQ_CAPACITY = 100000;
 static size_t const CFG_TREE_CAPACITY = 1 << 24;
+static size_t const CFG_REGISTRY_CAPACITY = 1000;
+static size_t const CFG_SAMPLE_CAPACITY = 1 << 20;
+static size_t const CFG_LABEL_CAPACITY = 1000;
+static size_t const CFG_READER_THREADS = 4;
+static size_t const CFG_IMPORT_THREADS = 8;
 
 
 vrd_AVL_Tree*
-sample_set(PyObject* const list);
+sample_set_compile(PyObject* const list);
+
+
+vrd_AVL_Tree const*
+sample_set(PyObject* const obj, vrd_AVL_Tree** const owned);
+
+
+vrd_Cohort_Table*
+cohort_table(PyObject* const list);
 
 
 #endif
@@ -1,7 +1,7 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>     // Py*
 
-#include <errno.h>      // errno
+#include <errno.h>      // EINVAL, ENOMEM, errno
 #include <stddef.h>     // NULL
 #include <stdio.h>      // FILE, fclose, fopen, fprintf, stderr
 #include <stdlib.h>     // EXIT_*, calloc, free
@@ -10,9 +10,13 @@
 
 #include "CoverageTable.h"  // CoverageTable*
 #include "MNVTable.h"       // MNVTable*
+#include "SampleAttributes.h"   // SampleAttributes*
+#include "SampleRegistry.h" // SampleRegistry*
+#include "SampleSet.h"      // SampleSet*
 #include "SequenceTable.h"  // SequenceTable*
 #include "SNVTable.h"       // SNVTable*
-#include "utils.h"          // sample_set
+#include "utils.h"          // CFG_IMPORT_THREADS, CFG_READER_THREADS,
+                            // cohort_table, sample_set
 
 
 static PyObject*
@@ -36,11 +40,33 @@ coverage_from_file(PyObject* const self, PyObject* const args)
         return PyErr_SetFromErrno(PyExc_OSError);
     } // if
 
+    errno = 0;
+    vrd_Reader* reader = vrd_reader_open(stream, CFG_READER_THREADS);
+    if (NULL == reader)
+    {
+        fclose(stream);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
     size_t count = 0;
+    int err = 0;
     Py_BEGIN_ALLOW_THREADS
-    count = vrd_coverage_from_file(stream, cov->table, sample_id);
+    count = vrd_coverage_from_file(vrd_reader_stream(reader), cov->table, sample_id);
+    err = vrd_reader_close(&reader);
     Py_END_ALLOW_THREADS
 
+    if (0 != err)
+    {
+        fclose(stream);
+        if (0 < err)
+        {
+            errno = err;
+            return PyErr_SetFromErrno(PyExc_OSError);
+        } // if
+        PyErr_SetString(PyExc_ValueError, "coverage_from_file: corrupt compressed input");
+        return NULL;
+    } // if
+
     errno = 0;
     if (0 != fclose(stream))
     {
@@ -74,11 +100,33 @@ variants_from_file(PyObject* const self, PyObject* const args)
         return PyErr_SetFromErrno(PyExc_OSError);
     } // if
 
+    errno = 0;
+    vrd_Reader* reader = vrd_reader_open(stream, CFG_READER_THREADS);
+    if (NULL == reader)
+    {
+        fclose(stream);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
     size_t count = 0;
+    int err = 0;
     Py_BEGIN_ALLOW_THREADS
-    count = vrd_variants_from_file(stream, snv->table, mnv->table, seq->table, sample_id);
+    count = vrd_variants_from_file(vrd_reader_stream(reader), snv->table, mnv->table, seq->table, sample_id);
+    err = vrd_reader_close(&reader);
     Py_END_ALLOW_THREADS
 
+    if (0 != err)
+    {
+        fclose(stream);
+        if (0 < err)
+        {
+            errno = err;
+            return PyErr_SetFromErrno(PyExc_OSError);
+        } // if
+        PyErr_SetString(PyExc_ValueError, "variants_from_file: corrupt compressed input");
+        return NULL;
+    } // if
+
     errno = 0;
     if (0 != fclose(stream))
     {
@@ -89,11 +137,339 @@ variants_from_file(PyObject* const self, PyObject* const args)
 } // variants_from_file
 
 
+// The opened files of a batch import
+struct Batch
+{
+    size_t count;
+    FILE** files;
+    vrd_Reader** readers;
+    FILE** streams;
+    size_t* sample_id;
+}; // Batch
+
+
+static int
+batch_close(struct Batch* const batch, char const* const name)
+{
+    int err = 0;
+    for (size_t i = 0; i < batch->count; ++i)
+    {
+        int const ret = vrd_reader_close(&batch->readers[i]);
+        if (0 == err)
+        {
+            err = ret;
+        } // if
+        errno = 0;
+        if (0 != fclose(batch->files[i]) && 0 == err)
+        {
+            err = errno;
+        } // if
+    } // for
+
+    free(batch->files);
+    free(batch->readers);
+    free(batch->streams);
+    free(batch->sample_id);
+
+    if (0 < err)
+    {
+        errno = err;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    } // if
+    if (0 != err)
+    {
+        PyErr_Format(PyExc_ValueError, "%s: corrupt compressed input", name);
+        return -1;
+    } // if
+    return 0;
+} // batch_close
+
+
+// Raises the error of a failed batch import; nothing of the batch is
+// inserted
 static PyObject*
-annotate_from_file(PyObject* const self, PyObject* const args)
+batch_error(int const err, char const* const name)
+{
+    if (EINVAL == err)
+    {
+        return PyErr_Format(PyExc_ValueError, "%s: invalid input", name);
+    } // if
+    if (ENOMEM == err)
+    {
+        return PyErr_NoMemory();
+    } // if
+    if (0 < err)
+    {
+        errno = err;
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+    return PyErr_Format(PyExc_RuntimeError, "%s: import failed", name);
+} // batch_error
+
+
+// Opens a list of (path, sample_id) tuples
+static int
+batch_open(PyObject* const list, struct Batch* const batch)
+{
+    size_t const count = PyList_Size(list);
+
+    batch->count = 0;
+    batch->files = calloc(count + 1, sizeof(*batch->files));
+    batch->readers = calloc(count + 1, sizeof(*batch->readers));
+    batch->streams = calloc(count + 1, sizeof(*batch->streams));
+    batch->sample_id = calloc(count + 1, sizeof(*batch->sample_id));
+    if (NULL == batch->files || NULL == batch->readers || NULL == batch->streams || NULL == batch->sample_id)
+    {
+        (void) batch_close(batch, "");
+        PyErr_NoMemory();
+        return -1;
+    } // if
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        char const* path = NULL;
+        Py_ssize_t sample_id = 0;
+        if (!PyArg_ParseTuple(PyList_GetItem(list, i), "sn", &path, &sample_id))
+        {
+            (void) batch_close(batch, "");
+            return -1;
+        } // if
+
+        errno = 0;
+        batch->files[i] = fopen(path, "r");
+        if (NULL == batch->files[i])
+        {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+            (void) batch_close(batch, "");
+            return -1;
+        } // if
+
+        batch->readers[i] = vrd_reader_open(batch->files[i], 1);
+        if (NULL == batch->readers[i])
+        {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+            fclose(batch->files[i]);
+            (void) batch_close(batch, "");
+            return -1;
+        } // if
+
+        batch->streams[i] = vrd_reader_stream(batch->readers[i]);
+        batch->sample_id[i] = sample_id;
+        batch->count += 1;
+    } // for
+
+    return 0;
+} // batch_open
+
+
+static PyObject*
+coverage_from_files(PyObject* const self, PyObject* const args)
 {
     (void) self;
 
+    PyObject* list = NULL;
+    CoverageTableObject* cov = NULL;
+
+    if (!PyArg_ParseTuple(args, "O!O!:coverage_from_files", &PyList_Type, &list, &CoverageTable, &cov))
+    {
+        return NULL;
+    } // if
+
+    struct Batch batch;
+    if (0 != batch_open(list, &batch))
+    {
+        return NULL;
+    } // if
+
+    size_t count = 0;
+    int err = 0;
+    Py_BEGIN_ALLOW_THREADS
+    count = vrd_coverage_from_files(batch.count, batch.streams, batch.sample_id, cov->table, CFG_IMPORT_THREADS);
+    err = errno;
+    Py_END_ALLOW_THREADS
+
+    if (0 != batch_close(&batch, "coverage_from_files"))
+    {
+        return NULL;
+    } // if
+
+    if ((size_t) -1 == count)
+    {
+        return batch_error(err, "coverage_from_files");
+    } // if
+
+    return Py_BuildValue("n", count);
+} // coverage_from_files
+
+
+static PyObject*
+variants_from_files(PyObject* const self, PyObject* const args)
+{
+    (void) self;
+
+    PyObject* list = NULL;
+    SNVTableObject* snv = NULL;
+    MNVTableObject* mnv = NULL;
+    SequenceTableObject* seq = NULL;
+
+    if (!PyArg_ParseTuple(args, "O!O!O!O!:variants_from_files", &PyList_Type, &list, &SNVTable, &snv, &MNVTable, &mnv, &SequenceTable, &seq))
+    {
+        return NULL;
+    } // if
+
+    struct Batch batch;
+    if (0 != batch_open(list, &batch))
+    {
+        return NULL;
+    } // if
+
+    size_t count = 0;
+    int err = 0;
+    Py_BEGIN_ALLOW_THREADS
+    count = vrd_variants_from_files(batch.count, batch.streams, batch.sample_id, snv->table, mnv->table, seq->table, CFG_IMPORT_THREADS);
+    err = errno;
+    Py_END_ALLOW_THREADS
+
+    if (0 != batch_close(&batch, "variants_from_files"))
+    {
+        return NULL;
+    } // if
+
+    if ((size_t) -1 == count)
+    {
+        return batch_error(err, "variants_from_files");
+    } // if
+
+    return Py_BuildValue("n", count);
+} // variants_from_files
+
+
+static PyObject*
+coverage_from_gvcf(PyObject* const self, PyObject* const args)
+{
+    (void) self;
+
+    char const* path = NULL;
+    int sample_id = 0;
+    CoverageTableObject* cov = NULL;
+
+    if (!PyArg_ParseTuple(args, "siO!:coverage_from_gvcf", &path, &sample_id, &CoverageTable, &cov))
+    {
+        return NULL;
+    } // if
+
+    errno = 0;
+    FILE* stream = fopen(path, "r");
+    if (NULL == stream)
+    {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    errno = 0;
+    vrd_Reader* reader = vrd_reader_open(stream, CFG_READER_THREADS);
+    if (NULL == reader)
+    {
+        fclose(stream);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    size_t count = 0;
+    int err = 0;
+    Py_BEGIN_ALLOW_THREADS
+    count = vrd_coverage_from_gvcf(vrd_reader_stream(reader), cov->table, sample_id);
+    err = vrd_reader_close(&reader);
+    Py_END_ALLOW_THREADS
+
+    if (0 != err)
+    {
+        fclose(stream);
+        if (0 < err)
+        {
+            errno = err;
+            return PyErr_SetFromErrno(PyExc_OSError);
+        } // if
+        PyErr_SetString(PyExc_ValueError, "coverage_from_gvcf: corrupt compressed input");
+        return NULL;
+    } // if
+
+    errno = 0;
+    if (0 != fclose(stream))
+    {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    return Py_BuildValue("i", count);
+} // coverage_from_gvcf
+
+
+static PyObject*
+variants_from_vcf(PyObject* const self, PyObject* const args)
+{
+    (void) self;
+
+    char const* path = NULL;
+    int sample_id = 0;
+    SNVTableObject* snv = NULL;
+    MNVTableObject* mnv = NULL;
+    SequenceTableObject* seq = NULL;
+
+    if (!PyArg_ParseTuple(args, "siO!O!O!:variants_from_vcf", &path, &sample_id, &SNVTable, &snv, &MNVTable, &mnv, &SequenceTable, &seq))
+    {
+        return NULL;
+    } // if
+
+    errno = 0;
+    FILE* stream = fopen(path, "r");
+    if (NULL == stream)
+    {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    errno = 0;
+    vrd_Reader* reader = vrd_reader_open(stream, CFG_READER_THREADS);
+    if (NULL == reader)
+    {
+        fclose(stream);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    size_t count = 0;
+    int err = 0;
+    Py_BEGIN_ALLOW_THREADS
+    count = vrd_variants_from_vcf(vrd_reader_stream(reader), snv->table, mnv->table, seq->table, sample_id);
+    err = vrd_reader_close(&reader);
+    Py_END_ALLOW_THREADS
+
+    if (0 != err)
+    {
+        fclose(stream);
+        if (0 < err)
+        {
+            errno = err;
+            return PyErr_SetFromErrno(PyExc_OSError);
+        } // if
+        PyErr_SetString(PyExc_ValueError, "variants_from_vcf: corrupt compressed input");
+        return NULL;
+    } // if
+
+    errno = 0;
+    if (0 != fclose(stream))
+    {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    return Py_BuildValue("i", count);
+} // variants_from_vcf
+
+
+static PyObject*
+annotate_from_file(PyObject* const self, PyObject* const args, PyObject* const kwds)
+{
+    (void) self;
+
+    static char* keywords[] = {"out_path", "in_path", "cov_table", "snv_table", "mnv_table", "seq_table", "subset", "zygosity", NULL};
+
     char const* in_path = NULL;
     char const* out_path = NULL;
     CoverageTableObject* cov = NULL;
@@ -101,8 +477,9 @@ annotate_from_file(PyObject* const self, PyObject* const args)
     MNVTableObject* mnv = NULL;
     SequenceTableObject* seq = NULL;
     PyObject* list = NULL;
+    int zygosity = 0;
 
-    if (!PyArg_ParseTuple(args, "ssO!O!O!O!|O!:annotate_from_file", &out_path, &in_path, &CoverageTable, &cov, &SNVTable, &snv, &MNVTable, &mnv, &SequenceTable, &seq, &PyList_Type, &list))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ssO!O!O!O!|Op:annotate_from_file", keywords, &out_path, &in_path, &CoverageTable, &cov, &SNVTable, &snv, &MNVTable, &mnv, &SequenceTable, &seq, &list, &zygosity))
     {
         return NULL;
     } // if
@@ -122,10 +499,11 @@ annotate_from_file(PyObject* const self, PyObject* const args)
         return PyErr_SetFromErrno(PyExc_OSError);
     } // if
 
-    vrd_AVL_Tree* subset = NULL;
-    if (NULL != list)
+    vrd_AVL_Tree* owned = NULL;
+    vrd_AVL_Tree const* subset = NULL;
+    if (NULL != list && Py_None != list)
     {
-        subset = sample_set(list);
+        subset = sample_set(list, &owned);
         if (NULL == subset)
         {
             fclose(istream);
@@ -136,7 +514,7 @@ annotate_from_file(PyObject* const self, PyObject* const args)
 
     size_t count = 0;
     Py_BEGIN_ALLOW_THREADS
-    count = vrd_annotate_from_file(ostream, istream, cov->table, snv->table, mnv->table, seq->table, subset);
+    count = vrd_annotate_from_file(ostream, istream, cov->table, snv->table, mnv->table, seq->table, subset, zygosity != 0);
     Py_END_ALLOW_THREADS
 
     errno = 0;
@@ -156,6 +534,70 @@ annotate_from_file(PyObject* const self, PyObject* const args)
 } // annotate_from_file
 
 
+static PyObject*
+annotate_cohorts_from_file(PyObject* const self, PyObject* const args)
+{
+    (void) self;
+
+    char const* in_path = NULL;
+    char const* out_path = NULL;
+    CoverageTableObject* cov = NULL;
+    SNVTableObject* snv = NULL;
+    MNVTableObject* mnv = NULL;
+    SequenceTableObject* seq = NULL;
+    PyObject* list = NULL;
+
+    if (!PyArg_ParseTuple(args, "ssO!O!O!O!O!:annotate_cohorts_from_file", &out_path, &in_path, &CoverageTable, &cov, &SNVTable, &snv, &MNVTable, &mnv, &SequenceTable, &seq, &PyList_Type, &list))
+    {
+        return NULL;
+    } // if
+
+    vrd_Cohort_Table* cohorts = cohort_table(list);
+    if (NULL == cohorts)
+    {
+        return NULL;
+    } // if
+
+    errno = 0;
+    FILE* istream = fopen(in_path, "r");
+    if (NULL == istream)
+    {
+        vrd_Cohort_table_destroy(&cohorts);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    errno = 0;
+    FILE* ostream = fopen(out_path, "w");
+    if (NULL == ostream)
+    {
+        fclose(istream);
+        vrd_Cohort_table_destroy(&cohorts);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    size_t count = 0;
+    Py_BEGIN_ALLOW_THREADS
+    count = vrd_annotate_cohorts_from_file(ostream, istream, cov->table, snv->table, mnv->table, seq->table, cohorts);
+    vrd_Cohort_table_destroy(&cohorts);
+    Py_END_ALLOW_THREADS
+
+    errno = 0;
+    if (0 != fclose(istream))
+    {
+        fclose(ostream);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    errno = 0;
+    if (0 != fclose(ostream))
+    {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    } // if
+
+    return Py_BuildValue("i", count);
+} // annotate_cohorts_from_file
+
+
 static PyObject*
 sample_count(PyObject* const self, PyObject* const args)
 {
@@ -256,8 +698,54 @@ static PyMethodDef methods[] =
      ":return: The number of inserted variants\n"
      ":rtype: integer\n"},
 
-    {"annotate_from_file", (PyCFunction) annotate_from_file, METH_VARARGS,
-     "annotate_from_file(out_path, in_path, cov_table, snv_table, mnv_table, seq_table[, subset])\n"
+    {"coverage_from_files", (PyCFunction) coverage_from_files, METH_VARARGS,
+     "coverage_from_files(samples, cov_table)\n"
+     "Import covered regions for a batch of samples concurrently\n\n"
+     ":param list samples: The (path, sample ID) tuples\n"
+     ":param cov_table: The coverage table\n"
+     ":type cov_table: :py:class:`CoverageTable`\n"
+     ":return: The number of inserted covered regions\n"
+     ":rtype: integer\n"},
+
+    {"variants_from_files", (PyCFunction) variants_from_files, METH_VARARGS,
+     "variants_from_files(samples, snv_table, mnv_table, seq_table)\n"
+     "Import variants for a batch of samples concurrently\n\n"
+     ":param list samples: The (path, sample ID) tuples\n"
+     ":param snv_table: The SNV table\n"
+     ":type snv_table: :py:class:`SNVTable`\n"
+     ":param mnv_table: The MNV table\n"
+     ":type mnv_table: :py:class:`MNVTable`\n"
+     ":param seq_table: The Sequence table\n"
+     ":type seq_table: :py:class:`SequenceTable`\n"
+     ":return: The number of inserted variants\n"
+     ":rtype: integer\n"},
+
+    {"coverage_from_gvcf", (PyCFunction) coverage_from_gvcf, METH_VARARGS,
+     "coverage_from_gvcf(path, sample_id, cov_table)\n"
+     "Import covered regions for a given sample from a (compressed) gVCF file\n\n"
+     ":param string path: The file path\n"
+     ":param int sample_id: The sample ID\n"
+     ":param cov_table: The coverage table\n"
+     ":type cov_table: :py:class:`CoverageTable`\n"
+     ":return: The number of inserted covered regions\n"
+     ":rtype: integer\n"},
+
+    {"variants_from_vcf", (PyCFunction) variants_from_vcf, METH_VARARGS,
+     "variants_from_vcf(path, sample_id, snv_table, mnv_table, seq_table)\n"
+     "Import variants for a given sample from a (compressed) VCF file\n\n"
+     ":param string path: The file path\n"
+     ":param int sample_id: The sample ID\n"
+     ":param snv_table: The SNV table\n"
+     ":type snv_table: :py:class:`SNVTable`\n"
+     ":param mnv_table: The MNV table\n"
+     ":type mnv_table: :py:class:`MNVTable`\n"
+     ":param seq_table: The Sequence table\n"
+     ":type seq_table: :py:class:`SequenceTable`\n"
+     ":return: The number of inserted variants\n"
+     ":rtype: integer\n"},
+
+    {"annotate_from_file", (PyCFunction)(void(*)(void)) annotate_from_file, METH_VARARGS | METH_KEYWORDS,
+     "annotate_from_file(out_path, in_path, cov_table, snv_table, mnv_table, seq_table[, subset[, zygosity]])\n"
      "Annotate variants in the input file against (a subset) of the database\n\n"
      ":param string out_path: The file path for the annotation (output)\n"
      ":param string in_path: The file path for the variants (input)\n"
@@ -269,8 +757,28 @@ static PyMethodDef methods[] =
      ":type mnv_table: :py:class:`MNVTable`\n"
      ":param seq_table: The Sequence table\n"
      ":type seq_table: :py:class:`SequenceTable`\n"
-     ":param subset: A list of sample IDs (`integer`), defaults to `None`\n"
-     ":type subset: list, optional\n"
+     ":param subset: A list of sample IDs (`integer`) or a :py:class:`SampleSet`, defaults to `None`\n"
+     ":type subset: list or :py:class:`SampleSet`, optional\n"
+     ":param zygosity: Also emit the homozygous allele count and the number of carriers, defaults to `False`\n"
+     ":type zygosity: bool, optional\n"
+     ":return: The number of annotated variants\n"
+     ":rtype: integer\n"},
+
+    {"annotate_cohorts_from_file", (PyCFunction) annotate_cohorts_from_file, METH_VARARGS,
+     "annotate_cohorts_from_file(out_path, in_path, cov_table, snv_table, mnv_table, seq_table, cohorts)\n"
+     "Annotate variants in the input file against several cohorts of the database in one pass\n\n"
+     ":param string out_path: The file path for the annotation (output)\n"
+     ":param string in_path: The file path for the variants (input)\n"
+     ":param cov_table: The coverage table\n"
+     ":type cov_table: :py:class:`CoverageTable`\n"
+     ":param snv_table: The SNV table\n"
+     ":type snv_table: :py:class:`SNVTable`\n"
+     ":param mnv_table: The MNV table\n"
+     ":type mnv_table: :py:class:`MNVTable`\n"
+     ":param seq_table: The Sequence table\n"
+     ":type seq_table: :py:class:`SequenceTable`\n"
+     ":param cohorts: A list of cohorts, each a list of sample IDs (`integer`)\n"
+     ":type cohorts: list of lists\n"
      ":return: The number of annotated variants\n"
      ":rtype: integer\n"},
 
@@ -313,6 +821,21 @@ PyInit_ext(void)
         return NULL;
     } // if
 
+    if (0 > PyType_Ready(&SampleAttributes))
+    {
+        return NULL;
+    } // if
+
+    if (0 > PyType_Ready(&SampleRegistry))
+    {
+        return NULL;
+    } // if
+
+    if (0 > PyType_Ready(&SampleSet))
+    {
+        return NULL;
+    } // if
+
     if (0 > PyType_Ready(&SequenceTable))
     {
         return NULL;
@@ -359,6 +882,10 @@ PyInit_ext(void)
     {
         return NULL;
     } // if
+    if (0 > PyModule_AddIntConstant(mod, "MAX_COHORTS", VRD_MAX_COHORTS))
+    {
+        return NULL;
+    } // if
 
     Py_INCREF(&CoverageTable);
     if (0 > PyModule_AddObject(mod, "CoverageTable", (PyObject*) &CoverageTable))
@@ -372,6 +899,24 @@ PyInit_ext(void)
         return NULL;
     } // if
 
+    Py_INCREF(&SampleAttributes);
+    if (0 > PyModule_AddObject(mod, "SampleAttributes", (PyObject*) &SampleAttributes))
+    {
+        return NULL;
+    } // if
+
+    Py_INCREF(&SampleRegistry);
+    if (0 > PyModule_AddObject(mod, "SampleRegistry", (PyObject*) &SampleRegistry))
+    {
+        return NULL;
+    } // if
+
+    Py_INCREF(&SampleSet);
+    if (0 > PyModule_AddObject(mod, "SampleSet", (PyObject*) &SampleSet))
+    {
+        return NULL;
+    } // if
+
     Py_INCREF(&SequenceTable);
     if (0 > PyModule_AddObject(mod, "SequenceTable", (PyObject*) &SequenceTable))
     {
@@ -14,24 +14,41 @@ cvarda = Extension('ext',
                             'python_ext/wrapper.c',
                             'python_ext/CoverageTable.c',
                             'python_ext/MNVTable.c',
+                            'python_ext/SampleAttributes.c',
+                            'python_ext/SampleRegistry.c',
+                            'python_ext/SampleSet.c',
                             'python_ext/SequenceTable.c',
                             'python_ext/SNVTable.c',
                             'src/avl_tree.c',
+                            'src/batch.c',
+                            'src/bitmap.c',
+                            'src/carriers.c',
+                            'src/cohort_table.c',
                             'src/cov_table.c',
                             'src/cov_tree.c',
                             'src/mnv_table.c',
                             'src/mnv_tree.c',
+                            'src/paged.c',
+                            'src/reader.c',
+                            'src/sample_attributes.c',
+                            'src/sample_registry.c',
                             'src/seq_table.c',
+                            'src/snapshot.c',
                             'src/snv_table.c',
                             'src/snv_tree.c',
                             'src/trie.c',
-                            'src/utils.c'],
+                            'src/utils.c',
+                            'src/vcf.c',
+                            'src/wal.c'],
                    define_macros=[('VRD_VERSION_MAJOR', VERSION_MAJOR),
                                   ('VRD_VERSION_MINOR', VERSION_MINOR),
                                   ('VRD_VERSION_PATCH', VERSION_PATCH)],
+                   libraries=['z'],
                    extra_compile_args=['-Wextra',
                                        '-Wpedantic',
-                                       '-std=c99'])
+                                       '-std=c99',
+                                       '-pthread'],
+                   extra_link_args=['-pthread'])
 
 
 setup(name='cvarda',
@@ -1,3 +1,6 @@
+#define _POSIX_C_SOURCE 200809L
+
+
 #include <assert.h>     // assert
 #include <stdbool.h>    // bool, false, true
 #include <stddef.h>     // NULL, size_t
@@ -20,6 +23,27 @@ struct VRD_TEMPLATE(VRD_TYPENAME, _Node)
 }; // vrd_AVL_Node
 
 
+// The fields of a node stored in a tree file besides the key
+enum
+{
+    FIELDS = 1
+}; // fields
+
+
+static inline void
+fields_get(struct VRD_TEMPLATE(VRD_TYPENAME, _Node) const* const node, uint32_t fields[FIELDS])
+{
+    fields[0] = node->sample_id;
+} // fields_get
+
+
+static inline void
+fields_set(struct VRD_TEMPLATE(VRD_TYPENAME, _Node)* const node, uint32_t const fields[FIELDS])
+{
+    node->sample_id = fields[0];
+} // fields_set
+
+
 #include "template_tree.inc"    // vrd_AVL_tree_*, insert
 
 
@@ -69,4 +93,20 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_is_element)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) c
 } // vrd_AVL_tree_is_element
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_keys)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                       size_t const len,
+                                       size_t keys[len])
+{
+    assert(NULL != self);
+
+    for (size_t i = 1; i < self->next && i - 1 < len; ++i)
+    {
+        keys[i - 1] = self->nodes[i].key;
+    } // for
+
+    return self->next - 1;
+} // vrd_AVL_tree_keys
+
+
 #undef VRD_TYPENAME
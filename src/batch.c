@@ -0,0 +1,809 @@
+#include <assert.h>     // assert
+#include <errno.h>      // EINVAL, ENOMEM, errno
+#include <pthread.h>    // pthread_*
+#include <stdbool.h>    // bool, false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // uint32_t
+#include <stdio.h>      // FILE, fscanf
+#include <stdlib.h>     // free, malloc, qsort, realloc
+#include <string.h>     // memcpy, strcmp, strlen
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/batch.h"       // vrd_variants_from_files,
+                                    // vrd_coverage_from_files
+#include "../include/constants.h"   // VRD_HOMOZYGOUS
+#include "../include/cov_table.h"   // vrd_Cov_Table, vrd_Cov_table_*
+#include "../include/iupac.h"       // vrd_iupac_to_idx
+#include "../include/mnv_table.h"   // vrd_MNV_Table, vrd_MNV_table_*
+#include "../include/seq_table.h"   // vrd_Seq_Table, vrd_Seq_table_*
+#include "../include/snv_table.h"   // vrd_SNV_Table, vrd_SNV_table_*
+#include "../include/trie.h"        // vrd_Trie, vrd_Trie_Node, vrd_trie_*
+#include "cov_tree.h"   // vrd_Cov_Tree, vrd_Cov_tree_*
+#include "mnv_tree.h"   // vrd_MNV_Tree, vrd_MNV_tree_*
+#include "snv_tree.h"   // vrd_SNV_Tree, vrd_SNV_tree_*
+#include "wal_log.h"    // vrd_WAL, vrd_wal_done, vrd_wal_enter, vrd_wal_leave, vrd_*_wal_*
+
+
+enum
+{
+    KIND_SNV,
+    KIND_MNV,
+    KIND_COV
+}; // kinds
+
+
+struct Entry
+{
+    uint32_t kind;
+    uint32_t reference;     // index in the references of the stage
+    size_t start;
+    size_t end;
+    size_t count;
+    size_t phase;
+    size_t inserted;    // SNV: IUPAC index, MNV: offset in sequences
+}; // Entry
+
+
+// The private staging area of a single sample
+struct Stage
+{
+    FILE* stream;
+    size_t sample_id;
+
+    vrd_Trie* trie;     // reference to index
+    size_t ref_count;
+    size_t ref_capacity;
+    char** references;
+
+    size_t count;
+    size_t capacity;
+    struct Entry* entries;
+
+    size_t seq_size;
+    size_t seq_capacity;
+    char* sequences;
+
+    int error;
+}; // Stage
+
+
+// A sorted run of entries for a single reference from a stage
+struct Run
+{
+    struct Entry const* begin;
+    struct Entry const* end;
+    struct Stage const* stage;
+}; // Run
+
+
+// All runs to be merged into the tree of a single reference
+struct Job
+{
+    uint32_t kind;
+    char const* reference;
+    void* tree;     // the private copy being merged into
+    vrd_WAL* wal;
+
+    size_t count;
+    size_t capacity;
+    struct Run* runs;
+
+    size_t inserted;
+    int error;
+}; // Job
+
+
+struct Context
+{
+    pthread_mutex_t lock;
+    size_t next;
+    size_t count;
+    void (*work)(struct Context* const, size_t const);
+
+    bool coverage;
+    struct Stage* stages;
+    struct Job* jobs;
+
+    vrd_SNV_Table* snv;
+    vrd_MNV_Table* mnv;
+    vrd_Cov_Table* cov;
+
+    vrd_Seq_Table* seq;
+    pthread_mutex_t seq_lock;
+}; // Context
+
+
+static void*
+worker(void* const arg)
+{
+    struct Context* const ctx = arg;
+    for (;;)
+    {
+        (void) pthread_mutex_lock(&ctx->lock);
+        size_t const idx = ctx->next;
+        ctx->next += 1;
+        (void) pthread_mutex_unlock(&ctx->lock);
+
+        if (idx >= ctx->count)
+        {
+            return NULL;
+        } // if
+        ctx->work(ctx, idx);
+    } // for
+} // worker
+
+
+// Runs `work` for all indices on (at most) `threads` threads, including
+// the calling thread
+static void
+parallel(struct Context* const ctx,
+         size_t const count,
+         void (*work)(struct Context* const, size_t const),
+         size_t const threads)
+{
+    ctx->next = 0;
+    ctx->count = count;
+    ctx->work = work;
+
+    if (0 == count)
+    {
+        return;
+    } // if
+
+    size_t const extra = (threads < count ? threads : count) - 1;
+    pthread_t* const ids = 0 < extra ? malloc(sizeof(*ids) * extra) : NULL;
+
+    size_t started = 0;
+    if (NULL != ids)
+    {
+        for (; started < extra; ++started)
+        {
+            if (0 != pthread_create(&ids[started], NULL, worker, ctx))
+            {
+                break;
+            } // if
+        } // for
+    } // if
+
+    (void) worker(ctx);
+
+    for (size_t i = 0; i < started; ++i)
+    {
+        (void) pthread_join(ids[i], NULL);
+    } // for
+    free(ids);
+} // parallel
+
+
+static struct Entry*
+stage_append(struct Stage* const stage)
+{
+    if (stage->capacity <= stage->count)
+    {
+        size_t const capacity = 0 == stage->capacity ? 1024 : stage->capacity * 2;
+        struct Entry* const entries = realloc(stage->entries, sizeof(*entries) * capacity);
+        if (NULL == entries)
+        {
+            return NULL;
+        } // if
+        stage->entries = entries;
+        stage->capacity = capacity;
+    } // if
+
+    stage->count += 1;
+    return &stage->entries[stage->count - 1];
+} // stage_append
+
+
+// Returns the index of the reference in the stage, or -1 on error
+static size_t
+stage_reference(struct Stage* const stage, char const* const reference)
+{
+    size_t const len = strlen(reference) + 1;
+    vrd_Trie_Node* const elem = vrd_trie_find(stage->trie, len, reference);
+    if (NULL != elem && 0 < elem->count)
+    {
+        return (size_t) elem->data;
+    } // if
+
+    if (stage->ref_capacity <= stage->ref_count)
+    {
+        size_t const capacity = 0 == stage->ref_capacity ? 16 : stage->ref_capacity * 2;
+        char** const references = realloc(stage->references, sizeof(*references) * capacity);
+        if (NULL == references)
+        {
+            return -1;
+        } // if
+        stage->references = references;
+        stage->ref_capacity = capacity;
+    } // if
+
+    char* const copy = malloc(len);
+    if (NULL == copy)
+    {
+        return -1;
+    } // if
+    (void) memcpy(copy, reference, len);
+
+    if (NULL == vrd_trie_insert(stage->trie, len, reference, (void*) stage->ref_count))
+    {
+        free(copy);
+        return -1;
+    } // if
+
+    stage->references[stage->ref_count] = copy;
+    stage->ref_count += 1;
+    return stage->ref_count - 1;
+} // stage_reference
+
+
+// Returns the offset of the copied sequence, or -1 on error
+static size_t
+stage_sequence(struct Stage* const stage, size_t const len, char const sequence[len])
+{
+    if (stage->seq_capacity < stage->seq_size + len + 1)
+    {
+        size_t capacity = 0 == stage->seq_capacity ? 4096 : stage->seq_capacity;
+        while (capacity < stage->seq_size + len + 1)
+        {
+            capacity *= 2;
+        } // while
+        char* const sequences = realloc(stage->sequences, capacity);
+        if (NULL == sequences)
+        {
+            return -1;
+        } // if
+        stage->sequences = sequences;
+        stage->seq_capacity = capacity;
+    } // if
+
+    size_t const offset = stage->seq_size;
+    (void) memcpy(&stage->sequences[offset], sequence, len);
+    stage->sequences[offset + len] = '\0';
+    stage->seq_size += len + 1;
+    return offset;
+} // stage_sequence
+
+
+// Parses as vrd_variants_from_file()
+static int
+stage_variants(struct Stage* const stage)
+{
+    char reference[128] = {'\0'};
+    size_t start = 0;
+    size_t end = 0;
+    size_t allele_count = 0;
+    size_t phase = 0;
+    size_t len = 0;
+    char inserted[1024] = {'\0'};
+
+    while (7 == fscanf(stage->stream, "%127s %zu %zu %zu %zu %zu %1023s", reference, &start, &end, &allele_count, &phase, &len, inserted))  // UNSAFE
+    {
+        if (1023 < len)
+        {
+            return EINVAL;
+        } // if
+
+        size_t const idx = stage_reference(stage, reference);
+        struct Entry* const entry = (size_t) -1 == idx ? NULL : stage_append(stage);
+        if (NULL == entry)
+        {
+            return ENOMEM;
+        } // if
+
+        entry->reference = idx;
+        entry->start = start;
+        entry->end = end;
+        entry->count = allele_count;
+        entry->phase = (size_t) -1 == phase ? VRD_HOMOZYGOUS : phase;
+
+        if (1 == len && inserted[0] != '.' && 1 == end - start)
+        {
+            entry->kind = KIND_SNV;
+            entry->inserted = vrd_iupac_to_idx(inserted[0]);
+        } // if
+        else
+        {
+            entry->kind = KIND_MNV;
+            entry->inserted = stage_sequence(stage, len, inserted);
+            if ((size_t) -1 == entry->inserted)
+            {
+                return ENOMEM;
+            } // if
+        } // else
+    } // while
+
+    return 0;
+} // stage_variants
+
+
+// Parses as vrd_coverage_from_file()
+static int
+stage_coverage(struct Stage* const stage)
+{
+    char reference[128] = {'\0'};
+    size_t start = 0;
+    size_t end = 0;
+    size_t allele_count = 0;
+
+    while (4 == fscanf(stage->stream, "%127s %zu %zu %zu", reference, &start, &end, &allele_count))  // UNSAFE
+    {
+        size_t const idx = stage_reference(stage, reference);
+        struct Entry* const entry = (size_t) -1 == idx ? NULL : stage_append(stage);
+        if (NULL == entry)
+        {
+            return ENOMEM;
+        } // if
+
+        entry->kind = KIND_COV;
+        entry->reference = idx;
+        entry->start = start;
+        entry->end = end;
+        entry->count = allele_count;
+    } // while
+
+    return 0;
+} // stage_coverage
+
+
+static int
+compare(void const* const lhs, void const* const rhs)
+{
+    struct Entry const* const a = lhs;
+    struct Entry const* const b = rhs;
+
+    if (a->kind != b->kind)
+    {
+        return a->kind < b->kind ? -1 : 1;
+    } // if
+    if (a->reference != b->reference)
+    {
+        return a->reference < b->reference ? -1 : 1;
+    } // if
+    if (a->start != b->start)
+    {
+        return a->start < b->start ? -1 : 1;
+    } // if
+    if (a->end != b->end)
+    {
+        return a->end < b->end ? -1 : 1;
+    } // if
+    return 0;
+} // compare
+
+
+static void
+stage_work(struct Context* const ctx, size_t const idx)
+{
+    struct Stage* const stage = &ctx->stages[idx];
+
+    stage->trie = vrd_trie_init();
+    if (NULL == stage->trie)
+    {
+        stage->error = ENOMEM;
+        return;
+    } // if
+
+    stage->error = ctx->coverage ? stage_coverage(stage) : stage_variants(stage);
+    if (0 == stage->error)
+    {
+        qsort(stage->entries, stage->count, sizeof(stage->entries[0]), compare);
+    } // if
+} // stage_work
+
+
+static void
+stage_destroy(struct Stage* const stage)
+{
+    vrd_trie_destroy(&stage->trie);
+    for (size_t i = 0; i < stage->ref_count; ++i)
+    {
+        free(stage->references[i]);
+    } // for
+    free(stage->references);
+    free(stage->entries);
+    free(stage->sequences);
+} // stage_destroy
+
+
+static inline bool
+run_less(struct Run const* const lhs, struct Run const* const rhs)
+{
+    if (lhs->begin->start != rhs->begin->start)
+    {
+        return lhs->begin->start < rhs->begin->start;
+    } // if
+    return lhs->begin->end < rhs->begin->end;
+} // run_less
+
+
+static void
+heap_down(struct Run* const heap, size_t const count, size_t idx)
+{
+    for (;;)
+    {
+        size_t min = idx;
+        size_t const left = 2 * idx + 1;
+        size_t const right = 2 * idx + 2;
+        if (left < count && run_less(&heap[left], &heap[min]))
+        {
+            min = left;
+        } // if
+        if (right < count && run_less(&heap[right], &heap[min]))
+        {
+            min = right;
+        } // if
+        if (min == idx)
+        {
+            return;
+        } // if
+
+        struct Run const tmp = heap[idx];
+        heap[idx] = heap[min];
+        heap[min] = tmp;
+        idx = min;
+    } // for
+} // heap_down
+
+
+static int
+merge_entry(struct Context* const ctx,
+            struct Job const* const job,
+            struct Run const* const run)
+{
+    struct Entry const* const entry = run->begin;
+    size_t const sample_id = run->stage->sample_id;
+    size_t const len = strlen(job->reference) + 1;
+
+    // logged first, so the draft holds exactly the logged entries
+    int ret = -1;
+    if (KIND_SNV == job->kind)
+    {
+        if (0 != vrd_SNV_wal_insert(job->wal, len, job->reference, entry->start, entry->count, sample_id, entry->phase, entry->inserted))
+        {
+            return -1;
+        } // if
+        ret = vrd_SNV_tree_insert(job->tree, entry->start, entry->count, sample_id, entry->phase, entry->inserted);
+        vrd_wal_done(job->wal, 0 == ret);
+        return ret;
+    } // if
+
+    if (KIND_COV == job->kind)
+    {
+        if (0 != vrd_Cov_wal_insert(job->wal, len, job->reference, entry->start, entry->end, entry->count, sample_id))
+        {
+            return -1;
+        } // if
+        ret = vrd_Cov_tree_insert(job->tree, entry->start, entry->end, entry->count, sample_id);
+        vrd_wal_done(job->wal, 0 == ret);
+        return ret;
+    } // if
+
+    char const* const sequence = &run->stage->sequences[entry->inserted];
+
+    size_t const len_seq = strlen(sequence) + 1;
+
+    // the sequence table is shared by all jobs; the tree belongs to this
+    // job and the log is given the sequence itself
+    (void) pthread_mutex_lock(&ctx->seq_lock);
+    vrd_Trie_Node* const elem = vrd_Seq_table_insert(ctx->seq, len_seq, sequence);
+    size_t const idx = NULL == elem ? (size_t) -1 : (size_t) elem->data;
+    (void) pthread_mutex_unlock(&ctx->seq_lock);
+
+    if ((size_t) -1 == idx ||
+        0 != vrd_MNV_wal_insert_sequence(job->wal, len, job->reference, entry->start, entry->end, entry->count, sample_id, entry->phase, len_seq, sequence))
+    {
+        return -1;
+    } // if
+    ret = vrd_MNV_tree_insert(job->tree, entry->start, entry->end, entry->count, sample_id, entry->phase, idx);
+    vrd_wal_done(job->wal, 0 == ret);
+    return ret;
+} // merge_entry
+
+
+static vrd_WAL*
+job_wal(struct Context const* const ctx, struct Job const* const job)
+{
+    if (KIND_SNV == job->kind)
+    {
+        return vrd_SNV_table_wal(ctx->snv);
+    } // if
+    if (KIND_MNV == job->kind)
+    {
+        return vrd_MNV_table_wal(ctx->mnv);
+    } // if
+    return vrd_Cov_table_wal(ctx->cov);
+} // job_wal
+
+
+static void*
+job_draft(struct Context const* const ctx, struct Job const* const job)
+{
+    size_t const len = strlen(job->reference) + 1;
+    if (KIND_SNV == job->kind)
+    {
+        return vrd_SNV_table_draft(ctx->snv, len, job->reference);
+    } // if
+    if (KIND_MNV == job->kind)
+    {
+        return vrd_MNV_table_draft(ctx->mnv, len, job->reference);
+    } // if
+    return vrd_Cov_table_draft(ctx->cov, len, job->reference);
+} // job_draft
+
+
+static void
+job_publish(struct Context const* const ctx, struct Job const* const job)
+{
+    size_t const len = strlen(job->reference) + 1;
+    if (KIND_SNV == job->kind)
+    {
+        vrd_SNV_table_publish(ctx->snv, len, job->reference, job->tree);
+        return;
+    } // if
+    if (KIND_MNV == job->kind)
+    {
+        vrd_MNV_table_publish(ctx->mnv, len, job->reference, job->tree);
+        return;
+    } // if
+    vrd_Cov_table_publish(ctx->cov, len, job->reference, job->tree);
+} // job_publish
+
+
+// k-way merge of the runs on position into a copy of the tree: queries
+// use the published tree meanwhile
+static void
+merge_work(struct Context* const ctx, size_t const idx)
+{
+    struct Job* const job = &ctx->jobs[idx];
+
+    // a checkpoint waits until the tree is published
+    job->wal = job_wal(ctx, job);
+    vrd_wal_enter(job->wal);
+
+    job->tree = job_draft(ctx, job);
+    if (NULL == job->tree)
+    {
+        vrd_wal_leave(job->wal);
+        job->error = -1;
+        return;
+    } // if
+
+    struct Run* const heap = job->runs;
+    size_t count = job->count;
+    for (size_t i = count / 2; i > 0; --i)
+    {
+        heap_down(heap, count, i - 1);
+    } // for
+
+    while (0 < count)
+    {
+        if (0 != merge_entry(ctx, job, &heap[0]))
+        {
+            job->error = -1;
+            break;
+        } // if
+        job->inserted += 1;
+
+        heap[0].begin += 1;
+        if (heap[0].begin == heap[0].end)
+        {
+            count -= 1;
+            heap[0] = heap[count];
+        } // if
+        heap_down(heap, count, 0);
+    } // while
+
+    job_publish(ctx, job);
+    vrd_wal_leave(job->wal);
+} // merge_work
+
+
+static size_t
+batch_import(size_t const count,
+             FILE* const streams[count],
+             size_t const sample_id[count],
+             vrd_SNV_Table* const snv,
+             vrd_MNV_Table* const mnv,
+             vrd_Seq_Table* const seq,
+             vrd_Cov_Table* const cov,
+             size_t const threads)
+{
+    struct Context ctx;
+    ctx.coverage = NULL != cov;
+    ctx.seq = seq;
+    ctx.jobs = NULL;
+    ctx.snv = snv;
+    ctx.mnv = mnv;
+    ctx.cov = cov;
+    size_t job_count = 0;
+    size_t job_capacity = 0;
+    size_t inserted = 0;
+    bool failed = false;
+    int error = 0;
+
+    ctx.stages = malloc(sizeof(*ctx.stages) * (0 == count ? 1 : count));
+    if (NULL == ctx.stages)
+    {
+        errno = ENOMEM;
+        return -1;
+    } // if
+    error = pthread_mutex_init(&ctx.lock, NULL);
+    if (0 != error)
+    {
+        free(ctx.stages);
+        errno = error;
+        return -1;
+    } // if
+    error = pthread_mutex_init(&ctx.seq_lock, NULL);
+    if (0 != error)
+    {
+        (void) pthread_mutex_destroy(&ctx.lock);
+        free(ctx.stages);
+        errno = error;
+        return -1;
+    } // if
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        ctx.stages[i] = (struct Stage) {.stream = streams[i], .sample_id = sample_id[i]};
+    } // for
+
+    parallel(&ctx, count, stage_work, 0 == threads ? 1 : threads);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (0 != ctx.stages[i].error)
+        {
+            error = ctx.stages[i].error;
+            goto exit;  // nothing is inserted yet
+        } // if
+    } // for
+
+    // one job per reference (and kind) over all stages
+    for (size_t i = 0; i < count; ++i)
+    {
+        struct Stage const* const stage = &ctx.stages[i];
+        for (size_t begin = 0; begin < stage->count;)
+        {
+            size_t end = begin + 1;
+            while (end < stage->count && stage->entries[end].kind == stage->entries[begin].kind &&
+                   stage->entries[end].reference == stage->entries[begin].reference)
+            {
+                end += 1;
+            } // while
+
+            uint32_t const kind = stage->entries[begin].kind;
+            char const* const reference = stage->references[stage->entries[begin].reference];
+
+            size_t job = 0;
+            while (job < job_count && (ctx.jobs[job].kind != kind || 0 != strcmp(ctx.jobs[job].reference, reference)))
+            {
+                job += 1;
+            } // while
+            if (job == job_count)
+            {
+                if (job_capacity <= job_count)
+                {
+                    size_t const capacity = 0 == job_capacity ? 16 : job_capacity * 2;
+                    struct Job* const jobs = realloc(ctx.jobs, sizeof(*jobs) * capacity);
+                    if (NULL == jobs)
+                    {
+                        failed = true;
+                        error = ENOMEM;
+                        goto exit;
+                    } // if
+                    ctx.jobs = jobs;
+                    job_capacity = capacity;
+                } // if
+                ctx.jobs[job] = (struct Job) {.kind = kind, .reference = reference};
+                job_count += 1;
+            } // if
+
+            struct Job* const target = &ctx.jobs[job];
+            if (target->capacity <= target->count)
+            {
+                size_t const capacity = 0 == target->capacity ? 4 : target->capacity * 2;
+                struct Run* const runs = realloc(target->runs, sizeof(*runs) * capacity);
+                if (NULL == runs)
+                {
+                    failed = true;
+                    error = ENOMEM;
+                    goto exit;
+                } // if
+                target->runs = runs;
+                target->capacity = capacity;
+            } // if
+            target->runs[target->count] = (struct Run) {&stage->entries[begin], &stage->entries[end], stage};
+            target->count += 1;
+
+            begin = end;
+        } // for
+    } // for
+
+    parallel(&ctx, job_count, merge_work, 0 == threads ? 1 : threads);
+
+    for (size_t i = 0; i < job_count; ++i)
+    {
+        inserted += ctx.jobs[i].inserted;  // OVERFLOW
+        if (0 != ctx.jobs[i].error)
+        {
+            failed = true;
+            error = ctx.jobs[i].error;
+        } // if
+    } // for
+
+exit:
+    if (failed)
+    {
+        vrd_AVL_Tree* subset = vrd_AVL_tree_init(count);
+        if (NULL != subset)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                (void) vrd_AVL_tree_insert(subset, sample_id[i]);
+            } // for
+
+            if (NULL != cov)
+            {
+                inserted -= vrd_Cov_table_remove(cov, subset);
+            } // if
+            else
+            {
+                inserted -= vrd_SNV_table_remove(snv, subset);
+                inserted -= vrd_MNV_table_remove_seq(mnv, subset, seq);
+            } // else
+            vrd_AVL_tree_destroy(&subset);
+        } // if
+    } // if
+
+    for (size_t i = 0; i < job_count; ++i)
+    {
+        free(ctx.jobs[i].runs);
+    } // for
+    free(ctx.jobs);
+    for (size_t i = 0; i < count; ++i)
+    {
+        stage_destroy(&ctx.stages[i]);
+    } // for
+    free(ctx.stages);
+    (void) pthread_mutex_destroy(&ctx.seq_lock);
+    (void) pthread_mutex_destroy(&ctx.lock);
+
+    if (0 != error)
+    {
+        errno = error;
+        return -1;
+    } // if
+    return inserted;
+} // batch_import
+
+
+size_t
+vrd_variants_from_files(size_t const count,
+                        FILE* const streams[count],
+                        size_t const sample_id[count],
+                        vrd_SNV_Table* const snv,
+                        vrd_MNV_Table* const mnv,
+                        vrd_Seq_Table* const seq,
+                        size_t const threads)
+{
+    assert(NULL != snv);
+    assert(NULL != mnv);
+    assert(NULL != seq);
+
+    return batch_import(count, streams, sample_id, snv, mnv, seq, NULL, threads);
+} // vrd_variants_from_files
+
+
+size_t
+vrd_coverage_from_files(size_t const count,
+                        FILE* const streams[count],
+                        size_t const sample_id[count],
+                        vrd_Cov_Table* const cov,
+                        size_t const threads)
+{
+    assert(NULL != cov);
+
+    return batch_import(count, streams, sample_id, NULL, NULL, NULL, cov, threads);
+} // vrd_coverage_from_files
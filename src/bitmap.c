@@ -0,0 +1,252 @@
+#include <assert.h>     // assert
+#include <stdbool.h>    // bool, false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // UINT64_C, uint64_t
+#include <stdlib.h>     // free, malloc
+
+#include "bitmap.h"     // vrd_Bitmap, vrd_bitmap_*
+
+
+struct vrd_Bitmap
+{
+    size_t capacity;
+    size_t height;
+    uint64_t* level[];  // level[0] holds the bits, level[height - 1] is
+                        // a single word
+}; // vrd_Bitmap
+
+
+static size_t const BITS = 64;
+
+
+static inline size_t
+words(size_t const bits)
+{
+    return 0 == bits ? 1 : (bits + BITS - 1) / BITS;
+} // words
+
+
+// Sets the bits [0, count) of a level
+static void
+fill(uint64_t* const level, size_t const count)
+{
+    for (size_t i = 0; i < count / BITS; ++i)
+    {
+        level[i] = ~UINT64_C(0);
+    } // for
+    if (0 != count % BITS)
+    {
+        level[count / BITS] = (UINT64_C(1) << (count % BITS)) - 1;
+    } // if
+} // fill
+
+
+vrd_Bitmap*
+vrd_bitmap_init(size_t const capacity, bool const full)
+{
+    size_t height = 1;
+    size_t total = words(capacity);
+    for (size_t n = words(capacity); 1 < n; n = words(n))
+    {
+        height += 1;
+        total += words(n);
+    } // for
+
+    vrd_Bitmap* const bitmap = malloc(sizeof(*bitmap) + sizeof(bitmap->level[0]) * height);
+    if (NULL == bitmap)
+    {
+        return NULL;
+    } // if
+
+    uint64_t* const data = malloc(sizeof(*data) * total);
+    if (NULL == data)
+    {
+        free(bitmap);
+        return NULL;
+    } // if
+
+    bitmap->capacity = capacity;
+    bitmap->height = height;
+
+    size_t offset = 0;
+    size_t bits = capacity;
+    for (size_t i = 0; i < height; ++i)
+    {
+        bitmap->level[i] = data + offset;
+        for (size_t j = 0; j < words(bits); ++j)
+        {
+            bitmap->level[i][j] = 0;
+        } // for
+        if (full)
+        {
+            fill(bitmap->level[i], bits);
+        } // if
+        offset += words(bits);
+        bits = words(bits);
+    } // for
+
+    return bitmap;
+} // vrd_bitmap_init
+
+
+void
+vrd_bitmap_destroy(vrd_Bitmap** const self)
+{
+    if (NULL == self || NULL == *self)
+    {
+        return;
+    } // if
+
+    free((*self)->level[0]);
+    free(*self);
+    *self = NULL;
+} // vrd_bitmap_destroy
+
+
+vrd_Bitmap*
+vrd_bitmap_resize(vrd_Bitmap* const self,
+                  size_t const capacity,
+                  bool const full)
+{
+    assert(NULL != self);
+    assert(self->capacity <= capacity);
+
+    vrd_Bitmap* const bitmap = vrd_bitmap_init(capacity, full);
+    if (NULL == bitmap)
+    {
+        return NULL;
+    } // if
+
+    // replace the old bits; if `full` only the last old word has to be
+    // merged with the new bits
+    size_t const old_words = words(self->capacity);
+    for (size_t i = 0; i < old_words; ++i)
+    {
+        if (full && i == old_words - 1)
+        {
+            size_t const bits = self->capacity - i * BITS;
+            uint64_t const mask = BITS == bits ? ~UINT64_C(0) : (UINT64_C(1) << bits) - 1;
+            bitmap->level[0][i] = (bitmap->level[0][i] & ~mask) | (self->level[0][i] & mask);
+        } // if
+        else
+        {
+            bitmap->level[0][i] = self->level[0][i];
+        } // else
+    } // for
+
+    // rebuild the summaries from the bits
+    size_t bits = capacity;
+    for (size_t k = 1; k < bitmap->height; ++k)
+    {
+        for (size_t i = 0; i < words(words(bits)); ++i)
+        {
+            bitmap->level[k][i] = 0;
+        } // for
+        for (size_t i = 0; i < words(bits); ++i)
+        {
+            if (0 != bitmap->level[k - 1][i])
+            {
+                bitmap->level[k][i / BITS] |= UINT64_C(1) << (i % BITS);
+            } // if
+        } // for
+        bits = words(bits);
+    } // for
+
+    vrd_Bitmap* tmp = self;
+    vrd_bitmap_destroy(&tmp);
+
+    return bitmap;
+} // vrd_bitmap_resize
+
+
+void
+vrd_bitmap_set(vrd_Bitmap* const self, size_t const idx)
+{
+    assert(NULL != self);
+    assert(idx < self->capacity);
+
+    size_t i = idx;
+    for (size_t k = 0; k < self->height; ++k)
+    {
+        uint64_t const word = self->level[k][i / BITS];
+        self->level[k][i / BITS] = word | (UINT64_C(1) << (i % BITS));
+        if (0 != word)
+        {
+            return;
+        } // if
+        i /= BITS;
+    } // for
+} // vrd_bitmap_set
+
+
+void
+vrd_bitmap_clear(vrd_Bitmap* const self, size_t const idx)
+{
+    assert(NULL != self);
+    assert(idx < self->capacity);
+
+    size_t i = idx;
+    for (size_t k = 0; k < self->height; ++k)
+    {
+        self->level[k][i / BITS] &= ~(UINT64_C(1) << (i % BITS));
+        if (0 != self->level[k][i / BITS])
+        {
+            return;
+        } // if
+        i /= BITS;
+    } // for
+} // vrd_bitmap_clear
+
+
+bool
+vrd_bitmap_test(vrd_Bitmap const* const self, size_t const idx)
+{
+    assert(NULL != self);
+
+    if (self->capacity <= idx)
+    {
+        return false;
+    } // if
+
+    return 0 != (self->level[0][idx / BITS] & (UINT64_C(1) << (idx % BITS)));
+} // vrd_bitmap_test
+
+
+size_t
+vrd_bitmap_first(vrd_Bitmap const* const self)
+{
+    assert(NULL != self);
+
+    if (0 == self->level[self->height - 1][0])
+    {
+        return -1;
+    } // if
+
+    size_t idx = 0;
+    for (size_t k = self->height; k > 0; --k)
+    {
+        idx = idx * BITS + __builtin_ctzll(self->level[k - 1][idx]);
+    } // for
+
+    return idx;
+} // vrd_bitmap_first
+
+
+size_t
+vrd_bitmap_last(vrd_Bitmap const* const self)
+{
+    assert(NULL != self);
+
+    if (0 == self->level[self->height - 1][0])
+    {
+        return -1;
+    } // if
+
+    size_t idx = 0;
+    for (size_t k = self->height; k > 0; --k)
+    {
+        idx = idx * BITS + (BITS - 1 - __builtin_clzll(self->level[k - 1][idx]));
+    } // for
+
+    return idx;
+} // vrd_bitmap_last
@@ -0,0 +1,73 @@
+#ifndef VRD_BITMAP_H
+#define VRD_BITMAP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stdbool.h>    // bool
+#include <stddef.h>     // size_t
+
+
+/**
+ * A hierarchical bitmap: every bit of a summary level tells whether the
+ * corresponding word of the level below has any bit set. Setting,
+ * clearing and finding the first or last set bit take O(log_64 n).
+ */
+typedef struct vrd_Bitmap vrd_Bitmap;
+
+
+vrd_Bitmap*
+vrd_bitmap_init(size_t const capacity, bool const full);
+
+
+void
+vrd_bitmap_destroy(vrd_Bitmap** const self);
+
+
+/**
+ * Resize to a larger capacity; the existing bits are kept and the new
+ * bits are set if `full`.
+ *
+ * @return The resized bitmap, or NULL on allocation failure, in which
+ *         case `self` is left untouched.
+ */
+vrd_Bitmap*
+vrd_bitmap_resize(vrd_Bitmap* const self,
+                  size_t const capacity,
+                  bool const full);
+
+
+void
+vrd_bitmap_set(vrd_Bitmap* const self, size_t const idx);
+
+
+void
+vrd_bitmap_clear(vrd_Bitmap* const self, size_t const idx);
+
+
+bool
+vrd_bitmap_test(vrd_Bitmap const* const self, size_t const idx);
+
+
+/**
+ * @return The index of the first set bit, or -1 if the bitmap is empty.
+ */
+size_t
+vrd_bitmap_first(vrd_Bitmap const* const self);
+
+
+/**
+ * @return The index of the last set bit, or -1 if the bitmap is empty.
+ */
+size_t
+vrd_bitmap_last(vrd_Bitmap const* const self);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
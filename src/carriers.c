@@ -0,0 +1,136 @@
+#include <assert.h>     // assert
+#include <stdbool.h>    // false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdlib.h>     // free, malloc, qsort, realloc
+#include <string.h>     // memcpy, memmove
+
+#include "carriers.h"   // vrd_Carriers, vrd_carriers_*
+
+
+void
+vrd_carriers_init(vrd_Carriers* const self)
+{
+    assert(NULL != self);
+
+    self->count = 0;
+    self->capacity = 0;
+    self->ids = NULL;
+    self->failed = false;
+} // vrd_carriers_init
+
+
+void
+vrd_carriers_destroy(vrd_Carriers* const self)
+{
+    assert(NULL != self);
+
+    free(self->ids);
+    vrd_carriers_init(self);
+} // vrd_carriers_destroy
+
+
+// Moves the inline ids to the heap
+static bool
+spill(vrd_Carriers* const self)
+{
+    size_t const capacity = 4 * VRD_CARRIERS_INLINE;
+    size_t* const ids = malloc(sizeof(*ids) * capacity);
+    if (NULL == ids)
+    {
+        return false;
+    } // if
+    (void) memcpy(ids, self->inline_ids, sizeof(*ids) * self->count);
+    self->ids = ids;
+    self->capacity = capacity;
+    return true;
+} // spill
+
+
+void
+vrd_carriers_add(vrd_Carriers* const self, size_t const sample_id)
+{
+    assert(NULL != self);
+
+    if (NULL == self->ids)
+    {
+        // sorted insert, a duplicate is dropped right away
+        size_t i = self->count;
+        while (0 < i && sample_id < self->inline_ids[i - 1])
+        {
+            i -= 1;
+        } // while
+        if (0 < i && sample_id == self->inline_ids[i - 1])
+        {
+            return;
+        } // if
+
+        if (VRD_CARRIERS_INLINE > self->count)
+        {
+            (void) memmove(&self->inline_ids[i + 1], &self->inline_ids[i], sizeof(self->inline_ids[0]) * (self->count - i));
+            self->inline_ids[i] = sample_id;
+            self->count += 1;
+            return;
+        } // if
+
+        if (!spill(self))
+        {
+            self->failed = true;
+            return;
+        } // if
+    } // if
+
+    if (self->capacity <= self->count)
+    {
+        size_t const capacity = self->capacity * 2;
+        size_t* const ids = realloc(self->ids, sizeof(*ids) * capacity);
+        if (NULL == ids)
+        {
+            self->failed = true;
+            return;
+        } // if
+        self->ids = ids;
+        self->capacity = capacity;
+    } // if
+
+    self->ids[self->count] = sample_id;
+    self->count += 1;
+} // vrd_carriers_add
+
+
+static int
+compare(void const* const lhs, void const* const rhs)
+{
+    size_t const a = *(size_t const*) lhs;
+    size_t const b = *(size_t const*) rhs;
+    return (a > b) - (a < b);
+} // compare
+
+
+size_t
+vrd_carriers_distinct(vrd_Carriers* const self)
+{
+    assert(NULL != self);
+
+    if (self->failed)
+    {
+        return -1;
+    } // if
+
+    // the inline ids are distinct already
+    if (NULL == self->ids)
+    {
+        return self->count;
+    } // if
+
+    qsort(self->ids, self->count, sizeof(self->ids[0]), compare);
+
+    size_t distinct = 1;
+    for (size_t i = 1; i < self->count; ++i)
+    {
+        if (self->ids[i] != self->ids[i - 1])
+        {
+            distinct += 1;
+        } // if
+    } // for
+    return distinct;
+} // vrd_carriers_distinct
@@ -0,0 +1,64 @@
+#ifndef VRD_CARRIERS_H
+#define VRD_CARRIERS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stdbool.h>    // bool
+#include <stddef.h>     // size_t
+
+
+enum
+{
+    VRD_CARRIERS_INLINE = 16
+}; // ids kept without allocation
+
+
+/**
+ * The sample ids of the entries matching a query, collected over any
+ * number of trees to count the distinct carriers. A sample can match
+ * more than once: with both alleles matching an ambiguity code, with
+ * duplicate entries, or with entries in more than one tree.
+ *
+ * The first distinct ids are kept sorted in `inline_ids`, without
+ * duplicates; only more carriers than fit there move the ids to the
+ * heap, where they are sorted once counted.
+ */
+typedef struct vrd_Carriers
+{
+    size_t count;
+    size_t capacity;
+    size_t* ids;    // NULL while the ids are inline
+    size_t inline_ids[VRD_CARRIERS_INLINE];
+    bool failed;    // an id could not be added
+} vrd_Carriers;
+
+
+void
+vrd_carriers_init(vrd_Carriers* const self);
+
+
+void
+vrd_carriers_destroy(vrd_Carriers* const self);
+
+
+void
+vrd_carriers_add(vrd_Carriers* const self, size_t const sample_id);
+
+
+/**
+ * @return The number of distinct sample ids, or `(size_t) -1` if an id
+ *         could not be added.
+ */
+size_t
+vrd_carriers_distinct(vrd_Carriers* const self);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
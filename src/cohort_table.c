@@ -0,0 +1,98 @@
+#include <assert.h>     // assert
+#include <errno.h>      // errno
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // UINT32_MAX, UINT64_C, uint64_t
+#include <stdlib.h>     // calloc, free, malloc
+
+#include "../include/cohort_table.h"    // vrd_Cohort_Table,
+                                        // vrd_Cohort_table_*
+
+
+struct vrd_Cohort_Table
+{
+    size_t cohort_count;
+    size_t capacity;
+
+    uint64_t masks[];
+}; // vrd_Cohort_Table
+
+
+vrd_Cohort_Table*
+vrd_Cohort_table_init(size_t const cohort_count, size_t const capacity)
+{
+    if (VRD_MAX_COHORTS < cohort_count || (size_t) UINT32_MAX <= capacity)
+    {
+        errno = -1;
+        return NULL;
+    } // if
+
+    vrd_Cohort_Table* const table = malloc(sizeof(*table) + sizeof(table->masks[0]) * capacity);
+    if (NULL == table)
+    {
+        return NULL;
+    } // if
+
+    table->cohort_count = cohort_count;
+    table->capacity = capacity;
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        table->masks[i] = 0;
+    } // for
+
+    return table;
+} // vrd_Cohort_table_init
+
+
+void
+vrd_Cohort_table_destroy(vrd_Cohort_Table** const self)
+{
+    if (NULL == self)
+    {
+        return;
+    } // if
+
+    free(*self);
+    *self = NULL;
+} // vrd_Cohort_table_destroy
+
+
+int
+vrd_Cohort_table_insert(vrd_Cohort_Table* const self,
+                        size_t const cohort,
+                        size_t const sample_id)
+{
+    assert(NULL != self);
+
+    if (self->cohort_count <= cohort || self->capacity <= sample_id)
+    {
+        return -1;
+    } // if
+
+    self->masks[sample_id] |= UINT64_C(1) << cohort;
+
+    return 0;
+} // vrd_Cohort_table_insert
+
+
+size_t
+vrd_Cohort_table_count(vrd_Cohort_Table const* const self)
+{
+    assert(NULL != self);
+
+    return self->cohort_count;
+} // vrd_Cohort_table_count
+
+
+uint64_t
+vrd_Cohort_table_mask(vrd_Cohort_Table const* const self,
+                      size_t const sample_id)
+{
+    assert(NULL != self);
+
+    if (self->capacity <= sample_id)
+    {
+        return 0;
+    } // if
+
+    return self->masks[sample_id];
+} // vrd_Cohort_table_mask
@@ -1,16 +1,21 @@
+#define _POSIX_C_SOURCE 200809L
+
+
 #include <assert.h>     // assert
 #include <errno.h>      // errno
 #include <stddef.h>     // NULL, size_t
+#include <stdlib.h>     // free, malloc
 
 #include "../include/cov_table.h"   // vrd_Cov_Table, vrd_Cov_table_*
 #include "../include/trie.h"        // vrd_Trie_Node, vrd_trie_*
 #include "cov_tree.h"   // vrd_Cov_Tree, vrd_Cov_tree_*
+#include "wal_log.h"    // vrd_wal_*, vrd_Cov_wal_*
 
 
 #define VRD_TYPENAME Cov
 
 
-#include "template_table.inc"   // tree_from_reference, vrd_Cov_table_*
+#include "template_table.inc"   // reference_*, read_*, update_*, vrd_Cov_table_*
 
 
 int
@@ -24,13 +29,34 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_insert)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* co
 {
     assert(NULL != self);
 
-    VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const tree = tree_from_reference(self, len, reference);
+    vrd_wal_enter(self->wal);
+
+    struct Reference* const ref = reference_from_name(self, len, reference);
+    if (NULL == ref)
+    {
+        int const err = errno;
+        vrd_wal_leave(self->wal);
+        return err;
+    } // if
+
+    VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const tree = update_begin(self, ref);
     if (NULL == tree)
     {
-        return errno;
+        vrd_wal_leave(self->wal);
+        return -1;
+    } // if
+
+    // logged first, so a failure to log leaves the tree as it is
+    int ret = VRD_TEMPLATE(VRD_TYPENAME, _wal_insert)(self->wal, len, reference, start, end, allele_count, sample_id);
+    if (0 == ret)
+    {
+        ret = VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(tree, start, end, allele_count, sample_id);
+        vrd_wal_done(self->wal, 0 == ret);
     } // if
+    update_end(ref, tree);
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(tree, start, end, allele_count, sample_id);
+    vrd_wal_leave(self->wal);
+    return ret;
 } // vrd_Cov_table_insert
 
 
@@ -44,16 +70,59 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_stab)(VRD_TEMPLATE(VRD_TYPENAME, _Table)
 {
     assert(NULL != self);
 
-    vrd_Trie_Node* const elem = vrd_trie_find(self->trie, len, reference);
-    if (NULL == elem)
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
     {
         return -1;
     } // if
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab)(elem->data, start, end, subset);
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    size_t ret = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab)(view.trees[i], start, end, subset);  // OVERFLOW
+    } // for
+    read_end(self, &view);
+    return ret;
 } // vrd_Cov_table_query_stab
 
 
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_stab_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                      size_t const len,
+                                                      char const reference[len],
+                                                      size_t const start,
+                                                      size_t const end,
+                                                      vrd_Cohort_Table const* const cohorts,
+                                                      size_t count[])
+{
+    assert(NULL != self);
+
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab_cohorts)(view.trees[i], start, end, cohorts, count);
+    } // for
+    read_end(self, &view);
+
+    return 0;
+} // vrd_Cov_table_query_stab_cohorts
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                 size_t const len_ref,
@@ -62,17 +131,43 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tabl
                                                 size_t const end,
                                                 vrd_AVL_Tree const* const subset,
                                                 size_t const len_res,
-                                                void* result[len_res])
+                                                vrd_Cov_Entry result[len_res])
 {
     assert(NULL != self);
 
-    vrd_Trie_Node* const elem = vrd_trie_find(self->trie, len_ref, reference);
-    if (NULL == elem)
+    struct Reference const* const ref = reference_find(self, len_ref, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    void** const nodes = malloc(sizeof(*nodes) * (0 == len_res ? 1 : len_res));
+    if (NULL == nodes)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
     {
+        free(nodes);
         return -1;
     } // if
+    size_t ret = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(view.trees[i], start, end, subset, len_res - ret, &nodes[ret]);
+    } // for
+
+    // the nodes are only valid while the view is held
+    for (size_t i = 0; i < ret; ++i)
+    {
+        VRD_TEMPLATE(VRD_TYPENAME, _unpack)(nodes[i], &result[i].start, &result[i].end, &result[i].allele_count, &result[i].sample_id);
+    } // for
+    read_end(self, &view);
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(elem->data, start, end, subset, len_res, result);
+    free(nodes);
+    return ret;
 } // vrd_Cov_table_query_region
 
 
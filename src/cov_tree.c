@@ -1,8 +1,13 @@
+#define _POSIX_C_SOURCE 200809L
+
+
 #include <assert.h>     // assert
 #include <stddef.h>     // NULL, size_t
 #include <stdint.h>     // int32_t, uint32_t
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/cohort_table.h"    // vrd_Cohort_Table, vrd_Cohort_table_mask,
+                                        // vrd_cohort_add
 #include "../include/template.h"    // VRD_TEMPLATE
 #include "cov_tree.h"   // vrd_Cov_Tree, vrd_Cov_tree_*
 #include "tree.h"       // NULLPTR, LEFT, RIGHT
@@ -26,6 +31,31 @@ struct VRD_TEMPLATE(VRD_TYPENAME, _Node)
 }; // vrd_Cov_Node
 
 
+// The fields of a node stored in a tree file besides the key
+enum
+{
+    FIELDS = 3
+}; // fields
+
+
+static inline void
+fields_get(struct VRD_TEMPLATE(VRD_TYPENAME, _Node) const* const node, uint32_t fields[FIELDS])
+{
+    fields[0] = node->end - node->key;
+    fields[1] = node->count;
+    fields[2] = node->sample_id;
+} // fields_get
+
+
+static inline void
+fields_set(struct VRD_TEMPLATE(VRD_TYPENAME, _Node)* const node, uint32_t const fields[FIELDS])
+{
+    node->end = node->key + fields[0];
+    node->count = fields[1];
+    node->sample_id = fields[2];
+} // fields_set
+
+
 #define VRD_INTERVAL
 #include "template_tree.inc"    // vrd_Cov_tree_*
 #undef VRD_INTERVAL
@@ -140,6 +170,35 @@ query_region(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
 } // query_region
 
 
+static void
+query_stab_cohorts(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                   size_t const root,
+                   size_t const start,
+                   size_t const end,
+                   vrd_Cohort_Table const* const cohorts,
+                   size_t count[])
+{
+    if (NULLPTR == root || self->nodes[root].max < start)
+    {
+        return;
+    } // if
+
+    if (self->nodes[root].key > start)
+    {
+        query_stab_cohorts(self, self->nodes[root].child[LEFT], start, end, cohorts, count);
+        return;
+    } // if
+
+    if (start >= self->nodes[root].key && end <= self->nodes[root].end)
+    {
+        vrd_cohort_add(vrd_Cohort_table_mask(cohorts, self->nodes[root].sample_id), self->nodes[root].count, count);
+    } // if
+
+    query_stab_cohorts(self, self->nodes[root].child[LEFT], start, end, cohorts, count);
+    query_stab_cohorts(self, self->nodes[root].child[RIGHT], start, end, cohorts, count);
+} // query_stab_cohorts
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                              size_t const start,
@@ -152,6 +211,21 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) c
 } // vrd_Cov_tree_query_stab
 
 
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                     size_t const start,
+                                                     size_t const end,
+                                                     vrd_Cohort_Table const* const cohorts,
+                                                     size_t count[])
+{
+    assert(NULL != self);
+    assert(NULL != cohorts);
+    assert(NULL != count);
+
+    query_stab_cohorts(self, self->root, start, end, cohorts, count);
+} // vrd_Cov_tree_query_stab_cohorts
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                                size_t const start,
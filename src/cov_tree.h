@@ -10,6 +10,7 @@ extern "C"
 #include <stddef.h>     // size_t
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/cohort_table.h"    // vrd_Cohort_Table
 #include "../include/template.h"    // VRD_TEMPLATE
 
 
@@ -34,6 +35,14 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) c
                                              vrd_AVL_Tree const* const subset);
 
 
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_stab_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                     size_t const start,
+                                                     size_t const end,
+                                                     vrd_Cohort_Table const* const cohorts,
+                                                     size_t count[]);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                                size_t const start,
@@ -1,4 +1,5 @@
 #include <errno.h>      // errno
+#include <stdbool.h>    // false
 #include <stddef.h>     // NULL
 #include <stdio.h>      // FILE, FILENAME_MAX, stderr, stdout, fclose,
                         // fopen, fprintf, perror, snprintf
@@ -152,7 +153,7 @@ main(int argc, char* argv[])
         goto error;
     } // if
 
-    if (4094652 != vrd_annotate_from_file(ostream, istream, cov, snv, mnv, seq, subset))
+    if (4094652 != vrd_annotate_from_file(ostream, istream, cov, snv, mnv, seq, subset, false))
     {
         (void) fprintf(stderr, "vrd_annotate_from_file() failed\n");
         goto error;
@@ -184,7 +185,7 @@ main(int argc, char* argv[])
         goto error;
     } // if
 
-    if (996363 != vrd_annotate_from_file(ostream, istream, cov, snv, mnv, seq, subset))
+    if (996363 != vrd_annotate_from_file(ostream, istream, cov, snv, mnv, seq, subset, false))
     {
         (void) fprintf(stderr, "vrd_annotate_from_file() failed\n");
         goto error;
@@ -1,18 +1,23 @@
+#define _POSIX_C_SOURCE 200809L
+
+
 #include <assert.h>     // assert
 #include <errno.h>      // errno
 #include <stddef.h>     // NULL, size_t
 #include <stdbool.h>    // bool
-#include <stdlib.h>     // free
+#include <stdlib.h>     // free, malloc
 
 #include "../include/mnv_table.h"   // vrd_MNV_Table, vrd_MNV_table_*
 #include "../include/trie.h"        // vrd_Trie_Node, vrd_trie_*
+#include "carriers.h"   // vrd_Carriers, vrd_carriers_*
 #include "mnv_tree.h"   // vrd_MNV_Tree, vrd_MNV_tree_*
+#include "wal_log.h"    // vrd_wal_*, vrd_MNV_wal_*
 
 
 #define VRD_TYPENAME MNV
 
 
-#include "template_table.inc"   // tree_from_reference, vrd_MNV_table_*
+#include "template_table.inc"   // reference_*, read_*, update_*, vrd_MNV_table_*
 
 
 int
@@ -28,13 +33,34 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_insert)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* co
 {
     assert(NULL != self);
 
-    VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const tree = tree_from_reference(self, len, reference);
+    vrd_wal_enter(self->wal);
+
+    struct Reference* const ref = reference_from_name(self, len, reference);
+    if (NULL == ref)
+    {
+        int const err = errno;
+        vrd_wal_leave(self->wal);
+        return err;
+    } // if
+
+    VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const tree = update_begin(self, ref);
     if (NULL == tree)
     {
-        return errno;
+        vrd_wal_leave(self->wal);
+        return -1;
     } // if
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(tree, start, end, allele_count, sample_id, phase, inserted);
+    // logged first, so a failure to log leaves the tree as it is
+    int ret = VRD_TEMPLATE(VRD_TYPENAME, _wal_insert)(self->wal, len, reference, start, end, allele_count, sample_id, phase, inserted);
+    if (0 == ret)
+    {
+        ret = VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(tree, start, end, allele_count, sample_id, phase, inserted);
+        vrd_wal_done(self->wal, 0 == ret);
+    } // if
+    update_end(ref, tree);
+
+    vrd_wal_leave(self->wal);
+    return ret;
 } // vrd_MNV_table_insert
 
 
@@ -50,16 +76,107 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query)(VRD_TEMPLATE(VRD_TYPENAME, _Table) cons
 {
     assert(NULL != self);
 
-    vrd_Trie_Node* const elem = vrd_trie_find(self->trie, len, reference);
-    if (NULL == elem)
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
     {
         return -1;
     } // if
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(elem->data, start, end, inserted, homozygous, subset);
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    size_t ret = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(view.trees[i], start, end, inserted, homozygous, subset);  // OVERFLOW
+    } // for
+    read_end(self, &view);
+    return ret;
 } // vrd_MNV_table_query
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                  size_t const len,
+                                                  char const reference[len],
+                                                  size_t const start,
+                                                  size_t const end,
+                                                  size_t const inserted,
+                                                  vrd_AVL_Tree const* const subset,
+                                                  size_t* const homozygous,
+                                                  size_t* const carriers)
+{
+    assert(NULL != self);
+
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    // a sample can match in more than one tree of the view
+    vrd_Carriers ids;
+    vrd_carriers_init(&ids);
+    size_t ret = 0;
+    *homozygous = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        size_t tree_homozygous = 0;
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query_zygosity)(view.trees[i], start, end, inserted, subset, &tree_homozygous, &ids);
+        *homozygous += tree_homozygous;
+    } // for
+    read_end(self, &view);
+
+    *carriers = vrd_carriers_distinct(&ids);
+    vrd_carriers_destroy(&ids);
+    if ((size_t) -1 == *carriers)
+    {
+        return -1;
+    } // if
+    return ret;
+} // vrd_MNV_table_query_zygosity
+
+
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                 size_t const len,
+                                                 char const reference[len],
+                                                 size_t const start,
+                                                 size_t const end,
+                                                 size_t const inserted,
+                                                 vrd_Cohort_Table const* const cohorts,
+                                                 size_t count[])
+{
+    assert(NULL != self);
+
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        VRD_TEMPLATE(VRD_TYPENAME, _tree_query_cohorts)(view.trees[i], start, end, inserted, cohorts, count);
+    } // for
+    read_end(self, &view);
+
+    return 0;
+} // vrd_MNV_table_query_cohorts
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                 size_t const len_ref,
@@ -68,37 +185,243 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tabl
                                                 size_t const end,
                                                 vrd_AVL_Tree const* const subset,
                                                 size_t const len_res,
-                                                void* result[len_res])
+                                                vrd_MNV_Entry result[len_res])
 {
     assert(NULL != self);
 
-    vrd_Trie_Node* const elem = vrd_trie_find(self->trie, len_ref, reference);
-    if (NULL == elem)
+    struct Reference const* const ref = reference_find(self, len_ref, reference);
+    if (NULL == ref)
     {
         return -1;
     } // if
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(elem->data, start, end, subset, len_res, result);
+    void** const nodes = malloc(sizeof(*nodes) * (0 == len_res ? 1 : len_res));
+    if (NULL == nodes)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        free(nodes);
+        return -1;
+    } // if
+    size_t ret = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(view.trees[i], start, end, subset, len_res - ret, &nodes[ret]);
+    } // for
+
+    // the nodes are only valid while the view is held
+    for (size_t i = 0; i < ret; ++i)
+    {
+        VRD_TEMPLATE(VRD_TYPENAME, _unpack)(nodes[i], &result[i].start, &result[i].end, &result[i].allele_count, &result[i].sample_id, &result[i].phase, &result[i].inserted);
+    } // for
+    read_end(self, &view);
+
+    free(nodes);
+    return ret;
 } // vrd_MNV_table_query_region
 
 
+static size_t
+reference_remove_seq(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                     struct Reference* const ref,
+                     size_t const len,
+                     char const reference[len],
+                     vrd_AVL_Tree const* const subset,
+                     vrd_Seq_Table* const seq_table)
+{
+    VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const tree = bulk_begin(self, ref);
+    if (NULL == tree)
+    {
+        return -1;
+    } // if
+
+    if (0 != VRD_TEMPLATE(VRD_TYPENAME, _wal_remove_seq)(self->wal, len, reference, subset))
+    {
+        bulk_discard(ref, tree);
+        return -1;
+    } // if
+
+    size_t const removed = VRD_TEMPLATE(VRD_TYPENAME, _tree_remove_seq)(tree, subset, seq_table);
+    vrd_wal_done(self->wal, 0 < removed);
+    if (0 == removed)
+    {
+        bulk_discard(ref, tree);
+        return 0;
+    } // if
+    bulk_end(self, ref, tree);
+    return removed;
+} // reference_remove_seq
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_remove_seq)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
                                               vrd_AVL_Tree const* const subset,
                                               vrd_Seq_Table* const seq_table)
 {
     assert(NULL != self);
+    assert(NULL != subset);
+
+    vrd_wal_enter(self->wal);
 
     size_t count = 0;
-    for (size_t i = 0; i < self->next; ++i)
+    bool failed = false;
+    size_t const next = table_size(self);
+    for (size_t i = 0; i < next; ++i)
     {
-        count += VRD_TEMPLATE(VRD_TYPENAME, _tree_remove_seq)(self->trees[i]->data, subset, seq_table);  // OVERFLOW
+        char* reference = NULL;
+        size_t const len = vrd_trie_key(self->trees[i], &reference);
+        size_t const removed = NULL == reference ? (size_t) -1 : reference_remove_seq(self, self->trees[i]->data, len, reference, subset, seq_table);
+        free(reference);
+        if ((size_t) -1 == removed)
+        {
+            failed = true;
+            continue;
+        } // if
+        count += removed;  // OVERFLOW
     } // for
 
-    return count;
+    vrd_wal_leave(self->wal);
+    return failed ? (size_t) -1 : count;
 } // vrd_MNV_table_remove_seq
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_remove_seq_reference)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                                        size_t const len,
+                                                        char const reference[len],
+                                                        vrd_AVL_Tree const* const subset,
+                                                        vrd_Seq_Table* const seq_table)
+{
+    assert(NULL != self);
+    assert(NULL != subset);
+
+    struct Reference* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
+    {
+        return 0;
+    } // if
+
+    vrd_wal_enter(self->wal);
+    size_t const removed = reference_remove_seq(self, ref, len, reference, subset, seq_table);
+    vrd_wal_leave(self->wal);
+    return removed;
+} // vrd_MNV_table_remove_seq_reference
+
+
+// All trees for a bulk update at once (with the table size `next`): on
+// failure the trees obtained are released, untouched
+static VRD_TEMPLATE(VRD_TYPENAME, _Tree)**
+bulk_begin_all(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+               size_t const next)
+{
+    VRD_TEMPLATE(VRD_TYPENAME, _Tree)** const trees = malloc(sizeof(*trees) * (0 == next ? 1 : next));
+    if (NULL == trees)
+    {
+        return NULL;
+    } // if
+
+    for (size_t i = 0; i < next; ++i)
+    {
+        trees[i] = bulk_begin(self, self->trees[i]->data);
+        if (NULL == trees[i])
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                bulk_discard(self->trees[j]->data, trees[j]);
+            } // for
+            free(trees);
+            return NULL;
+        } // if
+    } // for
+    return trees;
+} // bulk_begin_all
+
+
+static void
+renumber_all(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+             size_t const next,
+             VRD_TEMPLATE(VRD_TYPENAME, _Tree)** const trees,
+             size_t const count,
+             size_t const map[count])
+{
+    for (size_t i = 0; i < next; ++i)
+    {
+        VRD_TEMPLATE(VRD_TYPENAME, _tree_renumber)(trees[i], count, map);
+        bulk_end(self, self->trees[i]->data, trees[i]);
+    } // for
+    free(trees);
+} // renumber_all
+
+
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_renumber)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                            size_t const count,
+                                            size_t const map[count])
+{
+    assert(NULL != self);
+
+    size_t const next = table_size(self);
+    VRD_TEMPLATE(VRD_TYPENAME, _Tree)** const trees = bulk_begin_all(self, next);
+    if (NULL == trees)
+    {
+        return -1;
+    } // if
+
+    renumber_all(self, next, trees, count, map);
+    return 0;
+} // vrd_MNV_table_renumber
+
+
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_compact_seq)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                               vrd_Seq_Table* const seq_table)
+{
+    assert(NULL != self);
+    assert(NULL != seq_table);
+
+    vrd_wal_enter(self->wal);
+
+    // all trees are obtained before the sequence table is compacted, so
+    // a tree that cannot be updated leaves both untouched
+    size_t const next = table_size(self);
+    VRD_TEMPLATE(VRD_TYPENAME, _Tree)** const trees = bulk_begin_all(self, next);
+    if (NULL == trees)
+    {
+        vrd_wal_leave(self->wal);
+        return -1;
+    } // if
+
+    // logged while all trees are held, before anything is compacted
+    size_t* map = NULL;
+    size_t count = -1;
+    if (0 == VRD_TEMPLATE(VRD_TYPENAME, _wal_compact_seq)(self->wal))
+    {
+        count = vrd_Seq_table_compact(seq_table, &map);
+        vrd_wal_done(self->wal, (size_t) -1 != count);
+    } // if
+    if ((size_t) -1 == count)
+    {
+        for (size_t i = 0; i < next; ++i)
+        {
+            bulk_discard(self->trees[i]->data, trees[i]);
+        } // for
+        free(trees);
+        vrd_wal_leave(self->wal);
+        return -1;
+    } // if
+
+    renumber_all(self, next, trees, count, map);
+    free(map);
+
+    vrd_wal_leave(self->wal);
+    return 0;
+} // vrd_MNV_table_compact_seq
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_export)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                           FILE* stream,
@@ -108,15 +431,28 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_export)(VRD_TEMPLATE(VRD_TYPENAME, _Table) con
     assert(NULL != seq_table);
 
     size_t count = 0;
-    for (size_t i = 0; i < self->next; ++i)
+    size_t const next = table_lock_read(self);
+    for (size_t i = 0; i < next; ++i)
     {
         char* reference = NULL;
         size_t const len = vrd_trie_key(self->trees[i], &reference);
 
-        count += VRD_TEMPLATE(VRD_TYPENAME, _tree_export)(self->trees[i]->data, stream, len, reference, seq_table); // OVERFLOW
+        struct View view;
+        if (0 != read_begin(self, self->trees[i]->data, &view))
+        {
+            free(reference);
+            count = -1;
+            break;
+        } // if
+        for (size_t j = 0; j < view.count; ++j)
+        {
+            count += VRD_TEMPLATE(VRD_TYPENAME, _tree_export)(view.trees[j], stream, len, reference, seq_table);  // OVERFLOW
+        } // for
+        read_end(self, &view);
 
         free(reference);
     } // for
+    table_unlock(self);
 
     return count;
 } // vrd_MNV_table_export
@@ -1,3 +1,6 @@
+#define _POSIX_C_SOURCE 200809L
+
+
 #include <assert.h>     // assert
 #include <stddef.h>     // NULL, size_t
 #include <stdbool.h>    // bool
@@ -5,9 +8,12 @@
 #include <stdio.h>      // FILE, fprintf
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/cohort_table.h"    // vrd_Cohort_Table, vrd_Cohort_table_mask,
+                                        // vrd_cohort_add
 #include "../include/constants.h"   // VRD_HOMOZYGOUS
 #include "../include/seq_table.h"   // vrd_Seq_Table, vrd_Seq_table_*
 #include "../include/template.h"    // VRD_TEMPLATE
+#include "carriers.h"   // vrd_Carriers, vrd_carriers_add
 #include "mnv_tree.h"   // vrd_MNV_Tree, vrd_MNV_tree_*
 #include "tree.h"       // NULLPTR, LEFT, RIGHT
 
@@ -35,6 +41,37 @@ struct VRD_TEMPLATE(VRD_TYPENAME, _Node)
 }; // vrd_MNV_Node
 
 
+// The fields of a node stored in a tree file besides the key
+enum
+{
+    PHASE_MASK = (1 << 28) - 1,
+    FIELDS = 5
+}; // fields
+
+
+static inline void
+fields_get(struct VRD_TEMPLATE(VRD_TYPENAME, _Node) const* const node, uint32_t fields[FIELDS])
+{
+    fields[0] = node->end - node->key;
+    fields[1] = node->count;
+    fields[2] = node->sample_id;
+    fields[3] = (node->phase + 1) & PHASE_MASK;    // homozygous is 0
+    fields[4] = node->inserted;
+} // fields_get
+
+
+static inline void
+fields_set(struct VRD_TEMPLATE(VRD_TYPENAME, _Node)* const node, uint32_t const fields[FIELDS])
+{
+    node->end = node->key + fields[0];
+    node->count = fields[1];
+    node->sample_id = fields[2];
+    node->phase = (fields[3] - 1) & PHASE_MASK;
+    node->unused = 0;
+    node->inserted = fields[4];
+} // fields_set
+
+
 #define VRD_INTERVAL
 #include "template_tree.inc"    // vrd_MNV_tree_*
 #undef VRD_INTERVAL
@@ -95,38 +132,47 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)* cons
 } // vrd_MNV_tree_insert
 
 
-static size_t
+static void
 query(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
       size_t const root,
       size_t const start,
       size_t const end,
       size_t const inserted,
-      bool const homozygous,
-      vrd_AVL_Tree const* const subset)
+      vrd_AVL_Tree const* const subset,
+      size_t* const count,
+      size_t* const homozygous,
+      vrd_Carriers* const carriers)
 {
     if (NULLPTR == root || self->nodes[root].max < start)
     {
-        return 0;
+        return;
     } // if
 
     if (self->nodes[root].key > start)
     {
-        return query(self, self->nodes[root].child[LEFT], start, end, inserted, homozygous, subset);
+        query(self, self->nodes[root].child[LEFT], start, end, inserted, subset, count, homozygous, carriers);
+        return;
     } // if
 
-    size_t res = 0;
     // TODO: match inserted; IUPAC, overlap, ...
     if (start == self->nodes[root].key &&
         end == self->nodes[root].end &&
         inserted == self->nodes[root].inserted &&
-        (!homozygous || (homozygous && self->nodes[root].phase == VRD_HOMOZYGOUS)) &&
         (NULL == subset || vrd_AVL_tree_is_element(subset, self->nodes[root].sample_id)))
     {
-        res = self->nodes[root].count;
+        *count += self->nodes[root].count;
+        if (VRD_HOMOZYGOUS == self->nodes[root].phase)
+        {
+            *homozygous += self->nodes[root].count;
+        } // if
+        if (NULL != carriers)
+        {
+            vrd_carriers_add(carriers, self->nodes[root].sample_id);
+        } // if
     } // if
 
-    return res + query(self, self->nodes[root].child[LEFT], start, end, inserted, homozygous, subset) +
-                 query(self, self->nodes[root].child[RIGHT], start, end, inserted, homozygous, subset);
+    query(self, self->nodes[root].child[LEFT], start, end, inserted, subset, count, homozygous, carriers);
+    query(self, self->nodes[root].child[RIGHT], start, end, inserted, subset, count, homozygous, carriers);
 } // query
 
 
@@ -187,10 +233,101 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const*
 {
     assert(NULL != self);
 
-    return query(self, self->root, start, end, inserted, homozygous, subset);
+    size_t count = 0;
+    size_t count_homozygous = 0;
+    query(self, self->root, start, end, inserted, subset, &count, &count_homozygous, NULL);
+
+    return homozygous ? count_homozygous : count;
 } // vrd_MNV_tree_query
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                 size_t const start,
+                                                 size_t const end,
+                                                 size_t const inserted,
+                                                 vrd_AVL_Tree const* const subset,
+                                                 size_t* const homozygous,
+                                                 vrd_Carriers* const carriers)
+{
+    assert(NULL != self);
+    assert(NULL != homozygous);
+    assert(NULL != carriers);
+
+    size_t count = 0;
+    *homozygous = 0;
+    query(self, self->root, start, end, inserted, subset, &count, homozygous, carriers);
+
+    return count;
+} // vrd_MNV_tree_query_zygosity
+
+
+static void
+query_cohorts(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+              size_t const root,
+              size_t const start,
+              size_t const end,
+              size_t const inserted,
+              vrd_Cohort_Table const* const cohorts,
+              size_t count[])
+{
+    if (NULLPTR == root || self->nodes[root].max < start)
+    {
+        return;
+    } // if
+
+    if (self->nodes[root].key > start)
+    {
+        query_cohorts(self, self->nodes[root].child[LEFT], start, end, inserted, cohorts, count);
+        return;
+    } // if
+
+    if (start == self->nodes[root].key &&
+        end == self->nodes[root].end &&
+        inserted == self->nodes[root].inserted)
+    {
+        vrd_cohort_add(vrd_Cohort_table_mask(cohorts, self->nodes[root].sample_id), self->nodes[root].count, count);
+    } // if
+
+    query_cohorts(self, self->nodes[root].child[LEFT], start, end, inserted, cohorts, count);
+    query_cohorts(self, self->nodes[root].child[RIGHT], start, end, inserted, cohorts, count);
+} // query_cohorts
+
+
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                size_t const start,
+                                                size_t const end,
+                                                size_t const inserted,
+                                                vrd_Cohort_Table const* const cohorts,
+                                                size_t count[])
+{
+    assert(NULL != self);
+    assert(NULL != cohorts);
+    assert(NULL != count);
+
+    query_cohorts(self, self->root, start, end, inserted, cohorts, count);
+} // vrd_MNV_tree_query_cohorts
+
+
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_renumber)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const self,
+                                           size_t const count,
+                                           size_t const map[count])
+{
+    assert(NULL != self);
+
+    // a linear pass over the node array, the tree structure is unchanged
+    for (uint32_t i = 1; i < self->next; ++i)
+    {
+        if (self->nodes[i].inserted < count)
+        {
+            self->nodes[i].inserted = map[self->nodes[i].inserted];
+        } // if
+    } // for
+} // vrd_MNV_tree_renumber
+
+
 static size_t
 traverse_seq(VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const self,
              uint32_t const root,
@@ -12,8 +12,10 @@ extern "C"
 #include <stdio.h>      // FILE
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/cohort_table.h"    // vrd_Cohort_Table
 #include "../include/seq_table.h"   // vrd_Seq_Table
 #include "../include/template.h"    // VRD_TEMPLATE
+#include "carriers.h"   // vrd_Carriers
 
 
 #define VRD_TYPENAME MNV
@@ -51,6 +53,25 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const*
                                         vrd_AVL_Tree const* const subset);
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                 size_t const start,
+                                                 size_t const end,
+                                                 size_t const inserted,
+                                                 vrd_AVL_Tree const* const subset,
+                                                 size_t* const homozygous,
+                                                 vrd_Carriers* const carriers);
+
+
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                size_t const start,
+                                                size_t const end,
+                                                size_t const inserted,
+                                                vrd_Cohort_Table const* const cohorts,
+                                                size_t count[]);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                                size_t const start,
@@ -66,6 +87,12 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_remove_seq)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)*
                                              vrd_Seq_Table* const seq_table);
 
 
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_renumber)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const self,
+                                           size_t const count,
+                                           size_t const map[count]);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_export)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                          FILE* stream,
@@ -0,0 +1,61 @@
+#define _POSIX_C_SOURCE 200809L
+
+
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILENAME_MAX, snprintf
+#include <stdlib.h>     // mkstemp
+#include <sys/mman.h>   // MAP_*, PROT_*, POSIX_MADV_RANDOM, mmap,
+                        // munmap, posix_madvise
+#include <sys/types.h>  // off_t
+#include <unistd.h>     // close, ftruncate, unlink
+
+#include "paged.h"  // vrd_paged_*
+
+
+void*
+vrd_paged_alloc(char const* const directory, size_t const size)
+{
+    char filename[FILENAME_MAX] = {'\0'};
+    if (0 >= snprintf(filename, FILENAME_MAX, "%s/varda_XXXXXX", directory))
+    {
+        return NULL;
+    } // if
+
+    int const fd = mkstemp(filename);
+    if (-1 == fd)
+    {
+        return NULL;
+    } // if
+    (void) unlink(filename);
+
+    // the file is sparse: untouched pages take no space
+    if (0 != ftruncate(fd, (off_t) size))
+    {
+        (void) close(fd);
+        return NULL;
+    } // if
+
+    void* const ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void) close(fd);
+    if (MAP_FAILED == ptr)
+    {
+        return NULL;
+    } // if
+
+    // trees are searched, not scanned: no read ahead
+    (void) posix_madvise(ptr, size, POSIX_MADV_RANDOM);
+
+    return ptr;
+} // vrd_paged_alloc
+
+
+void
+vrd_paged_free(void* const ptr, size_t const size)
+{
+    if (NULL == ptr)
+    {
+        return;
+    } // if
+
+    (void) munmap(ptr, size);
+} // vrd_paged_free
@@ -0,0 +1,34 @@
+#ifndef VRD_PAGED_H
+#define VRD_PAGED_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stddef.h>     // size_t
+
+
+/**
+ * Memory backed by a file of its own in `directory` instead of by
+ * physical memory and swap. The file is removed right away; it lives as
+ * long as the mapping. The kernel reads and writes the memory a page at
+ * the time and evicts the pages least used when memory runs short, so
+ * the memory in use can exceed the physical memory.
+ *
+ * @return NULL on error (errno is set).
+ */
+void*
+vrd_paged_alloc(char const* const directory, size_t const size);
+
+
+void
+vrd_paged_free(void* const ptr, size_t const size);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
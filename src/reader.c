@@ -0,0 +1,500 @@
+#define _POSIX_C_SOURCE 200809L
+
+
+#include <assert.h>     // assert
+#include <errno.h>      // EINTR, EPIPE, errno
+#include <pthread.h>    // pthread_*
+#include <signal.h>     // SIGPIPE, sigaddset, sigemptyset, sigset_t
+#include <stdbool.h>    // bool, false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // uint32_t
+#include <stdio.h>      // EOF, FILE, fclose, fdopen, fread, getc, ungetc
+#include <stdlib.h>     // free, malloc
+#include <string.h>     // memcpy, memmove
+#include <sys/types.h>  // ssize_t
+#include <unistd.h>     // close, pipe, write
+
+#include <zlib.h>       // Z_*, crc32, inflate*, z_stream
+
+#include "../include/reader.h"  // vrd_Reader, vrd_reader_*
+
+
+static size_t const BGZF_HEADER = 18;
+static size_t const BGZF_MAX_BLOCK = 1 << 16;
+static size_t const BLOCKS_PER_THREAD = 16;
+
+static size_t const BUFFER_SIZE = 1 << 16;
+
+
+struct vrd_Reader
+{
+    FILE* source;
+    FILE* stream;
+
+    bool compressed;
+    bool bgzf;
+    size_t threads;
+
+    int fd;     // write end of the pipe
+    pthread_t thread;
+    int error;
+
+    size_t prefix_len;
+    unsigned char prefix[18];   // BGZF_HEADER
+}; // vrd_Reader
+
+
+struct Block
+{
+    unsigned char* data;
+    size_t size;
+    unsigned char* out;
+    size_t out_size;
+    int error;
+}; // Block
+
+
+struct Batch
+{
+    struct Block* blocks;
+    size_t count;
+    size_t offset;
+    size_t stride;
+}; // Batch
+
+
+// Writes everything unless the read end is closed
+static int
+write_all(int const fd, unsigned char const* const data, size_t const size)
+{
+    size_t done = 0;
+    while (done < size)
+    {
+        ssize_t const ret = write(fd, data + done, size - done);
+        if (0 > ret)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            } // if
+            return errno;
+        } // if
+        done += ret;
+    } // while
+    return 0;
+} // write_all
+
+
+// Reads the input; the bytes already consumed to detect the format are
+// read first
+static size_t
+source_read(vrd_Reader* const self, unsigned char* const data, size_t const size)
+{
+    size_t count = 0;
+    if (0 < self->prefix_len)
+    {
+        count = size < self->prefix_len ? size : self->prefix_len;
+        (void) memcpy(data, self->prefix, count);
+        (void) memmove(self->prefix, self->prefix + count, self->prefix_len - count);
+        self->prefix_len -= count;
+    } // if
+    return count + fread(data + count, 1, size - count, self->source);
+} // source_read
+
+
+static int
+gzip_inflate(vrd_Reader* const self)
+{
+    unsigned char* const in = malloc(BUFFER_SIZE);
+    unsigned char* const out = malloc(BUFFER_SIZE);
+    if (NULL == in || NULL == out)
+    {
+        free(in);
+        free(out);
+        return ENOMEM;
+    } // if
+
+    z_stream zs = {0};
+    if (Z_OK != inflateInit2(&zs, 15 + 16))
+    {
+        free(in);
+        free(out);
+        return -1;
+    } // if
+
+    int err = 0;
+    bool end = true;
+    for (;;)
+    {
+        zs.avail_in = source_read(self, in, BUFFER_SIZE);
+        zs.next_in = in;
+        if (0 == zs.avail_in)
+        {
+            break;
+        } // if
+
+        // continue while the output buffer is filled completely, as
+        // inflate may hold pending output
+        bool full = false;
+        while (0 < zs.avail_in || full)
+        {
+            // concatenated members
+            if (end)
+            {
+                (void) inflateReset(&zs);
+                end = false;
+            } // if
+
+            zs.avail_out = BUFFER_SIZE;
+            zs.next_out = out;
+            int const ret = inflate(&zs, Z_NO_FLUSH);
+            if (Z_OK != ret && Z_STREAM_END != ret && Z_BUF_ERROR != ret)
+            {
+                err = -1;
+                goto exit;
+            } // if
+            end = Z_STREAM_END == ret;
+            full = !end && 0 == zs.avail_out;
+
+            err = write_all(self->fd, out, BUFFER_SIZE - zs.avail_out);
+            if (0 != err)
+            {
+                goto exit;
+            } // if
+
+            if (Z_BUF_ERROR == ret && 0 < zs.avail_in)
+            {
+                err = -1;
+                goto exit;
+            } // if
+        } // while
+    } // for
+
+    if (!end)
+    {
+        err = -1;  // truncated
+    } // if
+
+exit:
+    (void) inflateEnd(&zs);
+    free(in);
+    free(out);
+    return err;
+} // gzip_inflate
+
+
+static inline size_t
+le16(unsigned char const* const data)
+{
+    return (size_t) data[0] | ((size_t) data[1] << 8);
+} // le16
+
+
+static inline uint32_t
+le32(unsigned char const* const data)
+{
+    return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+} // le32
+
+
+// Reads a complete BGZF block; returns false on end of input or error
+static bool
+bgzf_read(vrd_Reader* const self, struct Block* const block)
+{
+    block->size = 0;
+    block->error = 0;
+
+    size_t const count = source_read(self, block->data, BGZF_HEADER);
+    if (0 == count)
+    {
+        return false;
+    } // if
+
+    // only the BC subfield as written by bgzip is supported
+    if (BGZF_HEADER != count || 0x1F != block->data[0] || 0x8B != block->data[1] || 8 != block->data[2] || 0 == (block->data[3] & 4) ||
+        6 != le16(&block->data[10]) || 'B' != block->data[12] || 'C' != block->data[13] || 2 != le16(&block->data[14]))
+    {
+        block->error = -1;
+        return false;
+    } // if
+
+    size_t const size = le16(&block->data[16]) + 1;
+    if (BGZF_HEADER + 8 > size || size - BGZF_HEADER != fread(block->data + BGZF_HEADER, 1, size - BGZF_HEADER, self->source))
+    {
+        block->error = -1;
+        return false;
+    } // if
+
+    block->size = size;
+    return true;
+} // bgzf_read
+
+
+static void
+bgzf_inflate(struct Block* const block)
+{
+    block->out_size = 0;
+
+    uint32_t const crc = le32(&block->data[block->size - 8]);
+    size_t const isize = le32(&block->data[block->size - 4]);
+    if (BGZF_MAX_BLOCK < isize)
+    {
+        block->error = -1;
+        return;
+    } // if
+
+    z_stream zs = {0};
+    if (Z_OK != inflateInit2(&zs, -15))
+    {
+        block->error = -1;
+        return;
+    } // if
+
+    zs.next_in = block->data + BGZF_HEADER;
+    zs.avail_in = block->size - BGZF_HEADER - 8;
+    zs.next_out = block->out;
+    zs.avail_out = BGZF_MAX_BLOCK;
+
+    int const ret = inflate(&zs, Z_FINISH);
+    (void) inflateEnd(&zs);
+
+    block->out_size = BGZF_MAX_BLOCK - zs.avail_out;
+    if (Z_STREAM_END != ret || isize != block->out_size || crc != crc32(crc32(0, Z_NULL, 0), block->out, block->out_size))
+    {
+        block->error = -1;
+    } // if
+} // bgzf_inflate
+
+
+static void*
+bgzf_worker(void* const arg)
+{
+    struct Batch const* const batch = arg;
+    for (size_t i = batch->offset; i < batch->count; i += batch->stride)
+    {
+        bgzf_inflate(&batch->blocks[i]);
+    } // for
+    return NULL;
+} // bgzf_worker
+
+
+static int
+bgzf_decompress(vrd_Reader* const self)
+{
+    size_t const capacity = self->threads * BLOCKS_PER_THREAD;
+
+    int err = 0;
+
+    struct Block* const blocks = malloc(sizeof(*blocks) * capacity);
+    pthread_t* const workers = malloc(sizeof(*workers) * self->threads);
+    struct Batch* const batches = malloc(sizeof(*batches) * self->threads);
+    unsigned char* const buffer = malloc(2 * BGZF_MAX_BLOCK * capacity);
+    if (NULL == blocks || NULL == workers || NULL == batches || NULL == buffer)
+    {
+        err = ENOMEM;
+        goto exit;
+    } // if
+
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        blocks[i].data = buffer + 2 * i * BGZF_MAX_BLOCK;
+        blocks[i].out = blocks[i].data + BGZF_MAX_BLOCK;
+    } // for
+
+    bool more = true;
+    while (more)
+    {
+        size_t count = 0;
+        while (count < capacity)
+        {
+            more = bgzf_read(self, &blocks[count]);
+            if (!more)
+            {
+                err = blocks[count].error;
+                break;
+            } // if
+            count += 1;
+        } // while
+
+        for (size_t i = 0; i < self->threads; ++i)
+        {
+            batches[i].blocks = blocks;
+            batches[i].count = count;
+            batches[i].offset = i;
+            batches[i].stride = self->threads;
+        } // for
+
+        // the first worker runs on this thread
+        size_t started = 1;
+        while (started < self->threads && started < count &&
+               0 == pthread_create(&workers[started], NULL, bgzf_worker, &batches[started]))
+        {
+            started += 1;
+        } // while
+
+        // the batches of workers that failed to start run here as well
+        for (size_t i = started; i < self->threads; ++i)
+        {
+            (void) bgzf_worker(&batches[i]);
+        } // for
+        (void) bgzf_worker(&batches[0]);
+
+        for (size_t i = 1; i < started; ++i)
+        {
+            (void) pthread_join(workers[i], NULL);
+        } // for
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (0 != blocks[i].error)
+            {
+                err = blocks[i].error;
+                goto exit;
+            } // if
+
+            int const ret = write_all(self->fd, blocks[i].out, blocks[i].out_size);
+            if (0 != ret)
+            {
+                err = ret;
+                goto exit;
+            } // if
+        } // for
+
+        if (0 != err)
+        {
+            break;
+        } // if
+    } // while
+
+exit:
+    free(blocks);
+    free(workers);
+    free(batches);
+    free(buffer);
+    return err;
+} // bgzf_decompress
+
+
+static void*
+decompress(void* const arg)
+{
+    vrd_Reader* const self = arg;
+
+    // a closed read end is reported as EPIPE instead of a signal
+    sigset_t set;
+    (void) sigemptyset(&set);
+    (void) sigaddset(&set, SIGPIPE);
+    (void) pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+    self->error = self->bgzf ? bgzf_decompress(self) : gzip_inflate(self);
+    if (EPIPE == self->error)
+    {
+        self->error = 0;  // the reader stopped reading
+    } // if
+
+    (void) close(self->fd);
+    self->fd = -1;
+
+    return NULL;
+} // decompress
+
+
+vrd_Reader*
+vrd_reader_open(FILE* const stream, size_t const threads)
+{
+    assert(NULL != stream);
+
+    vrd_Reader* const reader = malloc(sizeof(*reader));
+    if (NULL == reader)
+    {
+        return NULL;
+    } // if
+
+    reader->source = stream;
+    reader->stream = stream;
+    reader->compressed = false;
+    reader->bgzf = false;
+    reader->threads = 0 == threads ? 1 : threads;
+    reader->fd = -1;
+    reader->error = 0;
+    reader->prefix_len = 0;
+
+    int const first = getc(stream);
+    if (EOF == first)
+    {
+        return reader;
+    } // if
+    if (0x1F != first)
+    {
+        (void) ungetc(first, stream);
+        return reader;
+    } // if
+
+    reader->prefix[0] = first;
+    reader->prefix_len = 1 + fread(reader->prefix + 1, 1, BGZF_HEADER - 1, stream);
+    reader->compressed = true;
+    reader->bgzf = BGZF_HEADER == reader->prefix_len && 0x8B == reader->prefix[1] && 0 != (reader->prefix[3] & 4) &&
+                   6 == le16(&reader->prefix[10]) && 'B' == reader->prefix[12] && 'C' == reader->prefix[13];
+
+    int fds[2] = {-1, -1};
+    if (0 != pipe(fds))
+    {
+        free(reader);
+        return NULL;
+    } // if
+
+    reader->stream = fdopen(fds[0], "r");
+    if (NULL == reader->stream)
+    {
+        (void) close(fds[0]);
+        (void) close(fds[1]);
+        free(reader);
+        return NULL;
+    } // if
+    reader->fd = fds[1];
+
+    int const ret = pthread_create(&reader->thread, NULL, decompress, reader);
+    if (0 != ret)
+    {
+        (void) fclose(reader->stream);
+        (void) close(fds[1]);
+        free(reader);
+        errno = ret;
+        return NULL;
+    } // if
+
+    return reader;
+} // vrd_reader_open
+
+
+FILE*
+vrd_reader_stream(vrd_Reader const* const self)
+{
+    assert(NULL != self);
+
+    return self->stream;
+} // vrd_reader_stream
+
+
+int
+vrd_reader_close(vrd_Reader** const self)
+{
+    if (NULL == self || NULL == *self)
+    {
+        return 0;
+    } // if
+
+    int err = 0;
+    if ((*self)->compressed)
+    {
+        // closing the read end stops the decompression
+        (void) fclose((*self)->stream);
+        (void) pthread_join((*self)->thread, NULL);
+        err = (*self)->error;
+    } // if
+
+    free(*self);
+    *self = NULL;
+
+    return err;
+} // vrd_reader_close
@@ -0,0 +1,262 @@
+#include <assert.h>     // assert
+#include <errno.h>      // errno
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // UINT32_MAX, UINT64_C, uint64_t
+#include <stdlib.h>     // calloc, free, malloc
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/sample_attributes.h"   // vrd_Predicate,
+                                            // vrd_Sample_Attributes,
+                                            // vrd_Sample_attributes_*
+#include "../include/trie.h"    // vrd_Trie_Node, vrd_Trie, vrd_trie_*
+
+
+struct vrd_Sample_Attributes
+{
+    vrd_Trie* trie;
+
+    size_t capacity;
+    size_t words;
+
+    size_t label_capacity;
+    size_t next;
+    vrd_Trie_Node* labels[];
+}; // vrd_Sample_Attributes
+
+
+static size_t const BITS = 64;
+
+
+vrd_Sample_Attributes*
+vrd_Sample_attributes_init(size_t const capacity,
+                           size_t const label_capacity)
+{
+    if ((size_t) UINT32_MAX <= capacity || (size_t) UINT32_MAX <= label_capacity)
+    {
+        errno = -1;
+        return NULL;
+    } // if
+
+    vrd_Sample_Attributes* const attributes = malloc(sizeof(*attributes) + sizeof(attributes->labels[0]) * label_capacity);
+    if (NULL == attributes)
+    {
+        return NULL;
+    } // if
+
+    attributes->trie = vrd_trie_init();
+    if (NULL == attributes->trie)
+    {
+        free(attributes);
+        return NULL;
+    } // if
+
+    attributes->capacity = capacity;
+    attributes->words = (capacity + BITS - 1) / BITS;
+    attributes->label_capacity = label_capacity;
+    attributes->next = 0;
+
+    return attributes;
+} // vrd_Sample_attributes_init
+
+
+void
+vrd_Sample_attributes_destroy(vrd_Sample_Attributes** const self)
+{
+    if (NULL == self || NULL == *self)
+    {
+        return;
+    } // if
+
+    for (size_t i = 0; i < (*self)->next; ++i)
+    {
+        free((*self)->labels[i]->data);
+    } // for
+    vrd_trie_destroy(&(*self)->trie);
+    free(*self);
+    *self = NULL;
+} // vrd_Sample_attributes_destroy
+
+
+int
+vrd_Sample_attributes_insert(vrd_Sample_Attributes* const self,
+                             size_t const len,
+                             char const label[len],
+                             size_t const sample_id)
+{
+    assert(NULL != self);
+
+    if (self->capacity <= sample_id)
+    {
+        return -1;
+    } // if
+
+    vrd_Trie_Node* elem = vrd_trie_find(self->trie, len, label);
+    if (NULL == elem)
+    {
+        if (self->label_capacity <= self->next)
+        {
+            return -1;
+        } // if
+
+        uint64_t* const bitmap = calloc(self->words, sizeof(*bitmap));
+        if (NULL == bitmap)
+        {
+            return ENOMEM;
+        } // if
+
+        elem = vrd_trie_insert(self->trie, len, label, bitmap);
+        if (NULL == elem)
+        {
+            free(bitmap);
+            return -1;
+        } // if
+
+        self->labels[self->next] = elem;
+        self->next += 1;
+    } // if
+
+    uint64_t* const bitmap = elem->data;
+    bitmap[sample_id / BITS] |= UINT64_C(1) << (sample_id % BITS);
+
+    return 0;
+} // vrd_Sample_attributes_insert
+
+
+// Returns the maximum stack depth of a well-formed predicate, 0 otherwise
+static size_t
+depth(size_t const count, vrd_Predicate const predicate[count])
+{
+    size_t max = 0;
+    size_t top = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (VRD_PREDICATE_LABEL == predicate[i].op)
+        {
+            top += 1;
+            max = top > max ? top : max;
+        } // if
+        else if (VRD_PREDICATE_AND == predicate[i].op || VRD_PREDICATE_OR == predicate[i].op)
+        {
+            if (2 > top)
+            {
+                return 0;
+            } // if
+            top -= 1;
+        } // if
+        else if (VRD_PREDICATE_NOT != predicate[i].op || 1 > top)
+        {
+            return 0;
+        } // if
+    } // for
+
+    return 1 == top ? max : 0;
+} // depth
+
+
+vrd_AVL_Tree*
+vrd_Sample_attributes_select(vrd_Sample_Attributes const* const self,
+                             size_t const count,
+                             vrd_Predicate const predicate[count])
+{
+    assert(NULL != self);
+
+    size_t const max = depth(count, predicate);
+    if (0 == max)
+    {
+        return NULL;
+    } // if
+
+    size_t const words = self->words;
+    uint64_t* const stack = malloc(sizeof(*stack) * words * max);
+    if (NULL == stack)
+    {
+        return NULL;
+    } // if
+
+    size_t top = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (VRD_PREDICATE_LABEL == predicate[i].op)
+        {
+            uint64_t* const dst = stack + top * words;
+            vrd_Trie_Node const* const elem = vrd_trie_find(self->trie, predicate[i].len, predicate[i].label);
+            uint64_t const* const bitmap = NULL == elem ? NULL : elem->data;
+            for (size_t j = 0; j < words; ++j)
+            {
+                dst[j] = NULL == bitmap ? 0 : bitmap[j];
+            } // for
+            top += 1;
+        } // if
+        else if (VRD_PREDICATE_NOT == predicate[i].op)
+        {
+            uint64_t* const dst = stack + (top - 1) * words;
+            for (size_t j = 0; j < words; ++j)
+            {
+                dst[j] = ~dst[j];
+            } // for
+        } // if
+        else
+        {
+            top -= 1;
+            uint64_t* const dst = stack + (top - 1) * words;
+            uint64_t const* const src = stack + top * words;
+            if (VRD_PREDICATE_AND == predicate[i].op)
+            {
+                for (size_t j = 0; j < words; ++j)
+                {
+                    dst[j] &= src[j];
+                } // for
+            } // if
+            else
+            {
+                for (size_t j = 0; j < words; ++j)
+                {
+                    dst[j] |= src[j];
+                } // for
+            } // else
+        } // else
+    } // for
+
+    // clear the bits beyond the capacity set by negation
+    if (0 < words && 0 != self->capacity % BITS)
+    {
+        stack[words - 1] &= (UINT64_C(1) << (self->capacity % BITS)) - 1;
+    } // if
+
+    size_t size = 0;
+    for (size_t j = 0; j < words; ++j)
+    {
+        size += __builtin_popcountll(stack[j]);
+    } // for
+
+    vrd_AVL_Tree* tree = vrd_AVL_tree_init(size);
+    if (NULL == tree)
+    {
+        free(stack);
+        return NULL;
+    } // if
+
+    for (size_t j = 0; j < words; ++j)
+    {
+        uint64_t word = stack[j];
+        while (0 != word)
+        {
+            if (0 != vrd_AVL_tree_insert(tree, j * BITS + __builtin_ctzll(word)))
+            {
+                free(stack);
+                vrd_AVL_tree_destroy(&tree);
+                return NULL;
+            } // if
+            word &= word - 1;
+        } // while
+    } // for
+    free(stack);
+
+    if (0 < size && 0 != vrd_AVL_tree_reorder(tree))
+    {
+        vrd_AVL_tree_destroy(&tree);
+        return NULL;
+    } // if
+
+    return tree;
+} // vrd_Sample_attributes_select
@@ -0,0 +1,365 @@
+#include <assert.h>     // assert
+#include <errno.h>      // errno
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // UINT32_MAX
+#include <stdio.h>      // FILE, FILENAME_MAX, fclose, fopen, fread
+                        // fwrite, snprintf
+#include <stdlib.h>     // free, malloc
+
+#include "../include/avl_tree.h"        // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/sample_registry.h"     // vrd_Sample_Registry,
+                                            // vrd_Sample_registry_*
+#include "../include/trie.h"    // vrd_Trie_Node, vrd_Trie, vrd_trie_*
+#include "tree.h"   // vrd_Tree
+
+
+struct vrd_Sample_Registry
+{
+    vrd_Trie* trie;
+
+    size_t capacity;
+
+    size_t next;
+    vrd_Trie_Node* sets[];
+}; // vrd_Sample_Registry
+
+
+vrd_Sample_Registry*
+vrd_Sample_registry_init(size_t const capacity)
+{
+    if ((size_t) UINT32_MAX <= capacity)
+    {
+        errno = -1;
+        return NULL;
+    } // if
+
+    vrd_Sample_Registry* const registry = malloc(sizeof(*registry) + sizeof(registry->sets[0]) * capacity);
+    if (NULL == registry)
+    {
+        return NULL;
+    } // if
+
+    registry->trie = vrd_trie_init();
+    if (NULL == registry->trie)
+    {
+        free(registry);
+        return NULL;
+    } // if
+
+    registry->capacity = capacity;
+    registry->next = 0;
+
+    return registry;
+} // vrd_Sample_registry_init
+
+
+void
+vrd_Sample_registry_destroy(vrd_Sample_Registry** const self)
+{
+    if (NULL == self || NULL == *self)
+    {
+        return;
+    } // if
+
+    for (size_t i = 0; i < (*self)->next; ++i)
+    {
+        vrd_AVL_tree_destroy((vrd_AVL_Tree**) &(*self)->sets[i]->data);
+    } // for
+    vrd_trie_destroy(&(*self)->trie);
+    free(*self);
+    *self = NULL;
+} // vrd_Sample_registry_destroy
+
+
+int
+vrd_Sample_registry_insert(vrd_Sample_Registry* const self,
+                           size_t const len,
+                           char const name[len],
+                           vrd_AVL_Tree* const subset)
+{
+    assert(NULL != self);
+    assert(NULL != subset);
+
+    if (self->capacity <= self->next || NULL != vrd_trie_find(self->trie, len, name))
+    {
+        return -1;
+    } // if
+
+    vrd_Trie_Node* const elem = vrd_trie_insert(self->trie, len, name, subset);
+    if (NULL == elem)
+    {
+        return -1;
+    } // if
+
+    self->sets[self->next] = elem;
+    self->next += 1;
+
+    return 0;
+} // vrd_Sample_registry_insert
+
+
+vrd_AVL_Tree const*
+vrd_Sample_registry_find(vrd_Sample_Registry const* const self,
+                         size_t const len,
+                         char const name[len])
+{
+    assert(NULL != self);
+
+    vrd_Trie_Node const* const elem = vrd_trie_find(self->trie, len, name);
+    if (NULL == elem)
+    {
+        return NULL;
+    } // if
+
+    return elem->data;
+} // vrd_Sample_registry_find
+
+
+static vrd_AVL_Tree*
+set_read(char const* const path,
+         size_t const idx,
+         size_t const capacity)
+{
+    char filename[FILENAME_MAX] = {'\0'};
+    size_t const buf_size = FILENAME_MAX;
+    if (0 >= snprintf(filename, buf_size, "%s_tree_%zu.bin", path, idx))
+    {
+        return NULL;
+    } // if
+
+    vrd_AVL_Tree* tree = NULL;
+
+    FILE* stream = fopen(filename, "rb");
+    if (NULL == stream)
+    {
+        goto error;
+    } // if
+
+    tree = vrd_AVL_tree_init(capacity);
+    if (NULL == tree)
+    {
+        goto error;
+    } // if
+
+    int const ret = vrd_AVL_tree_read(tree, stream);
+    if (0 != ret)
+    {
+        goto error;
+    } // if
+
+    if (0 != fclose(stream))
+    {
+        goto error;
+    } // if
+
+    return tree;
+
+error:
+    {
+        if (NULL != stream)
+        {
+            (void) fclose(stream);
+        } // if
+        vrd_AVL_tree_destroy(&tree);
+
+        return NULL;
+    }
+} // set_read
+
+
+int
+vrd_Sample_registry_read(vrd_Sample_Registry* const self,
+                         char const* const path)
+{
+    assert(NULL != self);
+    assert(NULL != path);
+
+    char filename[FILENAME_MAX] = {'\0'};
+    size_t const buf_size = FILENAME_MAX;
+    if (0 >= snprintf(filename, buf_size, "%s.idx", path))
+    {
+        return errno;
+    } // if
+
+    FILE* stream = fopen(filename, "rb");
+    if (NULL == stream)
+    {
+        return errno;
+    } // if
+
+    char* name = NULL;
+    vrd_AVL_Tree* tree = NULL;
+    size_t size = 0;
+    size_t count = fread(&size, sizeof(size), 1, stream);
+    if (1 != count)
+    {
+        goto error;
+    } // if
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        size_t len = 0;
+        count = fread(&len, sizeof(len), 1, stream);
+        if (1 != count)
+        {
+            goto error;
+        } // if
+
+        name = malloc(len);
+        if (NULL == name)
+        {
+            goto error;
+        } // if
+
+        count = fread(name, 1, len, stream);
+        if (len != count)
+        {
+            goto error;
+        } // if
+
+        size_t entries = 0;
+        count = fread(&entries, sizeof(entries), 1, stream);
+        if (1 != count)
+        {
+            goto error;
+        } // if
+
+        tree = set_read(path, i, entries);
+        if (NULL == tree)
+        {
+            errno = -1;
+            goto error;
+        } // if
+
+        if (0 != vrd_Sample_registry_insert(self, len, name, tree))
+        {
+            errno = -1;
+            goto error;
+        } // if
+        tree = NULL;
+
+        free(name);
+        name = NULL;
+    } // for
+
+    if (0 != fclose(stream))
+    {
+        return errno;
+    } // if
+
+    return 0;
+
+error:
+    {
+        int const err = errno;
+        if (NULL != stream)
+        {
+            (void) fclose(stream);
+        } // if
+        vrd_AVL_tree_destroy(&tree);
+        free(name);
+
+        return err;
+    }
+} // vrd_Sample_registry_read
+
+
+int
+vrd_Sample_registry_write(vrd_Sample_Registry const* const self,
+                          char const* const path)
+{
+    assert(NULL != self);
+    assert(NULL != path);
+
+    char filename[FILENAME_MAX] = {'\0'};
+    size_t const buf_size = FILENAME_MAX;
+    if (0 >= snprintf(filename, buf_size, "%s.idx", path))
+    {
+        return errno;
+    } // if
+
+    FILE* stream = fopen(filename, "wb");
+    if (NULL == stream)
+    {
+        return errno;
+    } // if
+
+    char* name = NULL;
+    size_t count = fwrite(&self->next, sizeof(self->next), 1, stream);
+    if (1 != count)
+    {
+        goto error;
+    } // if
+
+    for (size_t i = 0; i < self->next; ++i)
+    {
+        size_t const len = vrd_trie_key(self->sets[i], &name);
+
+        count = fwrite(&len, sizeof(len), 1, stream);
+        if (1 != count)
+        {
+            goto error;
+        } // if
+
+        count = fwrite(name, 1, len, stream);
+        if (len != count)
+        {
+            goto error;
+        } // if
+
+        size_t const entries = ((vrd_Tree const*) self->sets[i]->data)->entries;
+        count = fwrite(&entries, sizeof(entries), 1, stream);
+        if (1 != count)
+        {
+            goto error;
+        } // if
+
+        free(name);
+        name = NULL;
+    } // for
+
+    if (0 != fclose(stream))
+    {
+        return errno;
+    } // if
+
+    for (size_t i = 0; i < self->next; ++i)
+    {
+        if (0 >= snprintf(filename, buf_size, "%s_tree_%zu.bin", path, i))
+        {
+            return errno;
+        } // if
+
+        stream = fopen(filename, "wb");
+        if (NULL == stream)
+        {
+            goto error;
+        } // if
+
+        int const ret = vrd_AVL_tree_write(self->sets[i]->data, stream);
+        if (0 != ret)
+        {
+            errno = ret;
+            goto error;
+        } // if
+
+        if (0 != fclose(stream))
+        {
+            return errno;
+        } // if
+    } // for
+
+    return 0;
+
+error:
+    {
+        int const err = errno;
+        if (NULL != stream)
+        {
+            (void) fclose(stream);
+        } // if
+        free(name);
+
+        return err;
+    }
+} // vrd_Sample_registry_write
@@ -1,22 +1,27 @@
 #include <assert.h>     // assert
 #include <errno.h>      // errno
 #include <stddef.h>     // NULL, size_t
-#include <stdint.h>     // UINT32_MAX
+#include <stdint.h>     // UINT32_MAX, UINT64_C, uint32_t, uint64_t
 #include <stdio.h>      // FILE, FILENAME_MAX, fclose, fopen, fread
                         // fwrite, snprintf
-#include <stdlib.h>     // free, malloc
+#include <stdlib.h>     // free, malloc, realloc
+#include <string.h>     // memcpy
 
 #include "../include/diagnostics.h"     // vrd_Diagnostics
 #include "../include/seq_table.h"   // vrd_Seq_Table
 #include "../include/trie.h"        // vrd_Trie_Node, vrd_Trie, vrd_trie_*
+#include "bitmap.h"     // vrd_Bitmap, vrd_bitmap_*
 
 
-struct Free_Node
+// An entry of the (open addressing) hash index: the 64-bit fingerprint
+// and the length of a sequence select the candidates, the key in the
+// trie decides
+struct Slot
 {
-    size_t start;
-    size_t end;
-    struct Free_Node* next;
-}; // Free_Node
+    uint64_t fingerprint;
+    uint32_t len;
+    uint32_t idx;
+}; // Slot
 
 
 struct vrd_Seq_Table
@@ -24,179 +29,264 @@ struct vrd_Seq_Table
     vrd_Trie* trie;
 
     size_t capacity;
-    struct Free_Node* free_list;
+    vrd_Bitmap* free_slots;
+    vrd_Bitmap* used_slots;
 
-    vrd_Trie_Node* sequences[];
+    size_t hash_size;   // a power of two
+    size_t hash_used;   // including deleted slots
+    struct Slot* hash;
+
+    vrd_Trie_Node** sequences;
 }; // vrd_Seq_Table
 
 
-static struct Free_Node*
-free_node_init(size_t const start,
-               size_t const end,
-               struct Free_Node* const next)
+static size_t const MAX_CAPACITY = (size_t) UINT32_MAX - 1;
+
+static uint32_t const EMPTY = UINT32_MAX;
+static uint32_t const DELETED = UINT32_MAX - 1;  // never a valid index
+
+
+static inline uint64_t
+mix(uint64_t x)
 {
-    struct Free_Node* const node = malloc(sizeof(*node));
-    if (NULL == node)
-    {
-        return NULL;
-    } // if
+    x ^= x >> 33;
+    x *= UINT64_C(0xFF51AFD7ED558CCD);
+    x ^= x >> 33;
+    x *= UINT64_C(0xC4CEB9FE1A85EC53);
+    x ^= x >> 33;
+    return x;
+} // mix
 
-    node->start = start;
-    node->end = end;
-    node->next = next;
 
-    return node;
-} // free_node_init
+static uint64_t
+fingerprint(size_t const len, char const sequence[len])
+{
+    uint64_t hash = mix(len);
 
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        (void) memcpy(&word, &sequence[i], sizeof(word));
+        hash = mix(hash ^ word);
+    } // for
 
-static void
-free_list_destroy(struct Free_Node** const free_list)
+    uint64_t word = 0;
+    (void) memcpy(&word, &sequence[i], len - i);
+    return mix(hash ^ word);
+} // fingerprint
+
+
+// Equal fingerprints do not imply equal sequences; the probing
+// continues past any slot whose key differs
+static struct Slot*
+hash_find(vrd_Seq_Table const* const self,
+          uint64_t const fingerprint,
+          size_t const len,
+          char const sequence[len])
 {
-    if (NULL == free_list)
+    struct Slot* const hash = self->hash;
+    size_t const mask = self->hash_size - 1;
+    for (size_t i = fingerprint & mask; EMPTY != hash[i].idx; i = (i + 1) & mask)
     {
-        return;
-    } // if
+        if (DELETED != hash[i].idx && fingerprint == hash[i].fingerprint && (uint32_t) len == hash[i].len &&
+            vrd_trie_key_equal(self->sequences[hash[i].idx], len, sequence))
+        {
+            return &hash[i];
+        } // if
+    } // for
+    return NULL;
+} // hash_find
+
 
-    while (NULL != *free_list)
+static void
+hash_place(struct Slot* const hash,
+           size_t const hash_size,
+           struct Slot const slot)
+{
+    size_t const mask = hash_size - 1;
+    size_t i = slot.fingerprint & mask;
+    while (EMPTY != hash[i].idx && DELETED != hash[i].idx)
     {
-        struct Free_Node* const tmp = *free_list;
-        *free_list = (*free_list)->next;
-        free(tmp);
+        i = (i + 1) & mask;
     } // while
+    hash[i] = slot;
+} // hash_place
 
-    *free_list = NULL;
-} // free_list_destroy
 
-
-static struct Free_Node*
-free_list_alloc(struct Free_Node* const free_list, size_t* const idx)
+// Rebuilds the hash index with (at least) twice the live entries as
+// size; this also drops the deleted slots
+static int
+hash_rebuild(vrd_Seq_Table* const self, size_t const live)
 {
-    if (NULL == free_list)
+    size_t hash_size = 16;
+    while (hash_size < 2 * (live + 1))
     {
-        *idx = -1;
-        return NULL;
+        hash_size *= 2;
+    } // while
+
+    struct Slot* const hash = malloc(sizeof(*hash) * hash_size);
+    if (NULL == hash)
+    {
+        return ENOMEM;
     } // if
 
-    *idx = free_list->start;
+    for (size_t i = 0; i < hash_size; ++i)
+    {
+        hash[i].idx = EMPTY;
+    } // for
 
-    free_list->start += 1;
-    if (free_list->start >= free_list->end)
+    size_t used = 0;
+    for (size_t i = 0; i < self->hash_size; ++i)
     {
-        struct Free_Node* const tmp = free_list->next;
-        free(free_list);
-        return tmp;
-    } // if
-    return free_list;
-} // free_list_alloc
+        if (EMPTY != self->hash[i].idx && DELETED != self->hash[i].idx)
+        {
+            hash_place(hash, hash_size, self->hash[i]);
+            used += 1;
+        } // if
+    } // for
 
+    free(self->hash);
+    self->hash = hash;
+    self->hash_size = hash_size;
+    self->hash_used = used;
 
-static struct Free_Node*
-free_list_dealloc(struct Free_Node* const free_list, size_t const idx)
+    return 0;
+} // hash_rebuild
+
+
+static int
+hash_insert(vrd_Seq_Table* const self,
+            uint64_t const fingerprint,
+            size_t const len,
+            size_t const idx)
 {
-    if (NULL == free_list || free_list->start >= idx)
+    if (2 * (self->hash_used + 1) > self->hash_size)
     {
-        if (NULL != free_list && idx >= free_list->start && idx < free_list->end)
+        size_t live = 0;
+        for (size_t i = 0; i < self->hash_size; ++i)
         {
-            return free_list;
-        } // if
+            live += EMPTY != self->hash[i].idx && DELETED != self->hash[i].idx;
+        } // for
 
-        if (NULL != free_list && idx + 1 == free_list->start)
+        int const err = hash_rebuild(self, 2 * live);
+        if (0 != err)
         {
-            free_list->start -= 1;
-            return free_list;
+            return err;
         } // if
-
-        return free_node_init(idx, idx + 1, free_list);
     } // if
 
-    struct Free_Node* tmp = free_list;
-    while (NULL != tmp->next && tmp->next->start < idx)
+    size_t const mask = self->hash_size - 1;
+    size_t i = fingerprint & mask;
+    while (EMPTY != self->hash[i].idx && DELETED != self->hash[i].idx)
     {
-        tmp = tmp->next;
+        i = (i + 1) & mask;
     } // while
 
-    if (idx >= tmp->start && idx < tmp->end)
+    self->hash_used += EMPTY == self->hash[i].idx;
+    self->hash[i].fingerprint = fingerprint;
+    self->hash[i].len = len;
+    self->hash[i].idx = idx;
+
+    return 0;
+} // hash_insert
+
+
+// Grows the table to at least `capacity` by doubling; the indices of the
+// existing sequences do not change
+static int
+grow(vrd_Seq_Table* const self, size_t const capacity)
+{
+    if (capacity <= self->capacity)
     {
-        return free_list;
+        return 0;
     } // if
 
-    if (idx == tmp->end)
+    if (MAX_CAPACITY < capacity)
     {
-        tmp->end += 1;
-        return free_list;
+        return -1;
     } // if
 
-    if (NULL != tmp->next && idx + 1 == tmp->next->start)
+    size_t new_capacity = 0 == self->capacity ? 16 : self->capacity;
+    while (new_capacity < capacity)
     {
-        tmp->next->start -= 1;
-        return free_list;
+        new_capacity *= 2;
+    } // while
+    if (MAX_CAPACITY < new_capacity)
+    {
+        new_capacity = MAX_CAPACITY;
     } // if
 
-    if (NULL != tmp->next && idx >= tmp->next->start && idx < tmp->next->end)
+    vrd_Trie_Node** const sequences = realloc(self->sequences, sizeof(*sequences) * new_capacity);
+    if (NULL == sequences)
     {
-        return free_list;
+        return ENOMEM;
     } // if
+    self->sequences = sequences;
 
-    if (NULL != tmp->next && idx == tmp->next->end)
+    vrd_Bitmap* const free_slots = vrd_bitmap_resize(self->free_slots, new_capacity, true);
+    if (NULL == free_slots)
     {
-        tmp->next->end += 1;
-        return free_list;
+        return ENOMEM;
     } // if
+    self->free_slots = free_slots;
 
-    tmp->next = free_node_init(idx, idx + 1, tmp->next);
-
-    return free_list;
-} // free_list_dealloc
-
-
-static size_t
-free_list_max(struct Free_Node const* const head, size_t const capacity)
-{
-    if (NULL == head)
+    vrd_Bitmap* const used_slots = vrd_bitmap_resize(self->used_slots, new_capacity, false);
+    if (NULL == used_slots)
     {
-        return capacity;
+        // the free slots beyond the capacity are never handed out
+        return ENOMEM;
     } // if
+    self->used_slots = used_slots;
 
-    struct Free_Node const* tmp = head;
+    self->capacity = new_capacity;
 
-    size_t idx = tmp->start;
-    while (NULL != tmp->next)
-    {
-        tmp = tmp->next;
-        idx = tmp->start;
-    } // while
-
-    return idx;
-} // free_list_max
+    return 0;
+} // grow
 
 
 vrd_Seq_Table*
 vrd_Seq_table_init(size_t const capacity)
 {
-    if ((size_t) UINT32_MAX <= capacity)
+    if (MAX_CAPACITY < capacity)
     {
         errno = -1;
         return NULL;
     } // if
 
-    vrd_Seq_Table* const table = malloc(sizeof(*table) + sizeof(table->sequences[0]) * capacity);
+    vrd_Seq_Table* const table = malloc(sizeof(*table));
     if (NULL == table)
     {
         return NULL;
     } // if
 
+    table->sequences = malloc(sizeof(table->sequences[0]) * capacity);
+    if (NULL == table->sequences && 0 < capacity)
+    {
+        free(table);
+        return NULL;
+    } // if
+
     table->trie = vrd_trie_init();
     if (NULL == table->trie)
     {
+        free(table->sequences);
         free(table);
         return NULL;
     } // if
 
     table->capacity = capacity;
-    table->free_list = free_node_init(0, capacity, NULL);
-    if (NULL == table->free_list)
-    {
+    table->free_slots = vrd_bitmap_init(capacity, true);
+    table->used_slots = vrd_bitmap_init(capacity, false);
+    table->hash_size = 0;
+    table->hash_used = 0;
+    table->hash = NULL;
+    if (NULL == table->free_slots || NULL == table->used_slots || 0 != hash_rebuild(table, 0))
+    {
+        vrd_bitmap_destroy(&table->free_slots);
+        vrd_bitmap_destroy(&table->used_slots);
         vrd_trie_destroy(&table->trie);
+        free(table->sequences);
         free(table);
         return NULL;
     } // if
@@ -214,7 +304,10 @@ vrd_Seq_table_destroy(vrd_Seq_Table** const self)
     } // if
 
     vrd_trie_destroy(&(*self)->trie);
-    free_list_destroy(&(*self)->free_list);
+    vrd_bitmap_destroy(&(*self)->free_slots);
+    vrd_bitmap_destroy(&(*self)->used_slots);
+    free((*self)->hash);
+    free((*self)->sequences);
     free(*self);
     *self = NULL;
 } // vrd_Seq_table_destroy
@@ -227,32 +320,45 @@ vrd_Seq_table_insert(vrd_Seq_Table* const self,
 {
     assert(NULL != self);
 
-    vrd_Trie_Node* elem = vrd_trie_find(self->trie, len, sequence);
-    if (NULL != elem)
+    uint64_t const hash = fingerprint(len, sequence);
+    struct Slot const* const slot = hash_find(self, hash, len, sequence);
+    if (NULL != slot)
+    {
+        vrd_Trie_Node* const elem = self->sequences[slot->idx];
+        elem->count += 1;  // OVERFLOW
+        return elem;
+    } // if
+
+    size_t idx = vrd_bitmap_first(self->free_slots);
+    if ((size_t) -1 == idx || self->capacity <= idx)
     {
-        if (NULL == vrd_trie_insert(self->trie, len, sequence, elem))
+        int const ret = grow(self, self->capacity + 1);
+        if (0 != ret)
         {
-            errno = -1;
+            errno = ret;
             return NULL;
         } // if
-        return elem;
+        idx = vrd_bitmap_first(self->free_slots);
     } // if
 
-    size_t idx = -1;
-    self->free_list = free_list_alloc(self->free_list, &idx);
-    if ((size_t) -1 == idx)
+    // the trie holds the only copy of the key
+    vrd_Trie_Node* const elem = vrd_trie_insert(self->trie, len, sequence, (void*) idx);
+    if (NULL == elem)
     {
         errno = -1;
         return NULL;
     } // if
 
-    elem = vrd_trie_insert(self->trie, len, sequence, (void*) idx);
-    if (NULL == elem)
+    int const err = hash_insert(self, hash, len, idx);
+    if (0 != err)
     {
-        errno = -1;
+        (void) vrd_trie_remove(self->trie, len, sequence);
+        errno = err;
         return NULL;
     } // if
 
+    vrd_bitmap_clear(self->free_slots, idx);
+    vrd_bitmap_set(self->used_slots, idx);
     self->sequences[idx] = elem;
 
     return elem;
@@ -266,7 +372,13 @@ vrd_Seq_table_query(vrd_Seq_Table const* const self,
 {
     assert(NULL != self);
 
-    return vrd_trie_find(self->trie, len, sequence);
+    struct Slot const* const slot = hash_find(self, fingerprint(len, sequence), len, sequence);
+    if (NULL == slot)
+    {
+        return NULL;
+    } // if
+
+    return self->sequences[slot->idx];
 } // vrd_Seq_table_query
 
 
@@ -277,7 +389,7 @@ vrd_Seq_table_key(vrd_Seq_Table const* const self,
 {
     assert(NULL != self);
 
-    if (self->capacity <= elem)
+    if (!vrd_bitmap_test(self->used_slots, elem))
     {
         return 0;
     } // if
@@ -296,12 +408,28 @@ vrd_Seq_table_remove(vrd_Seq_Table* const self, size_t const elem)
         return -1;
     } // if
 
+    if (!vrd_bitmap_test(self->used_slots, elem))
+    {
+        return 0;
+    } // if
+
+    // only the last reference needs the key
+    if (1 < self->sequences[elem]->count)
+    {
+        self->sequences[elem]->count -= 1;
+        return 0;
+    } // if
+
     char* sequence = NULL;
     size_t const len = vrd_trie_key(self->sequences[elem], &sequence);
 
-    if (vrd_trie_remove(self->trie, len, sequence))
+    // the slot is found while the trie still holds the key
+    struct Slot* const slot = NULL == sequence ? NULL : hash_find(self, fingerprint(len, sequence), len, sequence);
+    if (NULL != slot && vrd_trie_remove(self->trie, len, sequence))
     {
-        self->free_list = free_list_dealloc(self->free_list, elem);
+        slot->idx = DELETED;
+        vrd_bitmap_clear(self->used_slots, elem);
+        vrd_bitmap_set(self->free_slots, elem);
         self->sequences[elem] = NULL;
     } // if
 
@@ -310,6 +438,136 @@ vrd_Seq_table_remove(vrd_Seq_Table* const self, size_t const elem)
 } // vrd_Seq_table_remove
 
 
+size_t
+vrd_Seq_table_compact(vrd_Seq_Table* const self, size_t** const map)
+{
+    assert(NULL != self);
+    assert(NULL != map);
+
+    size_t const size = vrd_bitmap_last(self->used_slots) + 1;
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        count += vrd_bitmap_test(self->used_slots, i);
+    } // for
+
+    *map = malloc(sizeof(**map) * (0 == size ? 1 : size));
+    vrd_Bitmap* free_slots = vrd_bitmap_init(count, false);
+    vrd_Bitmap* used_slots = vrd_bitmap_init(count, true);
+    if (NULL == *map || NULL == free_slots || NULL == used_slots)
+    {
+        free(*map);
+        *map = NULL;
+        vrd_bitmap_destroy(&free_slots);
+        vrd_bitmap_destroy(&used_slots);
+        return -1;
+    } // if
+
+    size_t idx = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (vrd_bitmap_test(self->used_slots, i))
+        {
+            (*map)[i] = idx;
+            self->sequences[idx] = self->sequences[i];
+            self->sequences[idx]->data = (void*) idx;
+            idx += 1;
+        } // if
+        else
+        {
+            (*map)[i] = -1;
+        } // else
+    } // for
+
+    for (size_t i = 0; i < self->hash_size; ++i)
+    {
+        if (EMPTY != self->hash[i].idx && DELETED != self->hash[i].idx)
+        {
+            self->hash[i].idx = (*map)[self->hash[i].idx];
+        } // if
+    } // for
+
+    vrd_bitmap_destroy(&self->free_slots);
+    vrd_bitmap_destroy(&self->used_slots);
+    self->free_slots = free_slots;
+    self->used_slots = used_slots;
+    self->capacity = count;
+
+    // shrinking cannot fail in a way that loses the data
+    vrd_Trie_Node** const sequences = realloc(self->sequences, sizeof(*sequences) * (0 == count ? 1 : count));
+    if (NULL != sequences)
+    {
+        self->sequences = sequences;
+    } // if
+
+    return size;
+} // vrd_Seq_table_compact
+
+
+// Places a sequence at a given index (within the capacity)
+static int
+place(vrd_Seq_Table* const self,
+      size_t const len,
+      char const sequence[len],
+      size_t const idx,
+      size_t const ref_count)
+{
+    // a single insert, the reference count is set directly
+    vrd_Trie_Node* const elem = vrd_trie_insert(self->trie, len, sequence, (void*) idx);
+    if (NULL == elem)
+    {
+        return -1;
+    } // if
+
+    int const err = hash_insert(self, fingerprint(len, sequence), len, idx);
+    if (0 != err)
+    {
+        (void) vrd_trie_remove(self->trie, len, sequence);
+        return err;
+    } // if
+    elem->count = ref_count;
+
+    vrd_bitmap_clear(self->free_slots, idx);
+    vrd_bitmap_set(self->used_slots, idx);
+    self->sequences[idx] = elem;
+
+    return 0;
+} // place
+
+
+vrd_Seq_Table*
+vrd_Seq_table_copy(vrd_Seq_Table const* const self)
+{
+    assert(NULL != self);
+
+    size_t const size = vrd_bitmap_last(self->used_slots) + 1;
+    vrd_Seq_Table* copy = vrd_Seq_table_init(size);
+    if (NULL == copy)
+    {
+        return NULL;
+    } // if
+
+    char* sequence = NULL;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (vrd_bitmap_test(self->used_slots, i))
+        {
+            size_t const len = vrd_trie_key(self->sequences[i], &sequence);
+            if (NULL == sequence || 0 != place(copy, len, sequence, i, self->sequences[i]->count))
+            {
+                free(sequence);
+                vrd_Seq_table_destroy(&copy);
+                return NULL;
+            } // if
+            free(sequence);
+            sequence = NULL;
+        } // if
+    } // for
+
+    return copy;
+} // vrd_Seq_table_copy
+
+
 int
 vrd_Seq_table_read(vrd_Seq_Table* const self,
                    char const* const path)
@@ -337,15 +595,13 @@ vrd_Seq_table_read(vrd_Seq_Table* const self,
         goto error;
     } // for
 
-    if (size > self->capacity)
+    int const ret = grow(self, size);
+    if (0 != ret)
     {
-        errno = -1;
+        errno = ret;
         goto error;
     } // if
 
-    free(self->free_list);
-    self->free_list = NULL;
-
     size_t last_idx = 0;
     while (last_idx < size)
     {
@@ -383,25 +639,18 @@ vrd_Seq_table_read(vrd_Seq_Table* const self,
             goto error;
         } // if
 
-        if (last_idx != idx)
+        if (idx < last_idx || size <= idx || 0 == ref_count)
         {
-            for (size_t i = last_idx; i < idx; ++i)
-            {
-                self->free_list = free_list_dealloc(self->free_list, i);
-            } // for
+            errno = -1;
+            goto error;
         } // if
 
-        for (size_t i = 0; i < ref_count; ++i)
+        int const err = place(self, len, sequence, idx, ref_count);
+        if (0 != err)
         {
-            vrd_Trie_Node* const elem = vrd_trie_insert(self->trie, len, sequence, (void*) idx);
-            if (NULL == elem)
-            {
-                errno = -1;
-                goto error;
-            } // if
-
-            self->sequences[idx] = elem;
-        } // for
+            errno = err;
+            goto error;
+        } // if
 
         free(sequence);
         sequence = NULL;
@@ -409,21 +658,6 @@ vrd_Seq_table_read(vrd_Seq_Table* const self,
         last_idx = idx + 1;
     } // while
 
-    if (NULL == self->free_list)
-    {
-        self->free_list = free_node_init(last_idx, self->capacity, NULL);
-    } // if
-    else
-    {
-        struct Free_Node* tmp = self->free_list;
-        while (NULL != tmp->next)
-        {
-            tmp = tmp->next;
-        } // while
-
-        tmp->next = free_node_init(last_idx, self->capacity, NULL);
-    } // else
-
     if (0 != fclose(stream))
     {
         return errno;
@@ -464,7 +698,7 @@ vrd_Seq_table_write(vrd_Seq_Table const* const self,
         return errno;
     } // if
 
-    size_t const size = free_list_max(self->free_list, self->capacity);
+    size_t const size = vrd_bitmap_last(self->used_slots) + 1;
 
     char* sequence = NULL;
     size_t count = fwrite(&size, sizeof(size), 1, stream);
@@ -475,7 +709,7 @@ vrd_Seq_table_write(vrd_Seq_Table const* const self,
 
     for (size_t i = 0; i < size; ++i)
     {
-        if (NULL != self->sequences[i])
+        if (vrd_bitmap_test(self->used_slots, i))
         {
             size_t const len = vrd_trie_key(self->sequences[i], &sequence);
 
@@ -545,10 +779,10 @@ vrd_Seq_table_diagnostics(vrd_Seq_Table const* const self,
     (*diag)[0].reference = NULL;
     (*diag)[0].height = 0;
     (*diag)[0].entries = 0;
-    size_t const size = free_list_max(self->free_list, self->capacity);
+    size_t const size = vrd_bitmap_last(self->used_slots) + 1;
     for (size_t i = 0; i < size; ++i)
     {
-        if (NULL != self->sequences[i])
+        if (vrd_bitmap_test(self->used_slots, i))
         {
             (*diag)[0].entries += 1;
         } // if
@@ -0,0 +1,333 @@
+#include <assert.h>     // assert
+#include <pthread.h>    // pthread_*
+#include <stdbool.h>    // bool, false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILENAME_MAX, snprintf
+#include <stdlib.h>     // free, malloc
+#include <string.h>     // memcpy, strlen
+
+#include "../include/cov_table.h"   // vrd_Cov_Table, vrd_Cov_table_*
+#include "../include/mnv_table.h"   // vrd_MNV_Table, vrd_MNV_table_*
+#include "../include/seq_table.h"   // vrd_Seq_Table, vrd_Seq_table_*
+#include "../include/snapshot.h"    // vrd_Snapshot, vrd_snapshot_*
+#include "../include/snv_table.h"   // vrd_SNV_Table, vrd_SNV_table_*
+#include "../include/wal.h"         // vrd_WAL, vrd_wal_checkpoint_*
+
+
+// The frozen copies are owned by the snapshot thread; the progress is
+// guarded by the lock
+struct vrd_Snapshot
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+
+    char* path;
+    vrd_SNV_Table* snv;
+    vrd_MNV_Table* mnv;
+    vrd_Seq_Table* seq;
+    vrd_Cov_Table* cov;
+    vrd_WAL* wal;
+
+    vrd_Snapshot_Progress* progress;
+    void* data;
+
+    size_t done;
+    size_t total;
+    bool finished;
+    int error;
+}; // vrd_Snapshot
+
+
+static void
+snapshot_destroy(vrd_Snapshot** const self)
+{
+    vrd_SNV_table_destroy(&(*self)->snv);
+    vrd_MNV_table_destroy(&(*self)->mnv);
+    if (NULL != (*self)->seq)
+    {
+        vrd_Seq_table_destroy(&(*self)->seq);
+    } // if
+    vrd_Cov_table_destroy(&(*self)->cov);
+    free((*self)->path);
+    free(*self);
+    *self = NULL;
+} // snapshot_destroy
+
+
+static int
+filename(char name[FILENAME_MAX], char const* const path, char const* const suffix)
+{
+    if (0 >= snprintf(name, FILENAME_MAX, "%s_%s", path, suffix))
+    {
+        return -1;
+    } // if
+    return 0;
+} // filename
+
+
+// Reports a table written (or the error)
+static void
+step(vrd_Snapshot* const self, int const error)
+{
+    (void) pthread_mutex_lock(&self->lock);
+    if (0 == error)
+    {
+        self->done += 1;
+    } // if
+    self->error = error;
+    size_t const done = self->done;
+    (void) pthread_mutex_unlock(&self->lock);
+
+    if (NULL != self->progress)
+    {
+        self->progress(self->data, done, self->total, error);
+    } // if
+} // step
+
+
+static void*
+work(void* arg)
+{
+    vrd_Snapshot* const self = arg;
+
+    char name[FILENAME_MAX] = {'\0'};
+    int ret = 0;
+
+    if (NULL != self->snv)
+    {
+        ret = filename(name, self->path, "snv");
+        if (0 == ret)
+        {
+            ret = vrd_SNV_table_write_incremental(self->snv, name);
+        } // if
+        vrd_SNV_table_destroy(&self->snv);
+        step(self, ret);
+    } // if
+
+    if (0 == ret && NULL != self->mnv)
+    {
+        ret = filename(name, self->path, "mnv");
+        if (0 == ret)
+        {
+            ret = vrd_MNV_table_write_incremental(self->mnv, name);
+        } // if
+        vrd_MNV_table_destroy(&self->mnv);
+        step(self, ret);
+    } // if
+
+    if (0 == ret && NULL != self->seq)
+    {
+        ret = filename(name, self->path, "seq");
+        if (0 == ret)
+        {
+            ret = vrd_Seq_table_write(self->seq, name);
+        } // if
+        vrd_Seq_table_destroy(&self->seq);
+        step(self, ret);
+    } // if
+
+    if (0 == ret && NULL != self->cov)
+    {
+        ret = filename(name, self->path, "cov");
+        if (0 == ret)
+        {
+            ret = vrd_Cov_table_write_incremental(self->cov, name);
+        } // if
+        vrd_Cov_table_destroy(&self->cov);
+        step(self, ret);
+    } // if
+
+    if (NULL != self->wal)
+    {
+        int const err = vrd_wal_checkpoint_done(self->wal, 0 == ret);
+        if (0 == ret && 0 != err)
+        {
+            step(self, err);
+        } // if
+    } // if
+
+    (void) pthread_mutex_lock(&self->lock);
+    self->finished = true;
+    (void) pthread_mutex_unlock(&self->lock);
+
+    return NULL;
+} // work
+
+
+// Copies the tables (under the checkpoint of the log)
+static int
+freeze(vrd_Snapshot* const self,
+       vrd_SNV_Table const* const snv,
+       vrd_MNV_Table const* const mnv,
+       vrd_Seq_Table const* const seq,
+       vrd_Cov_Table const* const cov)
+{
+    char name[FILENAME_MAX] = {'\0'};
+
+    if (NULL != snv)
+    {
+        if (0 != filename(name, self->path, "snv"))
+        {
+            return -1;
+        } // if
+        self->snv = vrd_SNV_table_freeze(snv, name);
+        if (NULL == self->snv)
+        {
+            return -1;
+        } // if
+        self->total += 1;
+    } // if
+
+    if (NULL != mnv)
+    {
+        if (0 != filename(name, self->path, "mnv"))
+        {
+            return -1;
+        } // if
+        self->mnv = vrd_MNV_table_freeze(mnv, name);
+        if (NULL == self->mnv)
+        {
+            return -1;
+        } // if
+        self->total += 1;
+    } // if
+
+    if (NULL != seq)
+    {
+        self->seq = vrd_Seq_table_copy(seq);
+        if (NULL == self->seq)
+        {
+            return -1;
+        } // if
+        self->total += 1;
+    } // if
+
+    if (NULL != cov)
+    {
+        if (0 != filename(name, self->path, "cov"))
+        {
+            return -1;
+        } // if
+        self->cov = vrd_Cov_table_freeze(cov, name);
+        if (NULL == self->cov)
+        {
+            return -1;
+        } // if
+        self->total += 1;
+    } // if
+
+    return 0;
+} // freeze
+
+
+vrd_Snapshot*
+vrd_snapshot_start(char const* const path,
+                   vrd_SNV_Table const* const snv,
+                   vrd_MNV_Table const* const mnv,
+                   vrd_Seq_Table const* const seq,
+                   vrd_Cov_Table const* const cov,
+                   vrd_WAL* const wal,
+                   vrd_Snapshot_Progress* const progress,
+                   void* const data)
+{
+    assert(NULL != path);
+
+    vrd_Snapshot* self = malloc(sizeof(*self));
+    if (NULL == self)
+    {
+        return NULL;
+    } // if
+
+    *self = (vrd_Snapshot) {.wal = wal, .progress = progress, .data = data};
+
+    self->path = malloc(strlen(path) + 1);
+    if (NULL == self->path)
+    {
+        free(self);
+        return NULL;
+    } // if
+    (void) memcpy(self->path, path, strlen(path) + 1);
+
+    if (0 != pthread_mutex_init(&self->lock, NULL))
+    {
+        snapshot_destroy(&self);
+        return NULL;
+    } // if
+
+    // the updates are held off only during the freeze
+    if (NULL != wal && 0 != vrd_wal_checkpoint_begin(wal))
+    {
+        goto error;
+    } // if
+
+    if (0 != freeze(self, snv, mnv, seq, cov))
+    {
+        if (NULL != wal)
+        {
+            (void) vrd_wal_checkpoint_end(wal, false);
+        } // if
+        goto error;
+    } // if
+
+    if (NULL != wal && 0 != vrd_wal_checkpoint_freeze(wal))
+    {
+        (void) vrd_wal_checkpoint_end(wal, false);
+        goto error;
+    } // if
+
+    if (0 != pthread_create(&self->thread, NULL, work, self))
+    {
+        if (NULL != wal)
+        {
+            (void) vrd_wal_checkpoint_done(wal, false);
+        } // if
+        goto error;
+    } // if
+
+    return self;
+
+error:
+    (void) pthread_mutex_destroy(&self->lock);
+    snapshot_destroy(&self);
+    return NULL;
+} // vrd_snapshot_start
+
+
+bool
+vrd_snapshot_poll(vrd_Snapshot const* const self,
+                  size_t* const done,
+                  size_t* const total)
+{
+    assert(NULL != self);
+
+    (void) pthread_mutex_lock((pthread_mutex_t*) &self->lock);
+    bool const finished = self->finished;
+    if (NULL != done)
+    {
+        *done = self->done;
+    } // if
+    if (NULL != total)
+    {
+        *total = self->total;
+    } // if
+    (void) pthread_mutex_unlock((pthread_mutex_t*) &self->lock);
+
+    return finished;
+} // vrd_snapshot_poll
+
+
+int
+vrd_snapshot_finish(vrd_Snapshot** const self)
+{
+    if (NULL == self || NULL == *self)
+    {
+        return -1;
+    } // if
+
+    (void) pthread_join((*self)->thread, NULL);
+
+    int const error = (*self)->error;
+    (void) pthread_mutex_destroy(&(*self)->lock);
+    snapshot_destroy(self);
+    return error;
+} // vrd_snapshot_finish
@@ -1,18 +1,23 @@
+#define _POSIX_C_SOURCE 200809L
+
+
 #include <assert.h>     // assert
 #include <errno.h>      // errno
 #include <stddef.h>     // NULL, size_t
 #include <stdbool.h>    // bool
-#include <stdlib.h>     // free
+#include <stdlib.h>     // free, malloc
 
 #include "../include/snv_table.h"   // vrd_SNV_Table, vrd_SNV_table_*
 #include "../include/trie.h"        // vrd_Trie_Node, vrd_trie_*
+#include "carriers.h"   // vrd_Carriers, vrd_carriers_*
 #include "snv_tree.h"   // vrd_SNV_Tree, vrd_SNV_tree_*
+#include "wal_log.h"    // vrd_wal_*, vrd_SNV_wal_*
 
 
 #define VRD_TYPENAME SNV
 
 
-#include "template_table.inc"   // tree_from_reference, vrd_SNV_table_*
+#include "template_table.inc"   // reference_*, read_*, update_*, vrd_SNV_table_*
 
 
 int
@@ -27,13 +32,34 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_insert)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* co
 {
     assert(NULL != self);
 
-    VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const tree = tree_from_reference(self, len, reference);
+    vrd_wal_enter(self->wal);
+
+    struct Reference* const ref = reference_from_name(self, len, reference);
+    if (NULL == ref)
+    {
+        int const err = errno;
+        vrd_wal_leave(self->wal);
+        return err;
+    } // if
+
+    VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const tree = update_begin(self, ref);
     if (NULL == tree)
     {
-        return errno;
+        vrd_wal_leave(self->wal);
+        return -1;
+    } // if
+
+    // logged first, so a failure to log leaves the tree as it is
+    int ret = VRD_TEMPLATE(VRD_TYPENAME, _wal_insert)(self->wal, len, reference, position, allele_count, sample_id, phase, inserted);
+    if (0 == ret)
+    {
+        ret = VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(tree, position, allele_count, sample_id, phase, inserted);
+        vrd_wal_done(self->wal, 0 == ret);
     } // if
+    update_end(ref, tree);
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(tree, position, allele_count, sample_id, phase, inserted);
+    vrd_wal_leave(self->wal);
+    return ret;
 } // vrd_SNV_table_insert
 
 
@@ -48,16 +74,137 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query)(VRD_TEMPLATE(VRD_TYPENAME, _Table) cons
 {
     assert(NULL != self);
 
-    vrd_Trie_Node* const elem = vrd_trie_find(self->trie, len, reference);
-    if (NULL == elem)
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
     {
         return -1;
     } // if
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(elem->data, position, inserted, homozygous, subset);
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    size_t ret = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(view.trees[i], position, inserted, homozygous, subset);  // OVERFLOW
+    } // for
+    read_end(self, &view);
+    return ret;
 } // vrd_SNV_table_query
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                  size_t const len,
+                                                  char const reference[len],
+                                                  size_t const position,
+                                                  size_t const inserted,
+                                                  vrd_AVL_Tree const* const subset,
+                                                  size_t* const homozygous,
+                                                  size_t* const carriers)
+{
+    assert(NULL != self);
+
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    // a sample can match in more than one tree of the view
+    vrd_Carriers ids;
+    vrd_carriers_init(&ids);
+    size_t ret = 0;
+    *homozygous = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        size_t tree_homozygous = 0;
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query_zygosity)(view.trees[i], position, inserted, subset, &tree_homozygous, &ids);
+        *homozygous += tree_homozygous;
+    } // for
+    read_end(self, &view);
+
+    *carriers = vrd_carriers_distinct(&ids);
+    vrd_carriers_destroy(&ids);
+    if ((size_t) -1 == *carriers)
+    {
+        return -1;
+    } // if
+    return ret;
+} // vrd_SNV_table_query_zygosity
+
+
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                 size_t const len,
+                                                 char const reference[len],
+                                                 size_t const position,
+                                                 size_t const inserted,
+                                                 vrd_Cohort_Table const* const cohorts,
+                                                 size_t count[])
+{
+    assert(NULL != self);
+
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        VRD_TEMPLATE(VRD_TYPENAME, _tree_query_cohorts)(view.trees[i], position, inserted, cohorts, count);
+    } // for
+    read_end(self, &view);
+
+    return 0;
+} // vrd_SNV_table_query_cohorts
+
+
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_query_spectrum)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                  size_t const len,
+                                                  char const reference[len],
+                                                  size_t const position,
+                                                  vrd_AVL_Tree const* const subset,
+                                                  size_t heterozygous[],
+                                                  size_t homozygous[])
+{
+    assert(NULL != self);
+
+    struct Reference const* const ref = reference_find(self, len, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        return -1;
+    } // if
+    size_t ret = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query_spectrum)(view.trees[i], position, subset, heterozygous, homozygous);  // OVERFLOW
+    } // for
+    read_end(self, &view);
+    return ret;
+} // vrd_SNV_table_query_spectrum
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                 size_t const len_ref,
@@ -66,17 +213,43 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tabl
                                                 size_t const end,
                                                 vrd_AVL_Tree const* const subset,
                                                 size_t const len_res,
-                                                void* result[len_res])
+                                                vrd_SNV_Entry result[len_res])
 {
     assert(NULL != self);
 
-    vrd_Trie_Node* const elem = vrd_trie_find(self->trie, len_ref, reference);
-    if (NULL == elem)
+    struct Reference const* const ref = reference_find(self, len_ref, reference);
+    if (NULL == ref)
+    {
+        return -1;
+    } // if
+
+    void** const nodes = malloc(sizeof(*nodes) * (0 == len_res ? 1 : len_res));
+    if (NULL == nodes)
     {
         return -1;
     } // if
 
-    return VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(elem->data, start, end, subset, len_res, result);
+    struct View view;
+    if (0 != read_begin(self, ref, &view))
+    {
+        free(nodes);
+        return -1;
+    } // if
+    size_t ret = 0;
+    for (size_t i = 0; i < view.count; ++i)
+    {
+        ret += VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(view.trees[i], start, end, subset, len_res - ret, &nodes[ret]);
+    } // for
+
+    // the nodes are only valid while the view is held
+    for (size_t i = 0; i < ret; ++i)
+    {
+        VRD_TEMPLATE(VRD_TYPENAME, _unpack)(nodes[i], &result[i].position, &result[i].allele_count, &result[i].sample_id, &result[i].phase, &result[i].inserted);
+    } // for
+    read_end(self, &view);
+
+    free(nodes);
+    return ret;
 } // vrd_SNV_table_query_region
 
 
@@ -87,15 +260,28 @@ VRD_TEMPLATE(VRD_TYPENAME, _table_export)(VRD_TEMPLATE(VRD_TYPENAME, _Table) con
     assert(NULL != self);
 
     size_t count = 0;
-    for (size_t i = 0; i < self->next; ++i)
+    size_t const next = table_lock_read(self);
+    for (size_t i = 0; i < next; ++i)
     {
         char* reference = NULL;
         size_t const len = vrd_trie_key(self->trees[i], &reference);
 
-        count += VRD_TEMPLATE(VRD_TYPENAME, _tree_export)(self->trees[i]->data, stream, len, reference);  // OVERFLOW
+        struct View view;
+        if (0 != read_begin(self, self->trees[i]->data, &view))
+        {
+            free(reference);
+            count = -1;
+            break;
+        } // if
+        for (size_t j = 0; j < view.count; ++j)
+        {
+            count += VRD_TEMPLATE(VRD_TYPENAME, _tree_export)(view.trees[j], stream, len, reference);  // OVERFLOW
+        } // for
+        read_end(self, &view);
 
         free(reference);
     } // for
+    table_unlock(self);
 
     return count;
 } // vrd_SNV_table_export
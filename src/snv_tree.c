@@ -1,3 +1,6 @@
+#define _POSIX_C_SOURCE 200809L
+
+
 #include <assert.h>     // assert
 #include <stddef.h>     // NULL, size_t
 #include <stdbool.h>    // bool
@@ -5,9 +8,12 @@
 #include <stdio.h>      // FILE, fprintf
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/cohort_table.h"    // vrd_Cohort_Table, vrd_Cohort_table_mask,
+                                        // vrd_cohort_add
 #include "../include/constants.h"   // VRD_HOMOZYGOUS
-#include "../include/iupac.h"       // vrd_idx_to_iupac
+#include "../include/iupac.h"       // vrd_idx_to_iupac, vrd_iupac_match
 #include "../include/template.h"    // VRD_TEMPLATE
+#include "carriers.h"   // vrd_Carriers, vrd_carriers_add
 #include "snv_tree.h"   // vrd_SNV_Tree, vrd_SNV_tree_*
 #include "tree.h"       // NULLPTR, LEFT, RIGHT
 
@@ -30,6 +36,34 @@ struct VRD_TEMPLATE(VRD_TYPENAME, _Node)
 }; // vrd_SNV_Node
 
 
+// The fields of a node stored in a tree file besides the key
+enum
+{
+    PHASE_MASK = (1 << 28) - 1,
+    FIELDS = 4
+}; // fields
+
+
+static inline void
+fields_get(struct VRD_TEMPLATE(VRD_TYPENAME, _Node) const* const node, uint32_t fields[FIELDS])
+{
+    fields[0] = node->count;
+    fields[1] = node->sample_id;
+    fields[2] = (node->phase + 1) & PHASE_MASK;    // homozygous is 0
+    fields[3] = node->inserted;
+} // fields_get
+
+
+static inline void
+fields_set(struct VRD_TEMPLATE(VRD_TYPENAME, _Node)* const node, uint32_t const fields[FIELDS])
+{
+    node->count = fields[0];
+    node->sample_id = fields[1];
+    node->phase = (fields[2] - 1) & PHASE_MASK;
+    node->inserted = fields[3];
+} // fields_set
+
+
 #include "template_tree.inc"    // vrd_SNV_tree_*
 
 
@@ -83,40 +117,49 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_insert)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)* cons
 } // vrd_SNV_tree_insert
 
 
-static size_t
+static void
 query(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
       size_t const root,
       size_t const position,
       size_t const inserted,
-      bool const homozygous,
-      vrd_AVL_Tree const* const subset)
+      vrd_AVL_Tree const* const subset,
+      size_t* const count,
+      size_t* const homozygous,
+      vrd_Carriers* const carriers)
 {
     if (NULLPTR == root)
     {
-        return 0;
+        return;
     } // if
 
     if (self->nodes[root].key > position)
     {
-        return query(self, self->nodes[root].child[LEFT], position, inserted, homozygous, subset);
+        query(self, self->nodes[root].child[LEFT], position, inserted, subset, count, homozygous, carriers);
+        return;
     } // if
 
     if (self->nodes[root].key < position)
     {
-        return query(self, self->nodes[root].child[RIGHT], position, inserted, homozygous, subset);
+        query(self, self->nodes[root].child[RIGHT], position, inserted, subset, count, homozygous, carriers);
+        return;
     } // if
 
-    size_t res = 0;
-    // TODO: IUPAC match on inserted
-    if (inserted == self->nodes[root].inserted &&
-        (!homozygous || (homozygous && self->nodes[root].phase == VRD_HOMOZYGOUS)) &&
+    if (vrd_iupac_match(inserted, self->nodes[root].inserted) &&
         (NULL == subset || vrd_AVL_tree_is_element(subset, self->nodes[root].sample_id)))
     {
-        res = self->nodes[root].count;
+        *count += self->nodes[root].count;
+        if (VRD_HOMOZYGOUS == self->nodes[root].phase)
+        {
+            *homozygous += self->nodes[root].count;
+        } // if
+        if (NULL != carriers)
+        {
+            vrd_carriers_add(carriers, self->nodes[root].sample_id);
+        } // if
     } // if
 
-    return res + query(self, self->nodes[root].child[LEFT], position, inserted, homozygous, subset) +
-                 query(self, self->nodes[root].child[RIGHT], position, inserted, homozygous, subset);
+    query(self, self->nodes[root].child[LEFT], position, inserted, subset, count, homozygous, carriers);
+    query(self, self->nodes[root].child[RIGHT], position, inserted, subset, count, homozygous, carriers);
 } // query
 
 
@@ -129,10 +172,141 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const*
 {
     assert(NULL != self);
 
-    return query(self, self->root, position, inserted, homozygous, subset);
+    size_t count = 0;
+    size_t count_homozygous = 0;
+    query(self, self->root, position, inserted, subset, &count, &count_homozygous, NULL);
+
+    return homozygous ? count_homozygous : count;
 } // vrd_SNV_tree_query
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                 size_t const position,
+                                                 size_t const inserted,
+                                                 vrd_AVL_Tree const* const subset,
+                                                 size_t* const homozygous,
+                                                 vrd_Carriers* const carriers)
+{
+    assert(NULL != self);
+    assert(NULL != homozygous);
+    assert(NULL != carriers);
+
+    size_t count = 0;
+    *homozygous = 0;
+    query(self, self->root, position, inserted, subset, &count, homozygous, carriers);
+
+    return count;
+} // vrd_SNV_tree_query_zygosity
+
+
+static void
+query_cohorts(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+              size_t const root,
+              size_t const position,
+              size_t const inserted,
+              vrd_Cohort_Table const* const cohorts,
+              size_t count[])
+{
+    if (NULLPTR == root)
+    {
+        return;
+    } // if
+
+    if (self->nodes[root].key > position)
+    {
+        query_cohorts(self, self->nodes[root].child[LEFT], position, inserted, cohorts, count);
+        return;
+    } // if
+
+    if (self->nodes[root].key < position)
+    {
+        query_cohorts(self, self->nodes[root].child[RIGHT], position, inserted, cohorts, count);
+        return;
+    } // if
+
+    if (vrd_iupac_match(inserted, self->nodes[root].inserted))
+    {
+        vrd_cohort_add(vrd_Cohort_table_mask(cohorts, self->nodes[root].sample_id), self->nodes[root].count, count);
+    } // if
+
+    query_cohorts(self, self->nodes[root].child[LEFT], position, inserted, cohorts, count);
+    query_cohorts(self, self->nodes[root].child[RIGHT], position, inserted, cohorts, count);
+} // query_cohorts
+
+
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                size_t const position,
+                                                size_t const inserted,
+                                                vrd_Cohort_Table const* const cohorts,
+                                                size_t count[])
+{
+    assert(NULL != self);
+    assert(NULL != cohorts);
+    assert(NULL != count);
+
+    query_cohorts(self, self->root, position, inserted, cohorts, count);
+} // vrd_SNV_tree_query_cohorts
+
+
+static size_t
+query_spectrum(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+               size_t const root,
+               size_t const position,
+               vrd_AVL_Tree const* const subset,
+               size_t heterozygous[],
+               size_t homozygous[])
+{
+    if (NULLPTR == root)
+    {
+        return 0;
+    } // if
+
+    if (self->nodes[root].key > position)
+    {
+        return query_spectrum(self, self->nodes[root].child[LEFT], position, subset, heterozygous, homozygous);
+    } // if
+
+    if (self->nodes[root].key < position)
+    {
+        return query_spectrum(self, self->nodes[root].child[RIGHT], position, subset, heterozygous, homozygous);
+    } // if
+
+    size_t res = 0;
+    if (NULL == subset || vrd_AVL_tree_is_element(subset, self->nodes[root].sample_id))
+    {
+        res = self->nodes[root].count;
+        if (VRD_HOMOZYGOUS == self->nodes[root].phase)
+        {
+            homozygous[self->nodes[root].inserted] += res;
+        } // if
+        else
+        {
+            heterozygous[self->nodes[root].inserted] += res;
+        } // else
+    } // if
+
+    return res + query_spectrum(self, self->nodes[root].child[LEFT], position, subset, heterozygous, homozygous) +
+                 query_spectrum(self, self->nodes[root].child[RIGHT], position, subset, heterozygous, homozygous);
+} // query_spectrum
+
+
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_spectrum)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                 size_t const position,
+                                                 vrd_AVL_Tree const* const subset,
+                                                 size_t heterozygous[],
+                                                 size_t homozygous[])
+{
+    assert(NULL != self);
+    assert(NULL != heterozygous);
+    assert(NULL != homozygous);
+
+    return query_spectrum(self, self->root, position, subset, heterozygous, homozygous);
+} // vrd_SNV_tree_query_spectrum
+
+
 static size_t
 query_region(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
              size_t const root,
@@ -12,7 +12,9 @@ extern "C"
 #include <stdio.h>      // FILE
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/cohort_table.h"    // vrd_Cohort_Table
 #include "../include/template.h"    // VRD_TEMPLATE
+#include "carriers.h"   // vrd_Carriers
 
 
 #define VRD_TYPENAME SNV
@@ -47,6 +49,31 @@ VRD_TEMPLATE(VRD_TYPENAME, _tree_query)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const*
                                         vrd_AVL_Tree const* const subset);
 
 
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_spectrum)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                 size_t const position,
+                                                 vrd_AVL_Tree const* const subset,
+                                                 size_t heterozygous[],
+                                                 size_t homozygous[]);
+
+
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_zygosity)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                 size_t const position,
+                                                 size_t const inserted,
+                                                 vrd_AVL_Tree const* const subset,
+                                                 size_t* const homozygous,
+                                                 vrd_Carriers* const carriers);
+
+
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_query_cohorts)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
+                                                size_t const position,
+                                                size_t const inserted,
+                                                vrd_Cohort_Table const* const cohorts,
+                                                size_t count[]);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_query_region)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                                size_t const start,
@@ -10,6 +10,9 @@
 #include "tree.h"   // vrd_Tree
 
 
+struct vrd_WAL;
+
+
 typedef struct VRD_TEMPLATE(VRD_TYPENAME, _Table) VRD_TEMPLATE(VRD_TYPENAME, _Table);
 
 
@@ -22,30 +25,184 @@ void
 VRD_TEMPLATE(VRD_TYPENAME, _table_destroy)(VRD_TEMPLATE(VRD_TYPENAME, _Table)** const self);
 
 
+/**
+ * Attaches a write-ahead log (or detaches with NULL): the updates of the
+ * table are logged from now on.
+ */
+void
+VRD_TEMPLATE(VRD_TYPENAME, _table_log)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                       struct vrd_WAL* const wal);
+
+
+struct vrd_WAL*
+VRD_TEMPLATE(VRD_TYPENAME, _table_wal)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self);
+
+
+/**
+ * The position in the log up to which the trees read contain the
+ * records, as recorded in the index when written during a checkpoint: a
+ * replay skips the records before it for this table.
+ *
+ * @param offset: the offset in the log, 0 if unknown.
+ * @return The generation of the log.
+ */
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_logged)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                          size_t* const offset);
+
+
+/**
+ * The trees created from now on (new references, trees read) have their
+ * nodes paged from files in `directory` rather than in memory, so the
+ * table can be larger than the physical memory. Queries slow down with
+ * the part of the trees in use instead of failing to allocate. Set
+ * before the table is in use.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_paged)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                         char const* const directory);
+
+
+/**
+ * Inserts go into a buffer of (at most) `entries` per reference rather
+ * than into the tree, so the tree keeps its cache friendly layout. A
+ * full buffer is flushed as an immutable sorted run; queries consult the
+ * tree, the runs and the buffer. The runs are merged with each other as
+ * they are flushed, doubling in size, so a handful holds a few hundred
+ * buffers. They are merged into a new version of the tree by
+ * vrd_*_table_merge(), or else by the insert that finds all runs in use,
+ * which then rebuilds the whole tree: call vrd_*_table_merge() from a
+ * thread of its own (a merge thread) to keep the inserts from paying for
+ * that. Set before the table is in use; 0 (the default) inserts into
+ * the trees directly.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_buffer)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                          size_t const entries);
+
+
+/**
+ * Flushes the buffers and merges the runs into the trees. The merge of
+ * a reference takes its inserts only briefly, so a thread of its own can
+ * merge in the background while the table is updated and queried.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_merge)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self);
+
+
+/**
+ * Removes the entries of the samples in `subset`; the removal is applied
+ * (and logged) per reference.
+ *
+ * @return The number of entries removed or `(size_t) -1` if not all
+ *         references could be updated (or the removal logged); the
+ *         others are.
+ */
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_remove)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
                                           vrd_AVL_Tree const* const subset);
 
 
+/**
+ * As vrd_*_table_remove() for a single reference (as logged).
+ */
+size_t
+VRD_TEMPLATE(VRD_TYPENAME, _table_remove_reference)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                                    size_t const len,
+                                                    char const reference[len],
+                                                    vrd_AVL_Tree const* const subset);
+
+
 int
 VRD_TEMPLATE(VRD_TYPENAME, _table_reorder)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self);
 
 
+/**
+ * Reads the index (`<path>.idx`) and the trees it lists. The trees are
+ * read concurrently by (at most) `threads` threads; they are added to
+ * the table only when all are read. Files of another table type or
+ * format version are refused (EINVAL).
+ */
 int
 VRD_TEMPLATE(VRD_TYPENAME, _table_read)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
-                                        char const* const path);
+                                        char const* const path,
+                                        size_t const threads);
 
 
+/**
+ * Reads the index (`<path>.idx`) only: the tree of a reference is read
+ * on its first use. Trees unchanged since read (or since written to
+ * `path`) are evicted again, least recently used first, while the trees
+ * read take more than `budget` bytes (0 for no limit). The files at `path` must not change while the
+ * table is in use, except by writing this table to `path`.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_read_lazy)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                             char const* const path,
+                                             size_t const budget);
+
+
+/**
+ * Writes the index (`<path>.idx`) and a file per tree
+ * (`<path>_tree_<i>.bin`). Files are written aside and renamed into
+ * place, the index last.
+ */
 int
 VRD_TEMPLATE(VRD_TYPENAME, _table_write)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                          char const* const path);
 
 
+/**
+ * As vrd_*_table_write(), but the trees that did not change since they
+ * were written to `path` by this table (according to the table id and
+ * the generations in its index; a table read from an index continues
+ * its generations) are not written again.
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _table_write_incremental)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                                     char const* const path);
+
+
+/**
+ * A frozen copy of the table for an incremental write to `path` in the
+ * background: only the trees changed since they were written to `path`
+ * are copied, each at a point where no update of it is in progress. The
+ * copy can only be written (vrd_*_table_write_incremental()) and
+ * destroyed.
+ */
+VRD_TEMPLATE(VRD_TYPENAME, _Table)*
+VRD_TEMPLATE(VRD_TYPENAME, _table_freeze)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
+                                          char const* const path);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_diagnostics)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                vrd_Diagnostics** diag);
 
 
+/**
+ * Gives a private copy of the tree for a reference (created if needed)
+ * to update in bulk. Queries keep using the published tree and other
+ * writers of the reference wait until the copy is published by the same
+ * thread with vrd_*_table_publish().
+ */
+struct VRD_TEMPLATE(VRD_TYPENAME, _Tree)*
+VRD_TEMPLATE(VRD_TYPENAME, _table_draft)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                         size_t const len,
+                                         char const reference[len]);
+
+
+/**
+ * Replaces the published tree for a reference by the copy; the old tree
+ * is destroyed as soon as the queries using it are done.
+ */
+void
+VRD_TEMPLATE(VRD_TYPENAME, _table_publish)(VRD_TEMPLATE(VRD_TYPENAME, _Table)* const self,
+                                           size_t const len,
+                                           char const reference[len],
+                                           struct VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const draft);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _table_sample_count)(VRD_TEMPLATE(VRD_TYPENAME, _Table) const* const self,
                                                 size_t count[]);
@@ -12,10 +12,42 @@ VRD_TEMPLATE(VRD_TYPENAME, _Tree)*
 VRD_TEMPLATE(VRD_TYPENAME, _tree_init)(size_t const capacity);
 
 
+/**
+ * A tree with its nodes in a paged file in `directory` (see paged.h);
+ * copies of the tree are paged as well.
+ */
+VRD_TEMPLATE(VRD_TYPENAME, _Tree)*
+VRD_TEMPLATE(VRD_TYPENAME, _tree_init_paged)(size_t const capacity,
+                                             char const* const directory);
+
+
 void
 VRD_TEMPLATE(VRD_TYPENAME, _tree_destroy)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)** const self);
 
 
+/**
+ * A copy with the same capacity (and its own lock).
+ */
+VRD_TEMPLATE(VRD_TYPENAME, _Tree)*
+VRD_TEMPLATE(VRD_TYPENAME, _tree_copy)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self);
+
+
+/**
+ * Each tree has a readers-writer lock; the tree functions do not take
+ * it themselves, the table functions do.
+ */
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_lock_read)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self);
+
+
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_lock_write)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const self);
+
+
+void
+VRD_TEMPLATE(VRD_TYPENAME, _tree_unlock)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self);
+
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_remove)(VRD_TEMPLATE(VRD_TYPENAME, _Tree)* const self,
                                          vrd_AVL_Tree const* const subset);
@@ -34,6 +66,29 @@ int
 VRD_TEMPLATE(VRD_TYPENAME, _tree_write)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                         FILE* stream);
 
+
+/**
+ * A balanced tree (in the cache friendly layout) of the entries of a
+ * number of trees; NULL if they do not fit `capacity`.
+ *
+ * @param directory: for paged nodes, NULL for nodes in memory.
+ */
+VRD_TEMPLATE(VRD_TYPENAME, _Tree)*
+VRD_TEMPLATE(VRD_TYPENAME, _tree_merge)(size_t const count,
+                                        VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const trees[count],
+                                        size_t const capacity,
+                                        char const* const directory);
+
+
+/**
+ * Writes the entries of a number of trees as one tree
+ * (vrd_*_tree_write()).
+ */
+int
+VRD_TEMPLATE(VRD_TYPENAME, _tree_write_merged)(size_t const count,
+                                               VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const trees[count],
+                                               FILE* stream);
+
 size_t
 VRD_TEMPLATE(VRD_TYPENAME, _tree_sample_count)(VRD_TEMPLATE(VRD_TYPENAME, _Tree) const* const self,
                                                size_t count[]);
@@ -1,63 +1,99 @@
 #include <assert.h>     // assert
 #include <stdbool.h>    // bool, false, true
 #include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // uint64_t
 #include <stdlib.h>     // free, malloc, realloc
-#include <string.h>     // strncpy
+#include <string.h>     // memcmp, memcpy, memmove
 
 #include "../include/trie.h"    // vrd_Trie, vrd_trie_*
 
 
+// A node of the radix trie; the children are kept in an array sorted on
+// the first character of their keys, so a child is found by binary
+// search
 struct Node
 {
     vrd_Trie_Node base;
     char* key;
     size_t len;
     struct Node* par;
-    struct Node* link;
-    struct Node* next;
+
+    size_t child_count;
+    size_t child_capacity;
+    struct Node** children;
 }; // Node
 
 
 struct vrd_Trie
 {
-    struct Node* root;
+    struct Node* root;  // sentinel with the empty key
 }; // vrd_Trie
 
 
-vrd_Trie*
-vrd_trie_init(void)
+static struct Node*
+node_init(size_t const len,
+          char const key[len],
+          void* const data,
+          struct Node* const par)
 {
-    vrd_Trie* const trie = malloc(sizeof(*trie));
-    if (trie == NULL)
+    struct Node* const node = malloc(sizeof(*node));
+    if (NULL == node)
     {
         return NULL;
     } // if
 
-    trie->root = NULL;
-    return trie;
-} // vrd_trie_init
+    node->key = malloc(0 == len ? 1 : len);
+    if (NULL == node->key)
+    {
+        free(node);
+        return NULL;
+    } // if
+
+    if (0 < len)
+    {
+        (void) memcpy(node->key, key, len);
+    } // if
+    node->len = len;
+    node->par = par;
+
+    node->child_count = 0;
+    node->child_capacity = 0;
+    node->children = NULL;
+
+    node->base.count = 0;
+    node->base.data = data;
+
+    return node;
+} // node_init
 
 
 static void
 node_destroy(struct Node* const node)
 {
     free(node->key);
+    free(node->children);
     free(node);
 } // node_destroy
 
 
-static void
-trie_destroy(struct Node* const root)
+vrd_Trie*
+vrd_trie_init(void)
 {
-    if (NULL == root)
+    vrd_Trie* const trie = malloc(sizeof(*trie));
+    if (trie == NULL)
     {
-        return;
+        return NULL;
     } // if
 
-    trie_destroy(root->link);
-    trie_destroy(root->next);
-    node_destroy(root);
-} // trie_destroy
+    trie->root = node_init(0, "", NULL, NULL);
+    if (NULL == trie->root)
+    {
+        free(trie);
+        return NULL;
+    } // if
+
+    return trie;
+} // vrd_trie_init
 
 
 void
@@ -68,252 +104,231 @@ vrd_trie_destroy(vrd_Trie** const self)
         return;
     } // if
 
-    trie_destroy((*self)->root);
-    free(*self);
-    *self = NULL;
-} // vrd_trie_destroy
-
-
-static struct Node*
-node_init(size_t const len,
-          char const key[len],
-          void* const data)
-{
-    struct Node* const node = malloc(sizeof(*node));
-    if (NULL == node)
-    {
-        return NULL;
-    } // if
-
-    node->key = malloc(len);
-    if (NULL == node->key)
+    // post-order without recursion: detach the children while descending
+    struct Node* node = (*self)->root;
+    while (NULL != node)
     {
-        free(node);
-        return NULL;
-    } // if
-
-    (void) strncpy(node->key, key, len);
-    node->len = len;
-    node->par = NULL;
-    node->link = NULL;
-    node->next = NULL;
+        if (0 < node->child_count)
+        {
+            node->child_count -= 1;
+            node = node->children[node->child_count];
+            continue;
+        } // if
 
-    node->base.count = 0;
-    node->base.data = data;
+        struct Node* const par = node->par;
+        node_destroy(node);
+        node = par;
+    } // while
 
-    return node;
-} // node_init
+    free(*self);
+    *self = NULL;
+} // vrd_trie_destroy
 
 
+// Length of the common prefix, compared a word at a time
 static inline size_t
 prefix(size_t const len_a,
        char const str_a[len_a],
        size_t const len_b,
        char const str_b[len_b])
 {
-    for (size_t i = 0; i < len_a; ++i)
+    size_t const len = len_a < len_b ? len_a : len_b;
+
+    size_t i = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+    {
+        uint64_t word_a = 0;
+        uint64_t word_b = 0;
+        (void) memcpy(&word_a, &str_a[i], sizeof(word_a));
+        (void) memcpy(&word_b, &str_b[i], sizeof(word_b));
+        uint64_t const diff = word_a ^ word_b;
+        if (0 != diff)
+        {
+            return i + __builtin_ctzll(diff) / 8;
+        } // if
+    } // for
+#endif
+
+    for (; i < len; ++i)
     {
-        if (i >= len_b || str_a[i] != str_b[i])
+        if (str_a[i] != str_b[i])
         {
             return i;
         } // if
     } // for
-    return len_a;
+    return len;
 } // prefix
 
 
-static struct Node*
-node_split(struct Node* const node, size_t const k)
+// Returns the position of the child starting with `first`, or the
+// position where it should be inserted
+static size_t
+child_search(struct Node const* const node,
+             unsigned char const first,
+             bool* const found)
 {
-    struct Node* const split = node_init(k, node->key, NULL);
-    if (NULL == split)
+    size_t low = 0;
+    size_t high = node->child_count;
+    while (low < high)
     {
-        return NULL;
-    } // if
-
-    char* const key = malloc(node->len - k);
-    if (NULL == key)
-    {
-        free(node);
-        return NULL;
-    } // if
-
-    (void) strncpy(key, &node->key[k], node->len - k);
-    free(node->key);
-    node->key = key;
-    node->len -= k;
+        size_t const mid = low + (high - low) / 2;
+        unsigned char const key = node->children[mid]->key[0];
+        if (key == first)
+        {
+            *found = true;
+            return mid;
+        } // if
+        if (key < first)
+        {
+            low = mid + 1;
+        } // if
+        else
+        {
+            high = mid;
+        } // else
+    } // while
 
-    split->par = node->par;
-    split->link = node;
-    split->next = node->next;
-    node->par = split;
-    node->next = NULL;
+    *found = false;
+    return low;
+} // child_search
 
-    return split;
-} // node_split
 
-
-static struct Node*
-trie_insert(struct Node* const root,
-            size_t const len,
-            char const key[len],
-            void* const data)
+static bool
+child_insert(struct Node* const node,
+             size_t const pos,
+             struct Node* const child)
 {
-    if (NULL == root)
+    if (node->child_capacity <= node->child_count)
     {
-        struct Node* const node = node_init(len, key, data);
-        if (NULL == node)
+        size_t const capacity = 0 == node->child_capacity ? 2 : node->child_capacity * 2;
+        struct Node** const children = realloc(node->children, sizeof(*children) * capacity);
+        if (NULL == children)
         {
-            return NULL;
+            return false;
         } // if
-
-        node->base.count = 1;
-        return node;
+        node->children = children;
+        node->child_capacity = capacity;
     } // if
 
-    size_t const k = prefix(len, key, root->len, root->key);
-    if (0 == k)
-    {
-        struct Node* const node = trie_insert(root->next, len, key, data);
-        if (NULL == node)
-        {
-            return NULL;
-        } // if
+    (void) memmove(&node->children[pos + 1], &node->children[pos], sizeof(node->children[0]) * (node->child_count - pos));
+    node->children[pos] = child;
+    node->child_count += 1;
 
-        node->par = root->par;
+    return true;
+} // child_insert
+
+
+static void
+child_erase(struct Node* const node, size_t const pos)
+{
+    node->child_count -= 1;
+    (void) memmove(&node->children[pos], &node->children[pos + 1], sizeof(node->children[0]) * (node->child_count - pos));
+} // child_erase
 
-        root->next = node;
-        return root;
-    } // if
 
-    if (len == k)
+// Splits the child at `pos` after `k` characters; the new intermediate
+// node takes its place, the child keeps its identity (and data)
+static struct Node*
+node_split(struct Node* const node,
+           size_t const pos,
+           size_t const k)
+{
+    struct Node* const child = node->children[pos];
+
+    struct Node* const split = node_init(k, child->key, NULL, node);
+    if (NULL == split)
     {
-        root->base.count += 1;  // OVERFLOW
-        return root;
+        return NULL;
     } // if
 
-    struct Node* sub = root;
-    if (root->len > k)
+    char* const key = malloc(child->len - k);
+    if (NULL == key)
     {
-        struct Node* const node = node_split(root, k);
-        if (NULL == node)
-        {
-            return NULL;
-        } // if
-        sub = node;
+        node_destroy(split);
+        return NULL;
     } // if
 
-    struct Node* const node = trie_insert(sub->link, len - k, &key[k], data);
-    if (NULL == node)
+    if (!child_insert(split, 0, child))
     {
+        free(key);
+        node_destroy(split);
         return NULL;
     } // if
-    node->par = sub;
 
-    sub->link = node;
-    return sub;
-} // trie_insert
+    (void) memcpy(key, &child->key[k], child->len - k);
+    free(child->key);
+    child->key = key;
+    child->len -= k;
+    child->par = split;
 
+    node->children[pos] = split;
 
-static struct Node*
+    return split;
+} // node_split
+
+
+// Merges a node without data and with a single child into that child;
+// the child keeps its identity
+static void
 node_join(struct Node* const node)
 {
-    struct Node* const join = node->link;
+    assert(1 == node->child_count);
+    assert(NULL != node->par);
+
+    struct Node* const join = node->children[0];
 
     char* const key = malloc(node->len + join->len);
     if (NULL == key)
     {
-        return NULL;
+        return;  // the trie remains valid, only less compact
     } // if
 
-    (void) strncpy(key, node->key, node->len);
-    (void) strncpy(&key[node->len], join->key, join->len);
+    (void) memcpy(key, node->key, node->len);
+    (void) memcpy(&key[node->len], join->key, join->len);
     free(join->key);
-
-    join->par = node->par;
-    join->next = node->next;
     join->key = key;
     join->len += node->len;
 
-    node_destroy(node);
+    struct Node* const par = node->par;
+    bool found = false;
+    size_t const pos = child_search(par, node->key[0], &found);
+    assert(found);
 
-    return join;
+    par->children[pos] = join;
+    join->par = par;
+
+    node_destroy(node);
 } // node_join
 
 
-struct Node*
-trie_remove(struct Node* const root,
-            size_t const len,
-            char const key[len],
-            bool* const deleted)
+static struct Node*
+trie_find(struct Node* const root,
+          size_t const len,
+          char const key[len])
 {
-    if (NULL == root)
-    {
-        return NULL;
-    } // if
-
-    size_t const k = prefix(len, key, root->len, root->key);
-    if (0 == k)
+    struct Node* node = root;
+    size_t pos = 0;
+    while (pos < len)
     {
-        root->next = trie_remove(root->next, len, key, deleted);
-        return root;
-    } // if
-
-    if (len == k)
-    {
-        root->base.count -= 1;  // UNDERFLOW
-        if (0 == root->base.count)
+        bool found = false;
+        size_t const idx = child_search(node, key[pos], &found);
+        if (!found)
         {
-            *deleted = true;
-            struct Node* const node = root->next;
-            node_destroy(root);
-            return node;
+            return NULL;
         } // if
-        return root;
-    } // if
 
-    if (root->len == k)
-    {
-        root->link = trie_remove(root->link, len - k, &key[k], deleted);
-        if (NULL != root->link && NULL == root->link->next)
+        struct Node* const child = node->children[idx];
+        if (child->len > len - pos || child->len != prefix(len - pos, &key[pos], child->len, child->key))
         {
-            struct Node* const node = node_join(root);
-            if (NULL == node)
-            {
-                return NULL;
-            } // if
-            return node;
+            return NULL;
         } // if
-    } // if
-
-    return root;
-} // trie_remove
 
+        node = child;
+        pos += child->len;
+    } // while
 
-struct Node*
-trie_find(struct Node* const root,
-          size_t const len,
-          char const key[len])
-{
-    if (NULL == root)
-    {
-        return NULL;
-    } // if
-
-    size_t const k = prefix(len, key, root->len, root->key);
-    if (0 == k)
-    {
-        return trie_find(root->next, len, key);
-    } // if
-    if (len == k)
-    {
-        return root;
-    } // if
-    if (root->len == k)
-    {
-        return trie_find(root->link, len - k, &key[k]);
-    } // if
-    return NULL;
+    return node;
 } // trie_find
 
 
@@ -325,8 +340,52 @@ vrd_trie_insert(vrd_Trie* const self,
 {
     assert(NULL != self);
 
-    self->root = trie_insert(self->root, len, key, data);
-    return (vrd_Trie_Node*) trie_find(self->root, len, key);
+    struct Node* node = self->root;
+    size_t pos = 0;
+    while (pos < len)
+    {
+        bool found = false;
+        size_t const idx = child_search(node, key[pos], &found);
+        if (!found)
+        {
+            struct Node* const leaf = node_init(len - pos, &key[pos], data, node);
+            if (NULL == leaf)
+            {
+                return NULL;
+            } // if
+
+            if (!child_insert(node, idx, leaf))
+            {
+                node_destroy(leaf);
+                return NULL;
+            } // if
+
+            leaf->base.count = 1;
+            return (vrd_Trie_Node*) leaf;
+        } // if
+
+        struct Node* child = node->children[idx];
+        size_t const k = prefix(len - pos, &key[pos], child->len, child->key);
+        if (k < child->len)
+        {
+            child = node_split(node, idx, k);
+            if (NULL == child)
+            {
+                return NULL;
+            } // if
+        } // if
+
+        node = child;
+        pos += k;
+    } // while
+
+    if (0 == node->base.count)
+    {
+        node->base.data = data;
+    } // if
+    node->base.count += 1;  // OVERFLOW
+
+    return (vrd_Trie_Node*) node;
 } // vrd_trie_insert
 
 
@@ -337,9 +396,42 @@ vrd_trie_remove(vrd_Trie* const self,
 {
     assert(NULL != self);
 
-    bool deleted = false;
-    self->root = trie_remove(self->root, len, key, &deleted);
-    return deleted;
+    struct Node* node = trie_find(self->root, len, key);
+    if (NULL == node || 0 == node->base.count)
+    {
+        return false;
+    } // if
+
+    node->base.count -= 1;
+    if (0 < node->base.count)
+    {
+        return false;
+    } // if
+
+    node->base.data = NULL;
+    if (self->root == node)
+    {
+        return true;
+    } // if
+
+    if (0 == node->child_count)
+    {
+        struct Node* const par = node->par;
+        bool found = false;
+        size_t const pos = child_search(par, node->key[0], &found);
+        assert(found);
+        child_erase(par, pos);
+        node_destroy(node);
+
+        node = par;
+    } // if
+
+    if (self->root != node && 0 == node->base.count && 1 == node->child_count)
+    {
+        node_join(node);
+    } // if
+
+    return true;
 } // vrd_trie_remove
 
 
@@ -354,40 +446,54 @@ vrd_trie_find(vrd_Trie const* const self,
 } // vrd_trie_find
 
 
-static size_t
-trie_key(struct Node const* const node, char** key)
-{
-    if (NULL == node)
-    {
-        return 0;
-    } // if
-
-    size_t const len = trie_key(node->par, key);
-    void* const ret = realloc(*key, len + node->len);
-    if (NULL == ret)
-    {
-        free(*key);
-        return 0;
-    } // if
-    *key = ret;
-    (void) strncpy(&(*key)[len], node->key, node->len);
-
-    return len + node->len;
-} // trie_key
-
-
 size_t
 vrd_trie_key(vrd_Trie_Node const* const ptr, char** key)
 {
-    size_t const len = trie_key((struct Node*) ptr, key);
+    size_t len = 0;
+    for (struct Node const* node = (struct Node const*) ptr; NULL != node; node = node->par)
+    {
+        len += node->len;
+    } // for
+
     void* const ret = realloc(*key, len + 1);
     if (NULL == ret)
     {
         free(*key);
+        *key = NULL;
         return 0;
     } // if
     *key = ret;
     (*key)[len] = '\0';
 
+    size_t end = len;
+    for (struct Node const* node = (struct Node const*) ptr; NULL != node; node = node->par)
+    {
+        end -= node->len;
+        (void) memcpy(&(*key)[end], node->key, node->len);
+    } // for
+
     return len;
 } // vrd_trie_key
+
+
+// Compares the key of a node from its end upwards, without copying it
+bool
+vrd_trie_key_equal(vrd_Trie_Node const* const ptr,
+                   size_t const len,
+                   char const key[len])
+{
+    size_t end = len;
+    for (struct Node const* node = (struct Node const*) ptr; NULL != node; node = node->par)
+    {
+        if (end < node->len)
+        {
+            return false;
+        } // if
+        end -= node->len;
+        if (0 < node->len && 0 != memcmp(&key[end], node->key, node->len))
+        {
+            return false;
+        } // if
+    } // for
+    return 0 == end;
+} // vrd_trie_key_equal
@@ -1,10 +1,13 @@
 #include <assert.h>     // assert
 #include <stddef.h>     // NULL, size_t
-#include <stdbool.h>    // false
-#include <stdio.h>      // FILE, fprintf, fscanf
+#include <stdbool.h>    // bool
+#include <stdio.h>      // FILE, fprintf, fputc, fscanf
+#include <stdlib.h>     // free, malloc
 #include <string.h>     // strlen
 
 #include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/cohort_table.h"    // vrd_Cohort_Table,
+                                        // vrd_Cohort_table_count
 #include "../include/constants.h"   // VRD_HOMOZYGOUS
 #include "../include/cov_table.h"   // vrd_Cov_Table, vrd_Cov_table_*
 #include "../include/iupac.h"       // vrd_iupac_to_idx
@@ -14,7 +17,8 @@
 #include "../include/trie.h"        // vrd_Trie_Node
 #include "../include/utils.h"       // vrd_coverage_from_file,
                                     // vrd_variants_from_file,
-                                    // vrd_annotate_from_file
+                                    // vrd_annotate_from_file,
+                                    // vrd_annotate_cohorts_from_file
 
 
 size_t
@@ -147,7 +151,8 @@ vrd_annotate_from_file(FILE* ostream,
                        vrd_SNV_Table const* const snv,
                        vrd_MNV_Table const* const mnv,
                        vrd_Seq_Table const* const seq,
-                       vrd_AVL_Tree const* const subset)
+                       vrd_AVL_Tree const* const subset,
+                       bool const zygosity)
 {
     assert(NULL != ostream);
     assert(NULL != istream);
@@ -173,9 +178,11 @@ vrd_annotate_from_file(FILE* ostream,
         } // if
 
         size_t num = 0;
+        size_t homozygous = 0;
+        size_t carriers = 0;
         if (1 == len && inserted[0] != '.' && 1 == end - start)
         {
-            num = vrd_SNV_table_query(snv, strlen(reference) + 1, reference, start, vrd_iupac_to_idx(inserted[0]), false, subset);
+            num = vrd_SNV_table_query_zygosity(snv, strlen(reference) + 1, reference, start, vrd_iupac_to_idx(inserted[0]), subset, &homozygous, &carriers);
         } // if
         else
         {
@@ -191,16 +198,106 @@ vrd_annotate_from_file(FILE* ostream,
             } // if
             else
             {
-                num = vrd_MNV_table_query(mnv, strlen(reference) + 1, reference, start, end, *(size_t*) elem, false, subset);
+                num = vrd_MNV_table_query_zygosity(mnv, strlen(reference) + 1, reference, start, end, *(size_t*) elem, subset, &homozygous, &carriers);
             } // else
         } // else
 
         size_t const den = vrd_Cov_table_query_stab(cov, strlen(reference) + 1, reference, start, end, subset);
 
-        (void) fprintf(ostream, "%s\t%zu\t%zu\t%s\t%zu:%zu\n", reference, start, end, len == 0 ? "." : inserted, num, den);  // UNCHECKED
+        if (zygosity)
+        {
+            (void) fprintf(ostream, "%s\t%zu\t%zu\t%s\t%zu:%zu:%zu:%zu\n", reference, start, end, len == 0 ? "." : inserted, num, homozygous, carriers, den);  // UNCHECKED
+        } // if
+        else
+        {
+            (void) fprintf(ostream, "%s\t%zu\t%zu\t%s\t%zu:%zu\n", reference, start, end, len == 0 ? "." : inserted, num, den);  // UNCHECKED
+        } // else
 
         line_count += 1;  // OVERFLOW
     } // while
 
     return line_count;
 } // vrd_annotate_from_file
+
+
+size_t
+vrd_annotate_cohorts_from_file(FILE* ostream,
+                               FILE* istream,
+                               vrd_Cov_Table const* const cov,
+                               vrd_SNV_Table const* const snv,
+                               vrd_MNV_Table const* const mnv,
+                               vrd_Seq_Table const* const seq,
+                               vrd_Cohort_Table const* const cohorts)
+{
+    assert(NULL != ostream);
+    assert(NULL != istream);
+    assert(NULL != cov);
+    assert(NULL != snv);
+    assert(NULL != mnv);
+    assert(NULL != seq);
+    assert(NULL != cohorts);
+
+    size_t const cohort_count = vrd_Cohort_table_count(cohorts);
+    size_t* const num = malloc(2 * sizeof(*num) * (cohort_count + 1));
+    if (NULL == num)
+    {
+        return 0;
+    } // if
+    size_t* const den = &num[cohort_count + 1];
+
+    char reference[128] = {'\0'};
+    size_t start = 0;
+    size_t end = 0;
+    size_t allele_count = 0;
+    size_t phase = 0;
+    size_t len = 0;
+    char inserted[1024] = {'\0'};
+
+    size_t line_count = 0;
+    while (7 == fscanf(istream, "%127s %zu %zu %zu %zu %zu %1023s", reference, &start, &end, &allele_count, &phase, &len, inserted))  // UNSAFE
+    {
+        if (1023 < len)
+        {
+            break;
+        } // if
+
+        for (size_t i = 0; i < cohort_count; ++i)
+        {
+            num[i] = 0;
+            den[i] = 0;
+        } // for
+
+        if (1 == len && inserted[0] != '.' && 1 == end - start)
+        {
+            (void) vrd_SNV_table_query_cohorts(snv, strlen(reference) + 1, reference, start, vrd_iupac_to_idx(inserted[0]), cohorts, num);
+        } // if
+        else
+        {
+            if (0 == len)
+            {
+                inserted[0] = '\0';
+            } // if
+
+            vrd_Trie_Node* const elem = vrd_Seq_table_query(seq, len + 1, inserted);
+            if (NULL != elem)
+            {
+                (void) vrd_MNV_table_query_cohorts(mnv, strlen(reference) + 1, reference, start, end, *(size_t*) elem, cohorts, num);
+            } // if
+        } // else
+
+        (void) vrd_Cov_table_query_stab_cohorts(cov, strlen(reference) + 1, reference, start, end, cohorts, den);
+
+        (void) fprintf(ostream, "%s\t%zu\t%zu\t%s", reference, start, end, len == 0 ? "." : inserted);  // UNCHECKED
+        for (size_t i = 0; i < cohort_count; ++i)
+        {
+            (void) fprintf(ostream, "\t%zu:%zu", num[i], den[i]);  // UNCHECKED
+        } // for
+        (void) fputc('\n', ostream);  // UNCHECKED
+
+        line_count += 1;  // OVERFLOW
+    } // while
+
+    free(num);
+
+    return line_count;
+} // vrd_annotate_cohorts_from_file
@@ -0,0 +1,522 @@
+#define _POSIX_C_SOURCE 200809L
+
+
+#include <assert.h>     // assert
+#include <ctype.h>      // toupper
+#include <stdbool.h>    // bool, false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILE, getline
+#include <stdlib.h>     // free
+#include <string.h>     // memcpy, strchr, strcmp, strcspn, strlen,
+                        // strncmp
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/constants.h"   // VRD_HOMOZYGOUS
+#include "../include/cov_table.h"   // vrd_Cov_Table, vrd_Cov_table_*
+#include "../include/iupac.h"       // vrd_iupac_to_idx
+#include "../include/mnv_table.h"   // vrd_MNV_Table, vrd_MNV_table_*
+#include "../include/seq_table.h"   // vrd_Seq_Table, vrd_Seq_table_*
+#include "../include/snv_table.h"   // vrd_SNV_Table, vrd_SNV_table_*
+#include "../include/trie.h"        // vrd_Trie_Node
+#include "../include/vcf.h"         // vrd_variants_from_vcf,
+                                    // vrd_coverage_from_gvcf
+
+
+enum
+{
+    CHROM, POS, ID, REF, ALT, QUAL, FILTER, INFO, FORMAT, SAMPLE,
+    FIELDS
+}; // fields
+
+
+enum
+{
+    MAX_PLOIDY = 8,
+    MAX_REFERENCE = 128
+}; // limits
+
+
+static long const MISSING = -1;
+static long const CALLED = -2;  // any called allele for record_count()
+
+
+struct Record
+{
+    char* field[FIELDS];
+    size_t position;    // 1-based
+
+    size_t ploidy;
+    long allele[MAX_PLOIDY];    // MISSING for `.`
+    bool phased;
+    bool phase_set;
+    size_t ps;
+}; // Record
+
+
+static bool
+parse_number(size_t const len, char const str[len], size_t* const value)
+{
+    if (0 == len)
+    {
+        return false;
+    } // if
+
+    *value = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        if ('0' > str[i] || '9' < str[i])
+        {
+            return false;
+        } // if
+        *value = *value * 10 + (str[i] - '0');  // OVERFLOW
+    } // for
+    return true;
+} // parse_number
+
+
+// Finds the value for `key` in the colon separated FORMAT and sample
+// fields; the value is not terminated
+static char const*
+format_value(char const* format,
+             char const* sample,
+             char const* const key,
+             size_t* const len)
+{
+    size_t const len_key = strlen(key);
+    while (NULL != format && NULL != sample)
+    {
+        char const* const format_end = strchr(format, ':');
+        char const* sample_end = strchr(sample, ':');
+        if (NULL == sample_end)
+        {
+            sample_end = sample + strlen(sample);
+        } // if
+
+        size_t const len_format = NULL == format_end ? strlen(format) : (size_t) (format_end - format);
+        if (len_key == len_format && 0 == strncmp(format, key, len_key))
+        {
+            *len = sample_end - sample;
+            return sample;
+        } // if
+
+        format = NULL == format_end ? NULL : format_end + 1;
+        sample = '\0' == *sample_end ? NULL : sample_end + 1;
+    } // while
+    return NULL;
+} // format_value
+
+
+// Splits a data line and parses the genotype of the first sample;
+// returns false for a malformed record
+static bool
+parse(char* line, struct Record* const record)
+{
+    line[strcspn(line, "\r\n")] = '\0';
+
+    for (size_t i = 0; i < FIELDS; ++i)
+    {
+        record->field[i] = line;
+        line = strchr(line, '\t');
+        if (NULL == line && FIELDS - 1 > i)
+        {
+            return false;
+        } // if
+        if (NULL != line)
+        {
+            *line = '\0';
+            line += 1;
+        } // if
+    } // for
+
+    if (!parse_number(strlen(record->field[POS]), record->field[POS], &record->position) || 0 == record->position ||
+        MAX_REFERENCE <= strlen(record->field[CHROM]))
+    {
+        return false;
+    } // if
+
+    for (char* ch = record->field[REF]; '\0' != *ch; ++ch)
+    {
+        *ch = toupper((unsigned char) *ch);
+    } // for
+    for (char* ch = record->field[ALT]; '\0' != *ch; ++ch)
+    {
+        *ch = toupper((unsigned char) *ch);
+    } // for
+
+    record->ploidy = 0;
+    record->phased = false;
+    record->phase_set = false;
+
+    size_t len = 0;
+    char const* const gt = format_value(record->field[FORMAT], record->field[SAMPLE], "GT", &len);
+    if (NULL == gt)
+    {
+        return true;  // no genotype: nothing to insert
+    } // if
+
+    size_t i = 0;
+    while (i < len)
+    {
+        if (MAX_PLOIDY <= record->ploidy)
+        {
+            return false;
+        } // if
+
+        size_t end = i;
+        while (end < len && '/' != gt[end] && '|' != gt[end])
+        {
+            end += 1;
+        } // while
+
+        size_t allele = 0;
+        if (1 == end - i && '.' == gt[i])
+        {
+            record->allele[record->ploidy] = MISSING;
+        } // if
+        else if (parse_number(end - i, &gt[i], &allele))
+        {
+            record->allele[record->ploidy] = allele;
+        } // if
+        else
+        {
+            return false;
+        } // else
+        record->ploidy += 1;
+
+        if (end < len && '|' == gt[end])
+        {
+            record->phased = true;
+        } // if
+        i = end + 1;
+    } // while
+
+    char const* const ps = format_value(record->field[FORMAT], record->field[SAMPLE], "PS", &len);
+    if (NULL != ps && !(1 == len && '.' == ps[0]))
+    {
+        if (!parse_number(len, ps, &record->ps))
+        {
+            return false;
+        } // if
+        record->phase_set = true;
+    } // if
+
+    return true;
+} // parse
+
+
+static size_t
+record_phase(struct Record const* const record)
+{
+    bool homozygous = 0 < record->ploidy;
+    for (size_t i = 0; i < record->ploidy; ++i)
+    {
+        if (MISSING == record->allele[i] || record->allele[0] != record->allele[i])
+        {
+            homozygous = false;
+        } // if
+    } // for
+
+    if (homozygous)
+    {
+        return VRD_HOMOZYGOUS;
+    } // if
+    if (record->phased)
+    {
+        return record->phase_set ? record->ps % VRD_HOMOZYGOUS : 0;
+    } // if
+    return record->position % VRD_HOMOZYGOUS;
+} // record_phase
+
+
+static size_t
+record_count(struct Record const* const record, long const allele)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < record->ploidy; ++i)
+    {
+        if (allele == record->allele[i] || (CALLED == allele && MISSING != record->allele[i]))
+        {
+            count += 1;
+        } // if
+    } // for
+    return count;
+} // record_count
+
+
+static bool
+symbolic(size_t const len, char const alt[len])
+{
+    if (0 == len || '<' == alt[0] || '*' == alt[0] || '.' == alt[0])
+    {
+        return true;
+    } // if
+    for (size_t i = 0; i < len; ++i)
+    {
+        if ('[' == alt[i] || ']' == alt[i])
+        {
+            return true;
+        } // if
+    } // for
+    return false;
+} // symbolic
+
+
+static int
+insert_variant(struct Record const* const record,
+               size_t len_alt,
+               char alt[len_alt],
+               size_t const allele_count,
+               size_t const phase,
+               vrd_SNV_Table* const snv,
+               vrd_MNV_Table* const mnv,
+               vrd_Seq_Table* const seq,
+               size_t const sample_id)
+{
+    char const* const ref = record->field[REF];
+    size_t len_ref = strlen(ref);
+
+    while (0 < len_ref && 0 < len_alt && ref[len_ref - 1] == alt[len_alt - 1])
+    {
+        len_ref -= 1;
+        len_alt -= 1;
+    } // while
+
+    size_t prefix = 0;
+    while (prefix < len_ref && prefix < len_alt && ref[prefix] == alt[prefix])
+    {
+        prefix += 1;
+    } // while
+
+    if (len_ref == prefix && len_alt == prefix)
+    {
+        return 0;  // not a variant
+    } // if
+
+    char const* const reference = record->field[CHROM];
+    size_t const start = record->position - 1 + prefix;
+    size_t const end = record->position - 1 + len_ref;
+    size_t const len = len_alt - prefix;
+    char* const inserted = &alt[prefix];
+
+    if (1 == len && 1 == end - start)
+    {
+        return vrd_SNV_table_insert(snv, strlen(reference) + 1, reference, start, allele_count, sample_id, phase, vrd_iupac_to_idx(inserted[0]));
+    } // if
+
+    char const save = inserted[len];
+    inserted[len] = '\0';
+    vrd_Trie_Node* const elem = vrd_Seq_table_insert(seq, len + 1, inserted);
+    inserted[len] = save;
+    if (NULL == elem)
+    {
+        return -1;
+    } // if
+
+    return vrd_MNV_table_insert(mnv, strlen(reference) + 1, reference, start, end, allele_count, sample_id, phase, (size_t) elem->data);
+} // insert_variant
+
+
+size_t
+vrd_variants_from_vcf(FILE* stream,
+                      vrd_SNV_Table* const snv,
+                      vrd_MNV_Table* const mnv,
+                      vrd_Seq_Table* const seq,
+                      size_t const sample_id)
+{
+    assert(NULL != stream);
+    assert(NULL != snv);
+    assert(NULL != mnv);
+    assert(NULL != seq);
+
+    char* line = NULL;
+    size_t capacity = 0;
+
+    struct Record record;
+
+    size_t count = 0;
+    while (-1 != getline(&line, &capacity, stream))
+    {
+        if ('#' == line[0])
+        {
+            continue;
+        } // if
+
+        if (!parse(line, &record))
+        {
+            break;
+        } // if
+
+        size_t const phase = record_phase(&record);
+
+        char* alt = record.field[ALT];
+        for (long allele = 1; '\0' != *alt; ++allele)
+        {
+            size_t const len_alt = strcspn(alt, ",");
+            size_t const allele_count = record_count(&record, allele);
+            if (0 < allele_count && !symbolic(len_alt, alt))
+            {
+                if (0 != insert_variant(&record, len_alt, alt, allele_count, phase, snv, mnv, seq, sample_id))
+                {
+                    goto error;
+                } // if
+                count += 1;  // OVERFLOW
+            } // if
+
+            alt += len_alt;
+            if (',' == *alt)
+            {
+                alt += 1;
+            } // if
+        } // for
+    } // while
+
+    free(line);
+    return count;
+
+error:
+    free(line);
+    {
+        vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+        if (NULL == subset)
+        {
+            return count;
+        } // if
+        if (0 != vrd_AVL_tree_insert(subset, sample_id))
+        {
+            vrd_AVL_tree_destroy(&subset);
+            return count;
+        } // if
+
+        count -= vrd_SNV_table_remove(snv, subset);
+        count -= vrd_MNV_table_remove_seq(mnv, subset, seq);
+        vrd_AVL_tree_destroy(&subset);
+        return count;
+    }
+} // vrd_variants_from_vcf
+
+
+static bool
+info_end(char const* info, size_t* const end)
+{
+    while (NULL != info && '\0' != *info)
+    {
+        size_t const len = strcspn(info, ";");
+        if (4 < len && 0 == strncmp(info, "END=", 4))
+        {
+            return parse_number(len - 4, info + 4, end);
+        } // if
+        info += len;
+        if (';' == *info)
+        {
+            info += 1;
+        } // if
+    } // while
+    return false;
+} // info_end
+
+
+size_t
+vrd_coverage_from_gvcf(FILE* stream,
+                       vrd_Cov_Table* const cov,
+                       size_t const sample_id)
+{
+    assert(NULL != stream);
+    assert(NULL != cov);
+
+    char* line = NULL;
+    size_t capacity = 0;
+
+    struct Record record;
+
+    // the pending region, extended while records are adjacent
+    char reference[MAX_REFERENCE] = {'\0'};
+    size_t len = 0;
+    size_t start = 0;
+    size_t end = 0;
+    size_t allele_count = 0;
+
+    size_t count = 0;
+    while (-1 != getline(&line, &capacity, stream))
+    {
+        if ('#' == line[0])
+        {
+            continue;
+        } // if
+
+        if (!parse(line, &record))
+        {
+            break;
+        } // if
+
+        size_t const called = record_count(&record, CALLED);
+        if (0 == called)
+        {
+            continue;
+        } // if
+
+        size_t const record_start = record.position - 1;
+        size_t record_end = 0;
+        if (!info_end(record.field[INFO], &record_end))
+        {
+            record_end = record_start + strlen(record.field[REF]);
+        } // if
+        if (record_end <= record_start)
+        {
+            continue;
+        } // if
+
+        size_t const len_reference = strlen(record.field[CHROM]) + 1;
+        if (0 < allele_count && len == len_reference && 0 == strcmp(reference, record.field[CHROM]) &&
+            called == allele_count && record_start <= end && start <= record_start)
+        {
+            end = record_end > end ? record_end : end;
+            continue;
+        } // if
+
+        if (0 < allele_count)
+        {
+            if (0 != vrd_Cov_table_insert(cov, len, reference, start, end, allele_count, sample_id))
+            {
+                goto error;
+            } // if
+            count += 1;  // OVERFLOW
+        } // if
+
+        (void) memcpy(reference, record.field[CHROM], len_reference);
+        len = len_reference;
+        start = record_start;
+        end = record_end;
+        allele_count = called;
+    } // while
+
+    if (0 < allele_count)
+    {
+        if (0 != vrd_Cov_table_insert(cov, len, reference, start, end, allele_count, sample_id))
+        {
+            goto error;
+        } // if
+        count += 1;  // OVERFLOW
+    } // if
+
+    free(line);
+    return count;
+
+error:
+    free(line);
+    {
+        vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+        if (NULL == subset)
+        {
+            return count;
+        } // if
+        if (0 != vrd_AVL_tree_insert(subset, sample_id))
+        {
+            vrd_AVL_tree_destroy(&subset);
+            return count;
+        } // if
+
+        count -= vrd_Cov_table_remove(cov, subset);
+        vrd_AVL_tree_destroy(&subset);
+        return count;
+    }
+} // vrd_coverage_from_gvcf
@@ -0,0 +1,1237 @@
+#define _POSIX_C_SOURCE 200809L
+
+
+#include <assert.h>     // assert
+#include <errno.h>      // ENOENT, errno
+#include <pthread.h>    // pthread_*
+#include <stdbool.h>    // bool, false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // UINT32_MAX, uint32_t
+#include <stdio.h>      // FILE, FILENAME_MAX, SEEK_*, fclose, fflush,
+                        // fileno, fopen, fread, fseek, ftell, fwrite,
+                        // remove, rename, snprintf
+#include <stdlib.h>     // free, malloc, realloc
+#include <string.h>     // memcmp, memcpy, strlen
+#include <unistd.h>     // fsync, ftruncate
+
+#include <zlib.h>       // crc32
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree, vrd_AVL_tree_*
+#include "../include/cov_table.h"   // vrd_Cov_Table, vrd_Cov_table_*
+#include "../include/mnv_table.h"   // vrd_MNV_Table, vrd_MNV_table_*
+#include "../include/seq_table.h"   // vrd_Seq_Table, vrd_Seq_table_*
+#include "../include/snv_table.h"   // vrd_SNV_Table, vrd_SNV_table_*
+#include "../include/trie.h"        // vrd_Trie_Node
+#include "../include/wal.h"         // vrd_WAL, vrd_wal_*
+#include "wal_log.h"    // vrd_wal_enter, vrd_wal_leave, vrd_*_wal_*
+
+
+enum
+{
+    OP_SNV_INSERT = 1,
+    OP_MNV_INSERT,
+    OP_COV_INSERT,
+    OP_SNV_REMOVE,
+    OP_MNV_REMOVE,
+    OP_MNV_REMOVE_SEQ,
+    OP_MNV_COMPACT_SEQ,
+    OP_COV_REMOVE
+}; // operations
+
+
+// The log starts with the magic and its generation; a checkpoint writes
+// the next generation to `<path>.ckpt` before emptying the log. A log of
+// an older generation than the checkpoint is contained in the tables.
+//
+// A checkpoint in the background moves the log aside to `<path>.prev`
+// and continues with a log of the next generation; both are replayed
+// until the checkpoint completes.
+//
+// A table written during a checkpoint records the position in the log
+// (the generation and the offset) up to which it contains the records
+// in its index. A replay skips the records before it for that table, so
+// a crash before the checkpoint completes (or a checkpoint that fails
+// after writing some of the tables) does not apply records twice.
+//
+// Every record is its size, the CRC-32 of its payload and the payload:
+// the operation followed by its arguments. A removal is logged per
+// reference.
+//
+// An update is logged before it is applied, while its reference is held
+// by the table, so the records of a reference are in the order applied.
+// The log stays locked until the update is applied (vrd_wal_done()); a
+// record of an update that failed is cut off again.
+static char const MAGIC[8] = {'V', 'R', 'D', 'W', 'A', 'L', '0', '2'};
+static long const HEADER_SIZE = sizeof(MAGIC) + sizeof(size_t);
+
+
+struct vrd_WAL
+{
+    FILE* stream;
+    char* path;
+    vrd_Seq_Table const* seq;
+
+    size_t generation;
+    bool replaying;
+    bool rotated;   // `<path>.prev` is part of the log
+    bool checkpointing; // the updates are held off for a checkpoint
+
+    pthread_rwlock_t updates;   // updates read, checkpoints write
+    pthread_mutex_t lock;       // the record and the stream
+
+    bool logging;   // a record is appended under the lock
+    long mark;      // where it starts
+
+    bool failed;
+    size_t size;
+    size_t capacity;
+    unsigned char* record;
+}; // vrd_WAL
+
+
+static int
+reset(vrd_WAL* const self, size_t const generation)
+{
+    if (0 != fflush(self->stream) ||
+        0 != ftruncate(fileno(self->stream), 0) ||
+        0 != fseek(self->stream, 0, SEEK_SET))
+    {
+        return errno;
+    } // if
+
+    if (1 != fwrite(MAGIC, sizeof(MAGIC), 1, self->stream) ||
+        1 != fwrite(&generation, sizeof(generation), 1, self->stream) ||
+        0 != fflush(self->stream) ||
+        0 != fsync(fileno(self->stream)))
+    {
+        return errno;
+    } // if
+
+    self->generation = generation;
+    return 0;
+} // reset
+
+
+static size_t
+checkpoint_generation(char const* const path)
+{
+    char filename[FILENAME_MAX] = {'\0'};
+    if (0 >= snprintf(filename, sizeof(filename), "%s.ckpt", path))
+    {
+        return 0;
+    } // if
+
+    FILE* const stream = fopen(filename, "rb");
+    if (NULL == stream)
+    {
+        return 0;
+    } // if
+
+    size_t generation = 0;
+    if (1 != fread(&generation, sizeof(generation), 1, stream))
+    {
+        generation = 0;
+    } // if
+    (void) fclose(stream);
+
+    return generation;
+} // checkpoint_generation
+
+
+// Whether there is a log at `filename` (and its generation)
+static bool
+log_generation(char const* const filename, size_t* const generation)
+{
+    FILE* const stream = fopen(filename, "rb");
+    if (NULL == stream)
+    {
+        return false;
+    } // if
+
+    char magic[sizeof(MAGIC)] = {'\0'};
+    bool const ret = 1 == fread(magic, sizeof(magic), 1, stream) &&
+                     0 == memcmp(magic, MAGIC, sizeof(MAGIC)) &&
+                     1 == fread(generation, sizeof(*generation), 1, stream);
+    (void) fclose(stream);
+
+    return ret;
+} // log_generation
+
+
+// Writes the generation to `<path>.ckpt` atomically
+static int
+checkpoint_write(char const* const path, size_t const generation)
+{
+    char filename[FILENAME_MAX] = {'\0'};
+    char tmp_filename[FILENAME_MAX] = {'\0'};
+    if (0 >= snprintf(filename, sizeof(filename), "%s.ckpt", path) ||
+        0 >= snprintf(tmp_filename, sizeof(tmp_filename), "%s.ckpt.tmp", path))
+    {
+        return -1;
+    } // if
+
+    FILE* const stream = fopen(tmp_filename, "wb");
+    if (NULL == stream)
+    {
+        return errno;
+    } // if
+
+    if (1 != fwrite(&generation, sizeof(generation), 1, stream) ||
+        0 != fflush(stream) ||
+        0 != fsync(fileno(stream)))
+    {
+        int const err = errno;
+        (void) fclose(stream);
+        return err;
+    } // if
+
+    if (0 != fclose(stream) || 0 != rename(tmp_filename, filename))
+    {
+        return errno;
+    } // if
+
+    return 0;
+} // checkpoint_write
+
+
+// Reads the next record into `self->record`: 1 for a record, 0 at the
+// end of the log or at a torn or corrupt record
+static int
+record_read(vrd_WAL* const self, FILE* const stream)
+{
+    uint32_t size = 0;
+    uint32_t crc = 0;
+    if (1 != fread(&size, sizeof(size), 1, stream) ||
+        1 != fread(&crc, sizeof(crc), 1, stream))
+    {
+        return 0;
+    } // if
+
+    if (self->capacity < size)
+    {
+        unsigned char* const record = realloc(self->record, size);
+        if (NULL == record)
+        {
+            return 0;
+        } // if
+        self->record = record;
+        self->capacity = size;
+    } // if
+
+    if (size != fread(self->record, 1, size, stream) ||
+        crc != crc32(0L, self->record, size))
+    {
+        return 0;
+    } // if
+
+    self->size = size;
+    return 1;
+} // record_read
+
+
+// Positions the stream after the last valid record and cuts off a torn
+// record (if any)
+static int
+recover(vrd_WAL* const self)
+{
+    if (0 != fseek(self->stream, HEADER_SIZE, SEEK_SET))
+    {
+        return errno;
+    } // if
+
+    long end = HEADER_SIZE;
+    while (1 == record_read(self, self->stream))
+    {
+        end = ftell(self->stream);
+    } // while
+
+    if (0 != fseek(self->stream, 0, SEEK_END))
+    {
+        return errno;
+    } // if
+
+    if (end != ftell(self->stream))
+    {
+        if (0 != fflush(self->stream) ||
+            0 != ftruncate(fileno(self->stream), end) ||
+            0 != fseek(self->stream, end, SEEK_SET))
+        {
+            return errno;
+        } // if
+    } // if
+
+    return 0;
+} // recover
+
+
+vrd_WAL*
+vrd_wal_open(char const* const path, vrd_Seq_Table const* const seq)
+{
+    assert(NULL != path);
+
+    vrd_WAL* const self = malloc(sizeof(*self));
+    if (NULL == self)
+    {
+        return NULL;
+    } // if
+
+    *self = (vrd_WAL) {.seq = seq};
+
+    self->path = malloc(strlen(path) + 1);
+    if (NULL == self->path)
+    {
+        goto error;
+    } // if
+    (void) memcpy(self->path, path, strlen(path) + 1);
+
+    size_t const checkpoint = checkpoint_generation(path);
+
+    self->stream = fopen(path, "r+b");
+    if (NULL == self->stream && ENOENT == errno)
+    {
+        self->stream = fopen(path, "w+b");
+        if (NULL == self->stream || 0 != reset(self, checkpoint))
+        {
+            goto error;
+        } // if
+    } // if
+    if (NULL == self->stream)
+    {
+        goto error;
+    } // if
+
+    char magic[sizeof(MAGIC)] = {'\0'};
+    if (0 != fseek(self->stream, 0, SEEK_SET) ||
+        1 != fread(magic, sizeof(magic), 1, self->stream) ||
+        0 != memcmp(magic, MAGIC, sizeof(MAGIC)) ||
+        1 != fread(&self->generation, sizeof(self->generation), 1, self->stream))
+    {
+        errno = -1;
+        goto error;
+    } // if
+
+    // the log is contained in the last checkpoint
+    int const ret = self->generation < checkpoint ? reset(self, checkpoint) : recover(self);
+    if (0 != ret)
+    {
+        errno = ret;
+        goto error;
+    } // if
+
+    // the log moved aside by an unfinished checkpoint
+    char filename[FILENAME_MAX] = {'\0'};
+    size_t generation = 0;
+    if (0 < snprintf(filename, sizeof(filename), "%s.prev", path) &&
+        log_generation(filename, &generation))
+    {
+        self->rotated = checkpoint <= generation;
+        if (!self->rotated)
+        {
+            (void) remove(filename);
+        } // if
+    } // if
+
+    if (0 != pthread_mutex_init(&self->lock, NULL))
+    {
+        goto error;
+    } // if
+    if (0 != pthread_rwlock_init(&self->updates, NULL))
+    {
+        (void) pthread_mutex_destroy(&self->lock);
+        goto error;
+    } // if
+
+    return self;
+
+error:
+    if (NULL != self->stream)
+    {
+        (void) fclose(self->stream);
+    } // if
+    free(self->path);
+    free(self->record);
+    free(self);
+    return NULL;
+} // vrd_wal_open
+
+
+void
+vrd_wal_close(vrd_WAL** const self)
+{
+    if (NULL == self || NULL == *self)
+    {
+        return;
+    } // if
+
+    (void) fclose((*self)->stream);
+    (void) pthread_rwlock_destroy(&(*self)->updates);
+    (void) pthread_mutex_destroy(&(*self)->lock);
+    free((*self)->path);
+    free((*self)->record);
+    free(*self);
+    *self = NULL;
+} // vrd_wal_close
+
+
+void
+vrd_wal_enter(vrd_WAL* const self)
+{
+    if (NULL != self)
+    {
+        (void) pthread_rwlock_rdlock(&self->updates);
+    } // if
+} // vrd_wal_enter
+
+
+void
+vrd_wal_leave(vrd_WAL* const self)
+{
+    if (NULL != self)
+    {
+        (void) pthread_rwlock_unlock(&self->updates);
+    } // if
+} // vrd_wal_leave
+
+
+static void
+put(vrd_WAL* const self, void const* const data, size_t const size)
+{
+    if (self->capacity < self->size + size)
+    {
+        size_t const capacity = (self->size + size) * 2;
+        unsigned char* const record = realloc(self->record, capacity);
+        if (NULL == record)
+        {
+            self->failed = true;
+            return;
+        } // if
+        self->record = record;
+        self->capacity = capacity;
+    } // if
+
+    (void) memcpy(&self->record[self->size], data, size);
+    self->size += size;
+} // put
+
+
+static void
+put_size(vrd_WAL* const self, size_t const value)
+{
+    put(self, &value, sizeof(value));
+} // put_size
+
+
+static void
+put_string(vrd_WAL* const self, size_t const len, char const string[len])
+{
+    put_size(self, len);
+    put(self, string, len);
+} // put_string
+
+
+static void
+put_subset(vrd_WAL* const self, vrd_AVL_Tree const* const subset)
+{
+    size_t const count = vrd_AVL_tree_keys(subset, 0, NULL);
+    size_t* const keys = malloc(sizeof(*keys) * (0 == count ? 1 : count));
+    if (NULL == keys)
+    {
+        self->failed = true;
+        return;
+    } // if
+
+    (void) vrd_AVL_tree_keys(subset, count, keys);
+    put_size(self, count);
+    put(self, keys, sizeof(*keys) * count);
+    free(keys);
+} // put_subset
+
+
+// Locks the log until vrd_wal_done(); nothing is logged during a replay
+static bool
+record_begin(vrd_WAL* const self, unsigned char const op)
+{
+    (void) pthread_mutex_lock(&self->lock);
+    self->logging = !self->replaying;
+    if (!self->logging)
+    {
+        return false;
+    } // if
+
+    self->failed = false;
+    self->size = 0;
+    put(self, &op, sizeof(op));
+    return true;
+} // record_begin
+
+
+// Cuts the log off at the start of the last record
+static void
+record_cut(vrd_WAL* const self)
+{
+    if (0 != fflush(self->stream) ||
+        0 != ftruncate(fileno(self->stream), self->mark))
+    {
+        // the stream is broken: a torn record is cut off when opened
+        (void) fseek(self->stream, self->mark, SEEK_SET);
+        return;
+    } // if
+    (void) fseek(self->stream, self->mark, SEEK_SET);
+} // record_cut
+
+
+// Appends the record; on success the log stays locked until
+// vrd_wal_done(), on failure nothing is appended and the log is unlocked
+static int
+record_end(vrd_WAL* const self)
+{
+    if (self->failed || UINT32_MAX < self->size)
+    {
+        (void) pthread_mutex_unlock(&self->lock);
+        return -1;
+    } // if
+
+    self->mark = ftell(self->stream);
+    if (0 > self->mark)
+    {
+        int const err = errno;
+        (void) pthread_mutex_unlock(&self->lock);
+        return err;
+    } // if
+
+    uint32_t const size = self->size;
+    uint32_t const crc = crc32(0L, self->record, size);
+    if (1 != fwrite(&size, sizeof(size), 1, self->stream) ||
+        1 != fwrite(&crc, sizeof(crc), 1, self->stream) ||
+        size != fwrite(self->record, 1, size, self->stream))
+    {
+        int const err = errno;
+        record_cut(self);
+        (void) pthread_mutex_unlock(&self->lock);
+        return 0 == err ? -1 : err;
+    } // if
+
+    return 0;
+} // record_end
+
+
+void
+vrd_wal_done(vrd_WAL* const self, bool const keep)
+{
+    if (NULL == self)
+    {
+        return;
+    } // if
+
+    if (self->logging && !keep)
+    {
+        record_cut(self);
+    } // if
+    self->logging = false;
+    (void) pthread_mutex_unlock(&self->lock);
+} // vrd_wal_done
+
+
+int
+vrd_SNV_wal_insert(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   size_t const position,
+                   size_t const count,
+                   size_t const sample_id,
+                   size_t const phase,
+                   size_t const inserted)
+{
+    if (NULL == self)
+    {
+        return 0;
+    } // if
+
+    if (!record_begin(self, OP_SNV_INSERT))
+    {
+        return 0;
+    } // if
+    put_string(self, len, reference);
+    put_size(self, position);
+    put_size(self, count);
+    put_size(self, sample_id);
+    put_size(self, phase);
+    put_size(self, inserted);
+    return record_end(self);
+} // vrd_SNV_wal_insert
+
+
+int
+vrd_MNV_wal_insert(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   size_t const start,
+                   size_t const end,
+                   size_t const count,
+                   size_t const sample_id,
+                   size_t const phase,
+                   size_t const inserted)
+{
+    if (NULL == self)
+    {
+        return 0;
+    } // if
+
+    if (NULL == self->seq)
+    {
+        return -1;
+    } // if
+
+    char* sequence = NULL;
+    size_t const len_seq = vrd_Seq_table_key(self->seq, inserted, &sequence);
+    if (0 == len_seq)
+    {
+        free(sequence);
+        return -1;
+    } // if
+
+    int const ret = vrd_MNV_wal_insert_sequence(self, len, reference, start, end, count, sample_id, phase, len_seq, sequence);
+    free(sequence);
+    return ret;
+} // vrd_MNV_wal_insert
+
+
+int
+vrd_MNV_wal_insert_sequence(vrd_WAL* const self,
+                            size_t const len,
+                            char const reference[len],
+                            size_t const start,
+                            size_t const end,
+                            size_t const count,
+                            size_t const sample_id,
+                            size_t const phase,
+                            size_t const len_seq,
+                            char const sequence[len_seq])
+{
+    if (NULL == self)
+    {
+        return 0;
+    } // if
+
+    if (!record_begin(self, OP_MNV_INSERT))
+    {
+        return 0;
+    } // if
+    put_string(self, len, reference);
+    put_size(self, start);
+    put_size(self, end);
+    put_size(self, count);
+    put_size(self, sample_id);
+    put_size(self, phase);
+    put_string(self, len_seq, sequence);
+    return record_end(self);
+} // vrd_MNV_wal_insert_sequence
+
+
+int
+vrd_Cov_wal_insert(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   size_t const start,
+                   size_t const end,
+                   size_t const count,
+                   size_t const sample_id)
+{
+    if (NULL == self)
+    {
+        return 0;
+    } // if
+
+    if (!record_begin(self, OP_COV_INSERT))
+    {
+        return 0;
+    } // if
+    put_string(self, len, reference);
+    put_size(self, start);
+    put_size(self, end);
+    put_size(self, count);
+    put_size(self, sample_id);
+    return record_end(self);
+} // vrd_Cov_wal_insert
+
+
+static int
+log_subset(vrd_WAL* const self,
+           unsigned char const op,
+           size_t const len,
+           char const reference[len],
+           vrd_AVL_Tree const* const subset)
+{
+    if (NULL == self)
+    {
+        return 0;
+    } // if
+
+    if (!record_begin(self, op))
+    {
+        return 0;
+    } // if
+    put_string(self, len, reference);
+    put_subset(self, subset);
+    return record_end(self);
+} // log_subset
+
+
+int
+vrd_SNV_wal_remove(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   vrd_AVL_Tree const* const subset)
+{
+    return log_subset(self, OP_SNV_REMOVE, len, reference, subset);
+} // vrd_SNV_wal_remove
+
+
+int
+vrd_MNV_wal_remove(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   vrd_AVL_Tree const* const subset)
+{
+    return log_subset(self, OP_MNV_REMOVE, len, reference, subset);
+} // vrd_MNV_wal_remove
+
+
+int
+vrd_MNV_wal_remove_seq(vrd_WAL* const self,
+                       size_t const len,
+                       char const reference[len],
+                       vrd_AVL_Tree const* const subset)
+{
+    return log_subset(self, OP_MNV_REMOVE_SEQ, len, reference, subset);
+} // vrd_MNV_wal_remove_seq
+
+
+int
+vrd_Cov_wal_remove(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   vrd_AVL_Tree const* const subset)
+{
+    return log_subset(self, OP_COV_REMOVE, len, reference, subset);
+} // vrd_Cov_wal_remove
+
+
+int
+vrd_MNV_wal_compact_seq(vrd_WAL* const self)
+{
+    if (NULL == self)
+    {
+        return 0;
+    } // if
+
+    if (!record_begin(self, OP_MNV_COMPACT_SEQ))
+    {
+        return 0;
+    } // if
+    return record_end(self);
+} // vrd_MNV_wal_compact_seq
+
+
+// Reading the payload of a record
+struct Cursor
+{
+    unsigned char const* data;
+    size_t size;
+    bool failed;
+}; // Cursor
+
+
+static void
+get(struct Cursor* const cursor, void* const data, size_t const size)
+{
+    if (cursor->size < size)
+    {
+        cursor->failed = true;
+        return;
+    } // if
+
+    (void) memcpy(data, cursor->data, size);
+    cursor->data += size;
+    cursor->size -= size;
+} // get
+
+
+static size_t
+get_size(struct Cursor* const cursor)
+{
+    size_t value = 0;
+    get(cursor, &value, sizeof(value));
+    return value;
+} // get_size
+
+
+// The string is not copied: it points into the record
+static char const*
+get_string(struct Cursor* const cursor, size_t* const len)
+{
+    *len = get_size(cursor);
+    if (cursor->failed || cursor->size < *len || 0 == *len || '\0' != cursor->data[*len - 1])
+    {
+        cursor->failed = true;
+        return NULL;
+    } // if
+
+    char const* const string = (char const*) cursor->data;
+    cursor->data += *len;
+    cursor->size -= *len;
+    return string;
+} // get_string
+
+
+static vrd_AVL_Tree*
+get_subset(struct Cursor* const cursor)
+{
+    size_t const count = get_size(cursor);
+    if (cursor->failed || cursor->size / sizeof(size_t) < count)
+    {
+        cursor->failed = true;
+        return NULL;
+    } // if
+
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(count);
+    if (NULL == subset)
+    {
+        cursor->failed = true;
+        return NULL;
+    } // if
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (0 != vrd_AVL_tree_insert(subset, get_size(cursor)))
+        {
+            vrd_AVL_tree_destroy(&subset);
+            cursor->failed = true;
+            return NULL;
+        } // if
+    } // for
+
+    return subset;
+} // get_subset
+
+
+static int
+apply(struct Cursor* const cursor,
+      vrd_SNV_Table* const snv,
+      vrd_MNV_Table* const mnv,
+      vrd_Seq_Table* const seq,
+      vrd_Cov_Table* const cov)
+{
+    unsigned char op = 0;
+    get(cursor, &op, sizeof(op));
+
+    size_t len = 0;
+    char const* reference = NULL;
+    vrd_AVL_Tree* subset = NULL;
+    int ret = 0;
+
+    switch (op)
+    {
+        case OP_SNV_INSERT:
+        {
+            reference = get_string(cursor, &len);
+            size_t const position = get_size(cursor);
+            size_t const count = get_size(cursor);
+            size_t const sample_id = get_size(cursor);
+            size_t const phase = get_size(cursor);
+            size_t const inserted = get_size(cursor);
+            if (!cursor->failed && NULL != snv)
+            {
+                ret = vrd_SNV_table_insert(snv, len, reference, position, count, sample_id, phase, inserted);
+            } // if
+            break;
+        }
+        case OP_MNV_INSERT:
+        {
+            reference = get_string(cursor, &len);
+            size_t const start = get_size(cursor);
+            size_t const end = get_size(cursor);
+            size_t const count = get_size(cursor);
+            size_t const sample_id = get_size(cursor);
+            size_t const phase = get_size(cursor);
+            size_t len_seq = 0;
+            char const* const sequence = get_string(cursor, &len_seq);
+            if (!cursor->failed && NULL != mnv && NULL != seq)
+            {
+                vrd_Trie_Node const* const elem = vrd_Seq_table_insert(seq, len_seq, sequence);
+                ret = NULL == elem ? -1 : vrd_MNV_table_insert(mnv, len, reference, start, end, count, sample_id, phase, (size_t) elem->data);
+            } // if
+            break;
+        }
+        case OP_COV_INSERT:
+        {
+            reference = get_string(cursor, &len);
+            size_t const start = get_size(cursor);
+            size_t const end = get_size(cursor);
+            size_t const count = get_size(cursor);
+            size_t const sample_id = get_size(cursor);
+            if (!cursor->failed && NULL != cov)
+            {
+                ret = vrd_Cov_table_insert(cov, len, reference, start, end, count, sample_id);
+            } // if
+            break;
+        }
+        case OP_SNV_REMOVE:
+        case OP_MNV_REMOVE:
+        case OP_MNV_REMOVE_SEQ:
+        case OP_COV_REMOVE:
+            reference = get_string(cursor, &len);
+            subset = get_subset(cursor);
+            if (cursor->failed)
+            {
+                break;
+            } // if
+
+            if (OP_SNV_REMOVE == op && NULL != snv)
+            {
+                ret = (size_t) -1 == vrd_SNV_table_remove_reference(snv, len, reference, subset) ? -1 : 0;
+            } // if
+            else if (OP_MNV_REMOVE == op && NULL != mnv)
+            {
+                ret = (size_t) -1 == vrd_MNV_table_remove_reference(mnv, len, reference, subset) ? -1 : 0;
+            } // if
+            else if (OP_MNV_REMOVE_SEQ == op && NULL != mnv && NULL != seq)
+            {
+                ret = (size_t) -1 == vrd_MNV_table_remove_seq_reference(mnv, len, reference, subset, seq) ? -1 : 0;
+            } // if
+            else if (OP_COV_REMOVE == op && NULL != cov)
+            {
+                ret = (size_t) -1 == vrd_Cov_table_remove_reference(cov, len, reference, subset) ? -1 : 0;
+            } // if
+            vrd_AVL_tree_destroy(&subset);
+            break;
+        case OP_MNV_COMPACT_SEQ:
+            if (NULL != mnv && NULL != seq)
+            {
+                ret = vrd_MNV_table_compact_seq(mnv, seq);
+            } // if
+            break;
+        default:
+            cursor->failed = true;
+    } // switch
+
+    return cursor->failed ? -1 : ret;
+} // apply
+
+
+// Whether a table containing the records up to `offset` in the log of
+// `generation` contains the record at `position` in the log of
+// `log_generation` (an offset of 0 is unknown: nothing)
+static bool
+contained(size_t const generation,
+          size_t const offset,
+          size_t const log_generation,
+          long const position)
+{
+    if (0 == offset)
+    {
+        return false;
+    } // if
+    return log_generation < generation || (log_generation == generation && (size_t) position < offset);
+} // contained
+
+
+// Applies the records of a log file; -1 on error
+static size_t
+replay_file(vrd_WAL* const self,
+            char const* const filename,
+            vrd_SNV_Table* const snv,
+            vrd_MNV_Table* const mnv,
+            vrd_Seq_Table* const seq,
+            vrd_Cov_Table* const cov)
+{
+    FILE* const stream = fopen(filename, "rb");
+    if (NULL == stream)
+    {
+        return -1;
+    } // if
+
+    size_t generation = 0;
+    if (0 != fseek(stream, sizeof(MAGIC), SEEK_SET) ||
+        1 != fread(&generation, sizeof(generation), 1, stream))
+    {
+        (void) fclose(stream);
+        return -1;
+    } // if
+
+    size_t snv_offset = 0;
+    size_t mnv_offset = 0;
+    size_t cov_offset = 0;
+    size_t const snv_generation = NULL == snv ? 0 : vrd_SNV_table_logged(snv, &snv_offset);
+    size_t const mnv_generation = NULL == mnv ? 0 : vrd_MNV_table_logged(mnv, &mnv_offset);
+    size_t const cov_generation = NULL == cov ? 0 : vrd_Cov_table_logged(cov, &cov_offset);
+
+    size_t count = 0;
+    long position = ftell(stream);
+    while (0 <= position && 1 == record_read(self, stream))
+    {
+        // the tables that contain the record already are skipped
+        struct Cursor cursor = {.data = self->record, .size = self->size};
+        if (0 != apply(&cursor,
+                       contained(snv_generation, snv_offset, generation, position) ? NULL : snv,
+                       contained(mnv_generation, mnv_offset, generation, position) ? NULL : mnv,
+                       seq,
+                       contained(cov_generation, cov_offset, generation, position) ? NULL : cov))
+        {
+            count = -1;
+            break;
+        } // if
+        count += 1;
+        position = ftell(stream);
+    } // while
+
+    (void) fclose(stream);
+    return 0 <= position ? count : (size_t) -1;
+} // replay_file
+
+
+size_t
+vrd_wal_replay(vrd_WAL* const self,
+               vrd_SNV_Table* const snv,
+               vrd_MNV_Table* const mnv,
+               vrd_Seq_Table* const seq,
+               vrd_Cov_Table* const cov)
+{
+    assert(NULL != self);
+
+    // the records are read through streams of their own: the lock is
+    // not held while applying as the tables may log to this log
+    (void) pthread_mutex_lock(&self->lock);
+    self->replaying = true;
+    bool const rotated = self->rotated;
+    int const ret = fflush(self->stream);
+    (void) pthread_mutex_unlock(&self->lock);
+
+    size_t count = -1;
+    char filename[FILENAME_MAX] = {'\0'};
+    if (0 != ret || 0 >= snprintf(filename, sizeof(filename), "%s.prev", self->path))
+    {
+        goto exit;
+    } // if
+
+    size_t prev = 0;
+    if (rotated)
+    {
+        prev = replay_file(self, filename, snv, mnv, seq, cov);
+        if ((size_t) -1 == prev)
+        {
+            goto exit;
+        } // if
+    } // if
+
+    count = replay_file(self, self->path, snv, mnv, seq, cov);
+    if ((size_t) -1 != count)
+    {
+        count += prev;
+    } // if
+
+exit:
+    (void) pthread_mutex_lock(&self->lock);
+    self->replaying = false;
+    (void) pthread_mutex_unlock(&self->lock);
+
+    return count;
+} // vrd_wal_replay
+
+
+int
+vrd_wal_sync(vrd_WAL* const self)
+{
+    assert(NULL != self);
+
+    (void) pthread_mutex_lock(&self->lock);
+    int ret = 0;
+    if (0 != fflush(self->stream) || 0 != fsync(fileno(self->stream)))
+    {
+        ret = errno;
+    } // if
+    (void) pthread_mutex_unlock(&self->lock);
+
+    return ret;
+} // vrd_wal_sync
+
+
+int
+vrd_wal_checkpoint_begin(vrd_WAL* const self)
+{
+    assert(NULL != self);
+
+    int const ret = pthread_rwlock_wrlock(&self->updates);
+    if (0 == ret)
+    {
+        (void) pthread_mutex_lock(&self->lock);
+        self->checkpointing = true;
+        (void) pthread_mutex_unlock(&self->lock);
+    } // if
+    return ret;
+} // vrd_wal_checkpoint_begin
+
+
+size_t
+vrd_wal_contained(vrd_WAL* const self, size_t* const offset)
+{
+    *offset = 0;
+    if (NULL == self)
+    {
+        return 0;
+    } // if
+
+    (void) pthread_mutex_lock(&self->lock);
+    size_t generation = 0;
+    long const end = self->checkpointing && 0 == fflush(self->stream) ? ftell(self->stream) : -1;
+    if (0 < end)
+    {
+        generation = self->generation;
+        *offset = end;
+    } // if
+    (void) pthread_mutex_unlock(&self->lock);
+    return generation;
+} // vrd_wal_contained
+
+
+int
+vrd_wal_checkpoint_end(vrd_WAL* const self, bool const written)
+{
+    assert(NULL != self);
+
+    int ret = 0;
+    if (written)
+    {
+        (void) pthread_mutex_lock(&self->lock);
+
+        // from here on the log is superseded by the checkpoint
+        size_t const generation = self->generation + 1;
+        ret = checkpoint_write(self->path, generation);
+        if (0 == ret)
+        {
+            ret = reset(self, generation);
+        } // if
+
+        char filename[FILENAME_MAX] = {'\0'};
+        if (0 == ret && self->rotated &&
+            0 < snprintf(filename, sizeof(filename), "%s.prev", self->path))
+        {
+            (void) remove(filename);
+            self->rotated = false;
+        } // if
+
+        (void) pthread_mutex_unlock(&self->lock);
+    } // if
+
+    (void) pthread_mutex_lock(&self->lock);
+    self->checkpointing = false;
+    (void) pthread_mutex_unlock(&self->lock);
+
+    (void) pthread_rwlock_unlock(&self->updates);
+    return ret;
+} // vrd_wal_checkpoint_end
+
+
+int
+vrd_wal_checkpoint_freeze(vrd_WAL* const self)
+{
+    assert(NULL != self);
+
+    char filename[FILENAME_MAX] = {'\0'};
+    char tmp_filename[FILENAME_MAX] = {'\0'};
+    if (0 >= snprintf(filename, sizeof(filename), "%s.prev", self->path) ||
+        0 >= snprintf(tmp_filename, sizeof(tmp_filename), "%s.tmp", self->path))
+    {
+        return -1;
+    } // if
+
+    (void) pthread_mutex_lock(&self->lock);
+
+    int ret = -1;
+    FILE* const old = self->stream;
+    FILE* stream = NULL;
+
+    // one checkpoint in the background at the time
+    if (self->rotated)
+    {
+        goto exit;
+    } // if
+
+    if (0 != fflush(old) || 0 != fsync(fileno(old)))
+    {
+        ret = errno;
+        goto exit;
+    } // if
+
+    // the next log is complete before it replaces the current one
+    stream = fopen(tmp_filename, "w+b");
+    if (NULL == stream)
+    {
+        ret = errno;
+        goto exit;
+    } // if
+
+    self->stream = stream;
+    ret = reset(self, self->generation + 1);
+    if (0 != ret)
+    {
+        goto exit;
+    } // if
+
+    if (0 != rename(self->path, filename))
+    {
+        ret = errno;
+        self->generation -= 1;
+        goto exit;
+    } // if
+
+    if (0 != rename(tmp_filename, self->path))
+    {
+        ret = errno;
+        self->generation -= 1;
+        (void) rename(filename, self->path);
+        goto exit;
+    } // if
+
+    (void) fclose(old);
+    self->rotated = true;
+    self->checkpointing = false;
+    (void) pthread_mutex_unlock(&self->lock);
+    (void) pthread_rwlock_unlock(&self->updates);
+    return 0;
+
+exit:
+    self->stream = old;
+    if (NULL != stream)
+    {
+        (void) fclose(stream);
+        (void) remove(tmp_filename);
+    } // if
+    (void) pthread_mutex_unlock(&self->lock);
+    return ret;
+} // vrd_wal_checkpoint_freeze
+
+
+int
+vrd_wal_checkpoint_done(vrd_WAL* const self, bool const written)
+{
+    assert(NULL != self);
+
+    (void) pthread_mutex_lock(&self->lock);
+
+    // a checkpoint in the meantime completed this one as well
+    int ret = 0;
+    char filename[FILENAME_MAX] = {'\0'};
+    if (written && self->rotated)
+    {
+        ret = checkpoint_write(self->path, self->generation);
+        if (0 == ret && 0 < snprintf(filename, sizeof(filename), "%s.prev", self->path))
+        {
+            (void) remove(filename);
+            self->rotated = false;
+        } // if
+    } // if
+
+    (void) pthread_mutex_unlock(&self->lock);
+    return ret;
+} // vrd_wal_checkpoint_done
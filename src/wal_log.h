@@ -0,0 +1,150 @@
+#ifndef VRD_WAL_LOG_H
+#define VRD_WAL_LOG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+#include <stdbool.h>    // bool
+#include <stddef.h>     // size_t
+
+#include "../include/avl_tree.h"    // vrd_AVL_Tree
+#include "../include/wal.h"         // vrd_WAL
+
+
+/**
+ * Appending to the log as used by the tables. All functions accept a
+ * NULL log (and then do nothing). An update is logged and applied
+ * between vrd_wal_enter() and vrd_wal_leave(), so a checkpoint never
+ * sees an update that is not (yet) in the log.
+ *
+ * An update is logged before it is applied, with its reference held
+ * (the writer lock), so the records of a reference are in the order the
+ * updates are applied. On success a vrd_*_wal_*() function keeps the log
+ * locked until vrd_wal_done(); on failure nothing is logged and the
+ * update must not be applied.
+ */
+void
+vrd_wal_enter(vrd_WAL* const self);
+
+
+void
+vrd_wal_leave(vrd_WAL* const self);
+
+
+/**
+ * The position in the log up to which a table written (or frozen) now
+ * contains the records: the generation of the log and the `offset` in
+ * it. Only known during a checkpoint, when the updates are held off;
+ * otherwise the offset is 0. A table records it in its index.
+ *
+ * @return The generation.
+ */
+size_t
+vrd_wal_contained(vrd_WAL* const self, size_t* const offset);
+
+
+/**
+ * Ends a logged update: `keep` if applied, otherwise the record is cut
+ * off again.
+ */
+void
+vrd_wal_done(vrd_WAL* const self, bool const keep);
+
+
+int
+vrd_SNV_wal_insert(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   size_t const position,
+                   size_t const count,
+                   size_t const sample_id,
+                   size_t const phase,
+                   size_t const inserted);
+
+
+/**
+ * The sequence with index `inserted` is logged; the caller must hold
+ * off concurrent updates of the sequence table.
+ */
+int
+vrd_MNV_wal_insert(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   size_t const start,
+                   size_t const end,
+                   size_t const count,
+                   size_t const sample_id,
+                   size_t const phase,
+                   size_t const inserted);
+
+
+/**
+ * As vrd_MNV_wal_insert() with the inserted sequence (as stored in the
+ * sequence table) given; no lookup in the sequence table is needed.
+ */
+int
+vrd_MNV_wal_insert_sequence(vrd_WAL* const self,
+                            size_t const len,
+                            char const reference[len],
+                            size_t const start,
+                            size_t const end,
+                            size_t const count,
+                            size_t const sample_id,
+                            size_t const phase,
+                            size_t const len_seq,
+                            char const sequence[len_seq]);
+
+
+int
+vrd_Cov_wal_insert(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   size_t const start,
+                   size_t const end,
+                   size_t const count,
+                   size_t const sample_id);
+
+
+/**
+ * A removal is logged per reference.
+ */
+int
+vrd_SNV_wal_remove(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   vrd_AVL_Tree const* const subset);
+
+
+int
+vrd_MNV_wal_remove(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   vrd_AVL_Tree const* const subset);
+
+
+int
+vrd_MNV_wal_remove_seq(vrd_WAL* const self,
+                       size_t const len,
+                       char const reference[len],
+                       vrd_AVL_Tree const* const subset);
+
+
+int
+vrd_MNV_wal_compact_seq(vrd_WAL* const self);
+
+
+int
+vrd_Cov_wal_remove(vrd_WAL* const self,
+                   size_t const len,
+                   char const reference[len],
+                   vrd_AVL_Tree const* const subset);
+
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
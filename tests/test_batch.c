@@ -0,0 +1,157 @@
+#include <assert.h>     // assert
+#include <errno.h>      // EINVAL, errno
+#include <stdbool.h>    // false
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILE, fclose, fprintf, rewind, tmpfile
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+enum
+{
+    SAMPLES = 8,
+    LINES = 1000
+}; // sizes
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    FILE* variants[SAMPLES] = {NULL};
+    FILE* coverage[SAMPLES] = {NULL};
+    size_t sample_id[SAMPLES] = {0};
+
+    size_t total = 0;
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        sample_id[i] = i + 1;
+
+        variants[i] = tmpfile();
+        assert(NULL != variants[i]);
+        coverage[i] = tmpfile();
+        assert(NULL != coverage[i]);
+
+        for (size_t j = 0; j < LINES; ++j)
+        {
+            size_t const position = (j * 7919 + i * 104729) % 100000;
+            char const* const reference = (j % 3) == 0 ? "chr1" : (j % 3) == 1 ? "chr2" : "chrX";
+            if (0 == j % 5)
+            {
+                fprintf(variants[i], "%s %zu %zu 1 -1 3 A%cT\n", reference, position, position + 2, "ACGT"[i % 4]);
+            } // if
+            else
+            {
+                fprintf(variants[i], "%s %zu %zu 1 %zu 1 %c\n", reference, position, position + 1, i, "ACGT"[j % 4]);
+            } // else
+            fprintf(coverage[i], "%s %zu %zu 2\n", reference, position, position + 100);
+            total += 1;
+        } // for
+        rewind(variants[i]);
+        rewind(coverage[i]);
+    } // for
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv);
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1 << 16);
+    assert(NULL != mnv);
+    vrd_Seq_Table* seq = vrd_Seq_table_init(16);
+    assert(NULL != seq);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 16);
+    assert(NULL != cov);
+
+    size_t ret = vrd_variants_from_files(SAMPLES, variants, sample_id, snv, mnv, seq, 4);
+    assert(total == ret);
+
+    ret = vrd_coverage_from_files(SAMPLES, coverage, sample_id, cov, 4);
+    assert(total == ret);
+
+    // the same samples imported one by one
+    vrd_SNV_Table* snv_serial = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv_serial);
+    vrd_MNV_Table* mnv_serial = vrd_MNV_table_init(10, 1 << 16);
+    assert(NULL != mnv_serial);
+    vrd_Seq_Table* seq_serial = vrd_Seq_table_init(16);
+    assert(NULL != seq_serial);
+
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        rewind(variants[i]);
+        ret = vrd_variants_from_file(variants[i], snv_serial, mnv_serial, seq_serial, sample_id[i]);
+        assert(LINES == ret);
+    } // for
+
+    vrd_Trie_Node* const elem = vrd_Seq_table_query(seq, 4, "AAT");
+    assert(NULL != elem);
+    vrd_Trie_Node* const elem_serial = vrd_Seq_table_query(seq_serial, 4, "AAT");
+    assert(NULL != elem_serial);
+    assert(elem->count == elem_serial->count);
+
+    for (size_t position = 0; position < 100000; position += 7)
+    {
+        for (size_t k = 1; k < 5; ++k)
+        {
+            assert(vrd_SNV_table_query(snv, 5, "chr2", position, k, false, NULL) ==
+                   vrd_SNV_table_query(snv_serial, 5, "chr2", position, k, false, NULL));
+        } // for
+        assert(vrd_MNV_table_query(mnv, 5, "chrX", position, position + 2, (size_t) elem->data, false, NULL) ==
+               vrd_MNV_table_query(mnv_serial, 5, "chrX", position, position + 2, (size_t) elem_serial->data, false, NULL));
+    } // for
+
+    // sample 1 covers [0, 100) on chr1
+    ret = vrd_Cov_table_query_stab(cov, 5, "chr1", 50, 51, NULL);
+    assert(2 <= ret);
+
+    // a failing batch is rolled back
+    vrd_SNV_Table* small = vrd_SNV_table_init(1, 1 << 16);
+    assert(NULL != small);
+    vrd_MNV_Table* mnv_small = vrd_MNV_table_init(10, 1 << 16);
+    assert(NULL != mnv_small);
+    vrd_Seq_Table* seq_small = vrd_Seq_table_init(16);
+    assert(NULL != seq_small);
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        rewind(variants[i]);
+    } // for
+    ret = vrd_variants_from_files(SAMPLES, variants, sample_id, small, mnv_small, seq_small, 4);
+    assert((size_t) -1 == ret);
+
+    // a sample that cannot be staged fails the batch before any insert
+    FILE* invalid = tmpfile();
+    assert(NULL != invalid);
+    fprintf(invalid, "chr1 10 11 1 0 1 A\nchr1 20 22 1 0 2048 GG\n");
+    rewind(invalid);
+    size_t const invalid_id = 42;
+    errno = 0;
+    ret = vrd_variants_from_files(1, &invalid, &invalid_id, snv, mnv, seq, 2);
+    assert((size_t) -1 == ret);
+    assert(EINVAL == errno);
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+    assert(NULL != subset);
+    (void) vrd_AVL_tree_insert(subset, invalid_id);
+    assert(0 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('A'), false, subset));
+    vrd_AVL_tree_destroy(&subset);
+    fclose(invalid);
+
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        fclose(variants[i]);
+        fclose(coverage[i]);
+    } // for
+
+    vrd_Seq_table_destroy(&seq_small);
+    vrd_MNV_table_destroy(&mnv_small);
+    vrd_SNV_table_destroy(&small);
+    vrd_Seq_table_destroy(&seq_serial);
+    vrd_MNV_table_destroy(&mnv_serial);
+    vrd_SNV_table_destroy(&snv_serial);
+    vrd_Cov_table_destroy(&cov);
+    vrd_Seq_table_destroy(&seq);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+
+    return EXIT_SUCCESS;
+} // main
@@ -0,0 +1,266 @@
+#include <assert.h>     // assert
+#include <pthread.h>    // pthread_*
+#include <stdbool.h>    // false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // remove
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+enum
+{
+    ENTRIES = 5000,
+    BUFFER = 64
+}; // sizes
+
+
+// chr1 holds the SNVs at the even positions, chr2 those at the odd
+// ones; every third insert is homozygous
+static void
+insert(vrd_SNV_Table* const snv,
+       vrd_MNV_Table* const mnv,
+       vrd_Cov_Table* const cov,
+       size_t const sample_id)
+{
+    for (size_t i = 0; i < ENTRIES; ++i)
+    {
+        size_t const position = i * 7 % ENTRIES;
+        int ret = vrd_SNV_table_insert(snv, 4, 0 == i % 2 ? "chr1" : "chr2", position, 1, sample_id, 0 == i % 3 ? VRD_HOMOZYGOUS : 0, 1);
+        assert(0 == ret);
+        ret = vrd_MNV_table_insert(mnv, 4, "chr1", position, position + 2, 1, sample_id, 0, 5);
+        assert(0 == ret);
+        ret = vrd_Cov_table_insert(cov, 4, "chr1", i, i + 10, 1, sample_id);
+        assert(0 == ret);
+    } // for
+} // insert
+
+
+// Whether the SNV at `position` is homozygous: 2143 is the inverse of 7
+static bool
+homozygous_at(size_t const position)
+{
+    return 0 == position * 2143 % ENTRIES % 3;
+} // homozygous_at
+
+
+// The samples `first` up to and including `last` are in the tables
+static void
+check(vrd_SNV_Table const* const snv,
+      vrd_MNV_Table const* const mnv,
+      vrd_Cov_Table const* const cov,
+      size_t const first,
+      size_t const last)
+{
+    size_t const samples = last - first + 1;
+    for (size_t i = 0; i < ENTRIES; i += 13)
+    {
+        bool const even = 0 == i % 2;
+        bool const homozygous_i = homozygous_at(i);
+
+        size_t ret = vrd_SNV_table_query(snv, 4, "chr1", i, 1, false, NULL);
+        assert((even ? samples : 0) == ret);
+        ret = vrd_SNV_table_query(snv, 4, "chr2", i, 1, true, NULL);
+        assert((!even && homozygous_i ? samples : 0) == ret);
+
+        size_t homozygous = 0;
+        size_t carriers = 0;
+        ret = vrd_SNV_table_query_zygosity(snv, 4, "chr1", i, 1, NULL, &homozygous, &carriers);
+        assert((even ? samples : 0) == ret);
+        assert((even && homozygous_i ? samples : 0) == homozygous);
+        assert((even ? samples : 0) == carriers);
+
+        // every sample once at each even position in the region
+        vrd_SNV_Entry result[64] = {{0}};
+        size_t seen[20] = {0};
+        size_t const end = i + 20 < ENTRIES ? i + 20 : ENTRIES;
+        size_t const count = vrd_SNV_table_query_region(snv, 4, "chr1", i, i + 20, NULL, 64, result);
+        assert(samples * ((end - i + !even) / 2) == count);
+        for (size_t j = 0; j < count; ++j)
+        {
+            assert(i <= result[j].position && result[j].position < end);
+            assert(0 == result[j].position % 2);
+            assert(1 == result[j].allele_count);
+            assert(first <= result[j].sample_id && result[j].sample_id <= last);
+            assert((homozygous_at(result[j].position) ? (size_t) -1 : 0) == result[j].phase);
+            assert('A' == result[j].inserted);
+            seen[result[j].position - i] += 1;
+        } // for
+        for (size_t j = i; j < end; ++j)
+        {
+            assert((0 == j % 2 ? samples : 0) == seen[j - i]);
+        } // for
+
+        ret = vrd_MNV_table_query(mnv, 4, "chr1", i, i + 2, 5, false, NULL);
+        assert(samples == ret);
+        ret = vrd_Cov_table_query_stab(cov, 4, "chr1", i, i + 1, NULL);
+        assert(samples * (i < 9 ? i + 1 : 10) == ret);
+    } // for
+} // check
+
+
+static size_t
+entries(vrd_SNV_Table const* const snv, size_t* const height)
+{
+    vrd_Diagnostics* diag = NULL;
+    size_t const count = vrd_SNV_table_diagnostics(snv, &diag);
+    assert(2 == count);
+    size_t const total = diag[0].entries + diag[1].entries;
+    *height = diag[0].height;
+    for (size_t i = 0; i < count; ++i)
+    {
+        free(diag[i].reference);
+    } // for
+    free(diag);
+    return total;
+} // entries
+
+
+static void*
+merger(void* const arg)
+{
+    vrd_SNV_Table* const snv = arg;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        int const err = vrd_SNV_table_merge(snv);
+        assert(0 == err);
+    } // for
+    return NULL;
+} // merger
+
+
+// merging in the background while inserting and querying
+static void
+background(void)
+{
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv);
+    int err = vrd_SNV_table_buffer(snv, BUFFER);
+    assert(0 == err);
+
+    pthread_t thread;
+    err = pthread_create(&thread, NULL, merger, snv);
+    assert(0 == err);
+
+    for (size_t i = 0; i < ENTRIES; ++i)
+    {
+        int const ret = vrd_SNV_table_insert(snv, 4, "chr1", i % 100, 1, i, 0, 1);
+        assert(0 == ret);
+        assert(i / 100 + 1 == vrd_SNV_table_query(snv, 4, "chr1", i % 100, 1, false, NULL));
+    } // for
+
+    (void) pthread_join(thread, NULL);
+
+    err = vrd_SNV_table_merge(snv);
+    assert(0 == err);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        assert(ENTRIES / 100 == vrd_SNV_table_query(snv, 4, "chr1", i, 1, false, NULL));
+    } // for
+
+    vrd_SNV_table_destroy(&snv);
+} // background
+
+
+// the inserts merge the runs into the tree when all are in use
+static void
+full(void)
+{
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv);
+    int err = vrd_SNV_table_buffer(snv, 1);
+    assert(0 == err);
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        int ret = vrd_SNV_table_insert(snv, 4, "chr1", i % 100, 1, i, 0, 1);
+        assert(0 == ret);
+        ret = vrd_SNV_table_insert(snv, 4, "chr2", 0, 1, i, 0, 1);
+        assert(0 == ret);
+    } // for
+
+    size_t height = 0;
+    assert(2000 == entries(snv, &height));
+    assert(0 < height);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        assert(10 == vrd_SNV_table_query(snv, 4, "chr1", i, 1, false, NULL));
+    } // for
+
+    vrd_SNV_table_destroy(&snv);
+} // full
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv);
+    int err = vrd_SNV_table_buffer(snv, BUFFER);
+    assert(0 == err);
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1 << 16);
+    assert(NULL != mnv);
+    err = vrd_MNV_table_buffer(mnv, BUFFER);
+    assert(0 == err);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 16);
+    assert(NULL != cov);
+    err = vrd_Cov_table_buffer(cov, BUFFER);
+    assert(0 == err);
+
+    // the runs merge with each other: the inserts leave the tree empty
+    insert(snv, mnv, cov, 1);
+    check(snv, mnv, cov, 1, 1);
+
+    size_t height = 0;
+    assert(ENTRIES == entries(snv, &height));
+    assert(0 == height);
+
+    // a merged tree is balanced
+    err = vrd_SNV_table_merge(snv);
+    assert(0 == err);
+    assert(ENTRIES == entries(snv, &height));
+    assert(12 == height);
+    check(snv, mnv, cov, 1, 1);
+
+    // the runs and the buffer are written with the tree
+    insert(snv, mnv, cov, 2);
+    check(snv, mnv, cov, 1, 2);
+    err = vrd_SNV_table_write(snv, "test_buffer");
+    assert(0 == err);
+
+    vrd_SNV_Table* snv_read = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv_read);
+    err = vrd_SNV_table_read(snv_read, "test_buffer", 2);
+    assert(0 == err);
+    check(snv_read, mnv, cov, 1, 2);
+    vrd_SNV_table_destroy(&snv_read);
+
+    // a removal includes the runs and the buffer
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+    assert(NULL != subset);
+    (void) vrd_AVL_tree_insert(subset, 1);
+    size_t count = vrd_SNV_table_remove(snv, subset);
+    assert(ENTRIES == count);
+    count = vrd_MNV_table_remove(mnv, subset);
+    assert(ENTRIES == count);
+    count = vrd_Cov_table_remove(cov, subset);
+    assert(ENTRIES == count);
+    vrd_AVL_tree_destroy(&subset);
+    check(snv, mnv, cov, 2, 2);
+
+    vrd_SNV_table_destroy(&snv);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_Cov_table_destroy(&cov);
+
+    (void) remove("test_buffer.idx");
+    (void) remove("test_buffer_tree_0.bin");
+    (void) remove("test_buffer_tree_1.bin");
+
+    background();
+    full();
+
+    return EXIT_SUCCESS;
+} // main
@@ -0,0 +1,76 @@
+#include <assert.h>     // assert
+#include <stddef.h>     // NULL, size_t
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_Cohort_Table* cohorts = vrd_Cohort_table_init(3, 10);
+    assert(NULL != cohorts);
+    assert(3 == vrd_Cohort_table_count(cohorts));
+
+    int ret = vrd_Cohort_table_insert(cohorts, 0, 1);
+    assert(0 == ret);
+    ret = vrd_Cohort_table_insert(cohorts, 0, 2);
+    assert(0 == ret);
+    ret = vrd_Cohort_table_insert(cohorts, 1, 2);
+    assert(0 == ret);
+    ret = vrd_Cohort_table_insert(cohorts, 2, 3);
+    assert(0 == ret);
+
+    ret = vrd_Cohort_table_insert(cohorts, 3, 1);
+    assert(0 != ret);
+    ret = vrd_Cohort_table_insert(cohorts, 0, 10);
+    assert(0 != ret);
+
+    assert(0x3 == vrd_Cohort_table_mask(cohorts, 2));
+    assert(0 == vrd_Cohort_table_mask(cohorts, 100));
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1000);
+    assert(NULL != snv);
+
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 1, 0, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 2, 2, VRD_HOMOZYGOUS, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 3, 0, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+
+    size_t count[3] = {0};
+    ret = vrd_SNV_table_query_cohorts(snv, 5, "chr1", 10, vrd_iupac_to_idx('A'), cohorts, count);
+    assert(0 == ret);
+    assert(3 == count[0]);
+    assert(2 == count[1]);
+    assert(1 == count[2]);
+
+    ret = vrd_SNV_table_query_cohorts(snv, 5, "chr2", 10, vrd_iupac_to_idx('A'), cohorts, count);
+    assert(-1 == ret);
+
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1000);
+    assert(NULL != cov);
+
+    ret = vrd_Cov_table_insert(cov, 5, "chr1", 0, 20, 2, 1);
+    assert(0 == ret);
+    ret = vrd_Cov_table_insert(cov, 5, "chr1", 5, 15, 2, 3);
+    assert(0 == ret);
+
+    size_t den[3] = {0};
+    ret = vrd_Cov_table_query_stab_cohorts(cov, 5, "chr1", 10, 11, cohorts, den);
+    assert(0 == ret);
+    assert(2 == den[0]);
+    assert(0 == den[1]);
+    assert(2 == den[2]);
+
+    vrd_Cov_table_destroy(&cov);
+    vrd_SNV_table_destroy(&snv);
+    vrd_Cohort_table_destroy(&cohorts);
+    assert(NULL == cohorts);
+
+    return EXIT_SUCCESS;
+} // main
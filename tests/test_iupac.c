@@ -0,0 +1,68 @@
+#include <assert.h>     // assert
+#include <stddef.h>     // NULL, size_t
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    size_t const A = vrd_iupac_to_idx('A');
+    size_t const C = vrd_iupac_to_idx('C');
+    size_t const G = vrd_iupac_to_idx('G');
+    size_t const T = vrd_iupac_to_idx('T');
+
+    assert((A | C) == vrd_iupac_to_idx('M'));
+    assert((A | G) == vrd_iupac_to_idx('R'));
+    assert((C | G) == vrd_iupac_to_idx('S'));
+    assert((A | C | G) == vrd_iupac_to_idx('V'));
+    assert((A | T) == vrd_iupac_to_idx('W'));
+    assert((C | T) == vrd_iupac_to_idx('Y'));
+    assert((A | C | T) == vrd_iupac_to_idx('H'));
+    assert((G | T) == vrd_iupac_to_idx('K'));
+    assert((A | G | T) == vrd_iupac_to_idx('D'));
+    assert((C | G | T) == vrd_iupac_to_idx('B'));
+    assert((A | C | G | T) == vrd_iupac_to_idx('N'));
+    assert(T == vrd_iupac_to_idx('U'));
+
+    for (size_t i = 0; i < VRD_IUPAC_SIZE; ++i)
+    {
+        assert(i == vrd_iupac_to_idx(vrd_idx_to_iupac(i)));
+    } // for
+
+    assert(vrd_iupac_match(A, A));
+    assert(!vrd_iupac_match(A, C));
+    assert(vrd_iupac_match(vrd_iupac_to_idx('R'), A));
+    assert(vrd_iupac_match(vrd_iupac_to_idx('R'), G));
+    assert(!vrd_iupac_match(vrd_iupac_to_idx('R'), C));
+    assert(vrd_iupac_match(vrd_iupac_to_idx('N'), T));
+    assert(vrd_iupac_match(vrd_iupac_to_idx('.'), vrd_iupac_to_idx('.')));
+    assert(!vrd_iupac_match(vrd_iupac_to_idx('.'), A));
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1000);
+    assert(NULL != snv);
+
+    int ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 0, 0, A);
+    assert(0 == ret);
+
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 2, 1, 0, G);
+    assert(0 == ret);
+
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 2, 0, T);
+    assert(0 == ret);
+
+    assert(1 == vrd_SNV_table_query(snv, 5, "chr1", 10, A, false, NULL));
+    assert(3 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('R'), false, NULL));
+    assert(2 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('W'), false, NULL));
+    assert(4 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('N'), false, NULL));
+    assert(0 == vrd_SNV_table_query(snv, 5, "chr1", 10, C, false, NULL));
+
+    vrd_SNV_table_destroy(&snv);
+    assert(NULL == snv);
+
+    return EXIT_SUCCESS;
+} // main
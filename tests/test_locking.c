@@ -0,0 +1,169 @@
+#include <assert.h>     // assert
+#include <pthread.h>    // pthread_*
+#include <stdbool.h>    // bool, false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // snprintf
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+enum
+{
+    THREADS = 8,
+    INSERTS = 2000,
+    REFERENCES = 4
+}; // sizes
+
+
+struct Work
+{
+    vrd_SNV_Table* snv;
+    vrd_Cov_Table* cov;
+    size_t id;
+}; // Work
+
+
+static void*
+work(void* arg)
+{
+    struct Work const* const work = arg;
+
+    char reference[16] = {'\0'};
+    for (size_t i = 0; i < INSERTS; ++i)
+    {
+        // half of the threads share a reference, the others have their own
+        size_t const ref = 0 == work->id % 2 ? 0 : work->id % REFERENCES;
+        (void) snprintf(reference, sizeof(reference), "chr%zu", ref);
+
+        int ret = vrd_SNV_table_insert(work->snv, 5, reference, i, 1, work->id, 0, 1);
+        assert(0 == ret);
+        ret = vrd_Cov_table_insert(work->cov, 5, reference, i, i + 10, 1, work->id);
+        assert(0 == ret);
+
+        (void) vrd_SNV_table_query(work->snv, 5, reference, i, 1, false, NULL);
+    } // for
+
+    return NULL;
+} // work
+
+
+struct Query
+{
+    vrd_SNV_Table const* snv;
+    bool const* done;
+    pthread_mutex_t* lock;
+}; // Query
+
+
+static bool
+is_done(struct Query const* const query)
+{
+    (void) pthread_mutex_lock(query->lock);
+    bool const done = *query->done;
+    (void) pthread_mutex_unlock(query->lock);
+    return done;
+} // is_done
+
+
+// queries on chr0 during removal and reordering see either all or all
+// but one of the samples
+static void*
+query(void* arg)
+{
+    struct Query const* const query = arg;
+
+    while (!is_done(query))
+    {
+        for (size_t i = 0; i < INSERTS; i += 97)
+        {
+            size_t const ret = vrd_SNV_table_query(query->snv, 5, "chr0", i, 1, false, NULL);
+            assert(4 == ret || 3 == ret);
+        } // for
+    } // while
+
+    return NULL;
+} // query
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(REFERENCES, THREADS * INSERTS);
+    assert(NULL != snv);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(REFERENCES, THREADS * INSERTS);
+    assert(NULL != cov);
+
+    pthread_t threads[THREADS];
+    struct Work works[THREADS];
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        works[i] = (struct Work) {.snv = snv, .cov = cov, .id = i};
+        int const ret = pthread_create(&threads[i], NULL, work, &works[i]);
+        assert(0 == ret);
+    } // for
+
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        int const ret = pthread_join(threads[i], NULL);
+        assert(0 == ret);
+    } // for
+
+    // threads 0, 2, 4, 6 on chr0; 1, 5 on chr1; 3, 7 on chr3
+    size_t ret = vrd_SNV_table_query(snv, 5, "chr0", 100, 1, false, NULL);
+    assert(4 == ret);
+    ret = vrd_SNV_table_query(snv, 5, "chr1", 100, 1, false, NULL);
+    assert(2 == ret);
+    ret = vrd_SNV_table_query(snv, 5, "chr3", 100, 1, false, NULL);
+    assert(2 == ret);
+    ret = vrd_SNV_table_query(snv, 5, "chr2", 100, 1, false, NULL);
+    assert((size_t) -1 == ret);
+
+    ret = vrd_Cov_table_query_stab(cov, 5, "chr0", 100, 101, NULL);
+    assert(4 * 10 == ret);
+
+    bool done = false;
+    pthread_mutex_t lock;
+    int err = pthread_mutex_init(&lock, NULL);
+    assert(0 == err);
+
+    struct Query queries[THREADS];
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        queries[i] = (struct Query) {.snv = snv, .done = &done, .lock = &lock};
+        err = pthread_create(&threads[i], NULL, query, &queries[i]);
+        assert(0 == err);
+    } // for
+
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+    assert(NULL != subset);
+    (void) vrd_AVL_tree_insert(subset, 2);
+    ret = vrd_SNV_table_remove(snv, subset);
+    assert(INSERTS == ret);
+    err = vrd_SNV_table_reorder(snv);
+    assert(0 == err);
+
+    (void) pthread_mutex_lock(&lock);
+    done = true;
+    (void) pthread_mutex_unlock(&lock);
+
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        err = pthread_join(threads[i], NULL);
+        assert(0 == err);
+    } // for
+    (void) pthread_mutex_destroy(&lock);
+
+    ret = vrd_SNV_table_query(snv, 5, "chr0", 100, 1, false, NULL);
+    assert(3 == ret);
+
+    vrd_AVL_tree_destroy(&subset);
+
+    vrd_Cov_table_destroy(&cov);
+    vrd_SNV_table_destroy(&snv);
+
+    return EXIT_SUCCESS;
+} // main
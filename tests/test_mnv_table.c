@@ -1,10 +1,10 @@
 #include <assert.h>     // assert
 #include <stddef.h>     // NULL, size_t
-#include <stdio.h>      // FILE, fopen, fclose, fprintf, stderr
-#include <stdlib.h>     // EXIT_*
+#include <stdio.h>      // FILE, fopen, fclose, fprintf, remove, stderr
+#include <stdlib.h>     // EXIT_*, free
+#include <string.h>     // strcmp
 
 #include "../include/varda.h"   // vrd_*
-#include "../src/mnv_tree.h"    // vrd_MNV_unpack
 
 
 int
@@ -28,24 +28,79 @@ main(int argc, char* argv[])
     ret = vrd_MNV_table_insert(mnv, 5, "chr1", 5, 6, 1, 1, 10, *(size_t*) elem);
     assert(0 == ret);
 
-    void* result[10] = {0};
+    ret = vrd_MNV_table_insert(mnv, 5, "chr1", 10, 20, 2, 2, VRD_HOMOZYGOUS, *(size_t*) elem);
+    assert(0 == ret);
+
+    size_t homozygous_count = 0;
+    size_t carriers = 0;
+    size_t const zygosity_count = vrd_MNV_table_query_zygosity(mnv, 5, "chr1", 10, 20, *(size_t*) elem, NULL, &homozygous_count, &carriers);
+    assert(3 == zygosity_count);
+    assert(2 == homozygous_count);
+    assert(2 == carriers);
+
+    vrd_MNV_Entry result[10] = {{0}};
 
     size_t const region_count = vrd_MNV_table_query_region(mnv, 5, "chr1", 0, 40, NULL, 10, result);
     for (size_t i = 0; i < region_count; ++i)
     {
-        size_t start = 0;
-        size_t end = 0;
-        size_t allele_count = 0;
-        size_t sample_id = 0;
-        size_t phase = 0;
-        size_t inserted = 0;
-        vrd_MNV_unpack(result[i], &start, &end, &allele_count, &sample_id, &phase, &inserted);
-
-        (void) fprintf(stderr, "%zu: %zu--%zu\n", i, start, end);
+        (void) fprintf(stderr, "%zu: %zu--%zu\n", i, result[i].start, result[i].end);
     } // for
 
 
 
+    // compact the sequence table after removing a sample
+    vrd_Trie_Node* const gap = vrd_Seq_table_insert(seq, 5, "CCCC");
+    assert(NULL != gap);
+    vrd_Trie_Node* const last = vrd_Seq_table_insert(seq, 5, "GGGG");
+    assert(NULL != last);
+    assert(2 == *(size_t*) last);
+    ret = vrd_MNV_table_insert(mnv, 5, "chr2", 1, 2, 1, 3, 0, *(size_t*) gap);
+    assert(0 == ret);
+    ret = vrd_MNV_table_insert(mnv, 5, "chr2", 3, 4, 1, 4, 0, *(size_t*) last);
+    assert(0 == ret);
+
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+    assert(NULL != subset);
+    ret = vrd_AVL_tree_insert(subset, 3);
+    assert(0 == ret);
+    assert(1 == vrd_MNV_table_remove_seq(mnv, subset, seq));
+    vrd_AVL_tree_destroy(&subset);
+    assert(NULL == vrd_Seq_table_query(seq, 5, "CCCC"));
+
+    ret = vrd_MNV_table_compact_seq(mnv, seq);
+    assert(0 == ret);
+    assert(1 == *(size_t*) vrd_Seq_table_query(seq, 5, "GGGG"));
+    assert(1 == vrd_MNV_table_query(mnv, 5, "chr2", 3, 4, 1, false, NULL));
+    assert(0 == vrd_MNV_table_query(mnv, 5, "chr2", 3, 4, 2, false, NULL));
+    assert(3 == vrd_MNV_table_query(mnv, 5, "chr1", 10, 20, 0, false, NULL));
+
+    char* key = NULL;
+    assert(0 < vrd_Seq_table_key(seq, 1, &key));
+    assert(0 == strcmp("GGGG", key));
+    free(key);
+    assert(2 == (size_t) vrd_Seq_table_insert(seq, 5, "TTTT")->data);
+
+    // a tree that cannot be loaded leaves both tables untouched
+    ret = vrd_MNV_table_write(mnv, "test_mnv_table");
+    assert(0 == ret);
+    vrd_MNV_Table* lazy = vrd_MNV_table_init(1000, 1 << 24);
+    assert(NULL != lazy);
+    ret = vrd_MNV_table_read_lazy(lazy, "test_mnv_table", 0);
+    assert(0 == ret);
+    (void) remove("test_mnv_table_tree_1.bin");
+
+    assert(3 == (size_t) vrd_Seq_table_insert(seq, 5, "CCCC")->data);
+    ret = vrd_Seq_table_remove(seq, 2);
+    assert(0 == ret);
+    ret = vrd_MNV_table_compact_seq(lazy, seq);
+    assert(-1 == ret);
+    assert(3 == *(size_t*) vrd_Seq_table_query(seq, 5, "CCCC"));
+    assert(3 == vrd_MNV_table_query(lazy, 5, "chr1", 10, 20, 0, false, NULL));
+
+    vrd_MNV_table_destroy(&lazy);
+    (void) remove("test_mnv_table.idx");
+    (void) remove("test_mnv_table_tree_0.bin");
+
 /*
     FILE* stream = fopen("mnv_export.varda", "w");
     assert(NULL != stream);
@@ -0,0 +1,150 @@
+#include <assert.h>     // assert
+#include <stdbool.h>    // false
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILE, FILENAME_MAX, fclose, fgets, fopen, remove
+#include <stdlib.h>     // EXIT_*
+#include <string.h>     // strstr
+
+#include "../include/varda.h"   // vrd_*
+
+
+enum
+{
+    ENTRIES = 5000
+}; // sizes
+
+
+// The paged trees are mappings of removed files in the directory, one
+// per tree
+static size_t
+mappings(void)
+{
+    FILE* const stream = fopen("/proc/self/maps", "r");
+    assert(NULL != stream);
+
+    size_t count = 0;
+    char line[FILENAME_MAX + 128] = {'\0'};
+    while (NULL != fgets(line, sizeof(line), stream))
+    {
+        count += NULL != strstr(line, "/varda_") && NULL != strstr(line, "(deleted)");
+    } // while
+    (void) fclose(stream);
+    return count;
+} // mappings
+
+
+// chr1 holds the even positions, chr2 the odd ones
+static void
+insert(vrd_SNV_Table* const snv, vrd_Cov_Table* const cov, size_t const sample_id)
+{
+    for (size_t i = 0; i < ENTRIES; ++i)
+    {
+        int ret = vrd_SNV_table_insert(snv, 4, 0 == i % 2 ? "chr1" : "chr2", i * 7 % ENTRIES, 1, sample_id, 0, 1);
+        assert(0 == ret);
+        ret = vrd_Cov_table_insert(cov, 4, "chr1", i, i + 10, 1, sample_id);
+        assert(0 == ret);
+    } // for
+} // insert
+
+
+static void
+check(vrd_SNV_Table const* const snv, vrd_Cov_Table const* const cov, size_t const samples)
+{
+    for (size_t i = 0; i < ENTRIES; i += 13)
+    {
+        size_t ret = vrd_SNV_table_query(snv, 4, "chr1", i, 1, false, NULL);
+        assert((0 == i % 2 ? samples : 0) == ret);
+        ret = vrd_SNV_table_query(snv, 4, "chr2", i, 1, false, NULL);
+        assert((0 == i % 2 ? 0 : samples) == ret);
+
+        if (NULL != cov)
+        {
+            ret = vrd_Cov_table_query_stab(cov, 4, "chr1", i, i + 1, NULL);
+            assert(samples * (i < 9 ? i + 1 : 10) == ret);
+        } // if
+    } // for
+} // check
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv);
+    int err = vrd_SNV_table_paged(snv, ".");
+    assert(0 == err);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 16);
+    assert(NULL != cov);
+    err = vrd_Cov_table_paged(cov, ".");
+    assert(0 == err);
+
+    insert(snv, cov, 1);
+    insert(snv, cov, 2);
+    check(snv, cov, 2);
+
+    // the nodes of the three trees are backed by files
+    assert(3 == mappings());
+
+    // bulk updates work on (paged) copies
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+    assert(NULL != subset);
+    (void) vrd_AVL_tree_insert(subset, 1);
+    size_t count = vrd_SNV_table_remove(snv, subset);
+    assert(ENTRIES == count);
+    count = vrd_Cov_table_remove(cov, subset);
+    assert(ENTRIES == count);
+    vrd_AVL_tree_destroy(&subset);
+
+    err = vrd_SNV_table_reorder(snv);
+    assert(0 == err);
+    err = vrd_Cov_table_reorder(cov);
+    assert(0 == err);
+    check(snv, cov, 1);
+    assert(3 == mappings());
+
+    // read into paged trees
+    err = vrd_SNV_table_write(snv, "test_paged_snv");
+    assert(0 == err);
+    vrd_SNV_table_destroy(&snv);
+    assert(1 == mappings());
+
+    snv = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv);
+    err = vrd_SNV_table_paged(snv, ".");
+    assert(0 == err);
+    err = vrd_SNV_table_read(snv, "test_paged_snv", 2);
+    assert(0 == err);
+    check(snv, NULL, 1);
+    assert(3 == mappings());
+
+    // the trees of a table that is not paged are in memory
+    vrd_SNV_Table* memory = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != memory);
+    err = vrd_SNV_table_read(memory, "test_paged_snv", 2);
+    assert(0 == err);
+    check(memory, NULL, 1);
+    assert(3 == mappings());
+    vrd_SNV_table_destroy(&memory);
+
+    // a directory that does not exist
+    vrd_SNV_Table* missing = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != missing);
+    err = vrd_SNV_table_paged(missing, "test_paged_missing");
+    assert(0 == err);
+    int const ret = vrd_SNV_table_insert(missing, 4, "chr1", 1, 1, 1, 0, 1);
+    assert(0 != ret);
+    vrd_SNV_table_destroy(&missing);
+
+    vrd_Cov_table_destroy(&cov);
+    vrd_SNV_table_destroy(&snv);
+    assert(0 == mappings());
+
+    (void) remove("test_paged_snv.idx");
+    (void) remove("test_paged_snv_tree_0.bin");
+    (void) remove("test_paged_snv_tree_1.bin");
+
+    return EXIT_SUCCESS;
+} // main
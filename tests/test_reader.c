@@ -0,0 +1,156 @@
+#include <assert.h>     // assert
+#include <stddef.h>     // NULL, size_t
+#include <stdint.h>     // uint32_t
+#include <stdio.h>      // FILE, SEEK_END, fclose, fgetc, fputc, fread, fseek, fwrite, rewind, tmpfile
+#include <stdlib.h>     // EXIT_*, free, malloc
+#include <string.h>     // memcmp
+
+#include <zlib.h>       // Z_*, crc32, deflate*, z_stream
+
+#include "../include/varda.h"   // vrd_*
+
+
+static size_t const SIZE = 1 << 20;
+
+
+static void
+put_le(FILE* const stream, uint32_t const value, size_t const bytes)
+{
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        fputc((value >> (8 * i)) & 0xFF, stream);
+    } // for
+} // put_le
+
+
+// Writes a single BGZF block as bgzip does
+static void
+bgzf_block(FILE* const stream, size_t const len, unsigned char const data[len])
+{
+    unsigned char buffer[1 << 16];
+
+    z_stream zs = {0};
+    int ret = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+    assert(Z_OK == ret);
+    zs.next_in = (unsigned char*) data;
+    zs.avail_in = len;
+    zs.next_out = buffer;
+    zs.avail_out = sizeof(buffer);
+    ret = deflate(&zs, Z_FINISH);
+    assert(Z_STREAM_END == ret);
+    size_t const size = sizeof(buffer) - zs.avail_out;
+    deflateEnd(&zs);
+
+    unsigned char const header[] = {0x1F, 0x8B, 8, 4, 0, 0, 0, 0, 0, 0xFF, 6, 0, 'B', 'C', 2, 0};
+    fwrite(header, 1, sizeof(header), stream);
+    put_le(stream, size + 18 + 8 - 1, 2);
+    fwrite(buffer, 1, size, stream);
+    put_le(stream, crc32(crc32(0, Z_NULL, 0), data, len), 4);
+    put_le(stream, len, 4);
+} // bgzf_block
+
+
+static void
+check(FILE* const stream, size_t const threads, unsigned char const expected[SIZE], int const error)
+{
+    rewind(stream);
+
+    vrd_Reader* reader = vrd_reader_open(stream, threads);
+    assert(NULL != reader);
+
+    unsigned char* const data = malloc(SIZE + 1);
+    assert(NULL != data);
+
+    size_t const count = fread(data, 1, SIZE + 1, vrd_reader_stream(reader));
+    if (0 == error)
+    {
+        assert(SIZE == count);
+        assert(0 == memcmp(data, expected, SIZE));
+    } // if
+
+    int const ret = vrd_reader_close(&reader);
+    assert(error == ret);
+    assert(NULL == reader);
+
+    free(data);
+} // check
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    unsigned char* const data = malloc(SIZE);
+    assert(NULL != data);
+    for (size_t i = 0; i < SIZE; ++i)
+    {
+        data[i] = "ACGT\n"[(i * 7 + i / 13) % 5];
+    } // for
+
+    // uncompressed
+    FILE* plain = tmpfile();
+    assert(NULL != plain);
+    fwrite(data, 1, SIZE, plain);
+    check(plain, 1, data, 0);
+    fclose(plain);
+
+    // gzip with two concatenated members
+    FILE* gzip = tmpfile();
+    assert(NULL != gzip);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        z_stream zs = {0};
+        int ret = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+        assert(Z_OK == ret);
+
+        unsigned char* const buffer = malloc(SIZE);
+        assert(NULL != buffer);
+        zs.next_in = data + i * SIZE / 2;
+        zs.avail_in = SIZE / 2;
+        zs.next_out = buffer;
+        zs.avail_out = SIZE;
+        ret = deflate(&zs, Z_FINISH);
+        assert(Z_STREAM_END == ret);
+        fwrite(buffer, 1, SIZE - zs.avail_out, gzip);
+        deflateEnd(&zs);
+        free(buffer);
+    } // for
+    check(gzip, 1, data, 0);
+    fclose(gzip);
+
+    // BGZF with an end-of-file marker
+    FILE* bgzf = tmpfile();
+    assert(NULL != bgzf);
+    for (size_t i = 0; i < SIZE; i += 60000)
+    {
+        bgzf_block(bgzf, SIZE - i < 60000 ? SIZE - i : 60000, data + i);
+    } // for
+    bgzf_block(bgzf, 0, data);
+    check(bgzf, 1, data, 0);
+    check(bgzf, 4, data, 0);
+    check(bgzf, 64, data, 0);
+
+    // corrupt block
+    fseek(bgzf, -5, SEEK_END);
+    fputc(0xFF, bgzf);
+    check(bgzf, 4, data, -1);
+    fclose(bgzf);
+
+    // stop reading early
+    gzip = tmpfile();
+    assert(NULL != gzip);
+    bgzf_block(gzip, 60000, data);
+    rewind(gzip);
+    vrd_Reader* reader = vrd_reader_open(gzip, 2);
+    assert(NULL != reader);
+    (void) fgetc(vrd_reader_stream(reader));
+    int const ret = vrd_reader_close(&reader);
+    assert(0 == ret);
+    fclose(gzip);
+
+    free(data);
+
+    return EXIT_SUCCESS;
+} // main
@@ -0,0 +1,94 @@
+#include <assert.h>     // assert
+#include <stdbool.h>    // false
+#include <stddef.h>     // NULL, size_t
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_Sample_Attributes* attributes = vrd_Sample_attributes_init(70, 3);
+    assert(NULL != attributes);
+
+    int ret = vrd_Sample_attributes_insert(attributes, 11, "sex=female", 1);
+    assert(0 == ret);
+    ret = vrd_Sample_attributes_insert(attributes, 11, "sex=female", 2);
+    assert(0 == ret);
+    ret = vrd_Sample_attributes_insert(attributes, 11, "sex=female", 65);
+    assert(0 == ret);
+    ret = vrd_Sample_attributes_insert(attributes, 13, "population=X", 2);
+    assert(0 == ret);
+    ret = vrd_Sample_attributes_insert(attributes, 13, "population=X", 3);
+    assert(0 == ret);
+    ret = vrd_Sample_attributes_insert(attributes, 9, "sex=male", 70);
+    assert(-1 == ret);
+    ret = vrd_Sample_attributes_insert(attributes, 9, "sex=male", 3);
+    assert(0 == ret);
+    ret = vrd_Sample_attributes_insert(attributes, 13, "population=Y", 0);
+    assert(-1 == ret);
+
+    vrd_Predicate const female_not_x[] =
+    {
+        {VRD_PREDICATE_LABEL, 11, "sex=female"},
+        {VRD_PREDICATE_LABEL, 13, "population=X"},
+        {VRD_PREDICATE_NOT, 0, NULL},
+        {VRD_PREDICATE_AND, 0, NULL}
+    };
+    vrd_AVL_Tree* subset = vrd_Sample_attributes_select(attributes, 4, female_not_x);
+    assert(NULL != subset);
+    assert(vrd_AVL_tree_is_element(subset, 1));
+    assert(!vrd_AVL_tree_is_element(subset, 2));
+    assert(vrd_AVL_tree_is_element(subset, 65));
+    assert(!vrd_AVL_tree_is_element(subset, 3));
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1000);
+    assert(NULL != snv);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 1, 0, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 2, 0, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+    assert(1 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('A'), false, subset));
+    vrd_SNV_table_destroy(&snv);
+    vrd_AVL_tree_destroy(&subset);
+
+    vrd_Predicate const none[] =
+    {
+        {VRD_PREDICATE_LABEL, 11, "sex=female"},
+        {VRD_PREDICATE_LABEL, 9, "sex=male"},
+        {VRD_PREDICATE_OR, 0, NULL},
+        {VRD_PREDICATE_NOT, 0, NULL}
+    };
+    subset = vrd_Sample_attributes_select(attributes, 4, none);
+    assert(NULL != subset);
+    assert(vrd_AVL_tree_is_element(subset, 0));
+    assert(vrd_AVL_tree_is_element(subset, 69));
+    assert(!vrd_AVL_tree_is_element(subset, 70));
+    assert(!vrd_AVL_tree_is_element(subset, 3));
+    vrd_AVL_tree_destroy(&subset);
+
+    vrd_Predicate const unknown[] =
+    {
+        {VRD_PREDICATE_LABEL, 5, "none"}
+    };
+    subset = vrd_Sample_attributes_select(attributes, 1, unknown);
+    assert(NULL != subset);
+    assert(!vrd_AVL_tree_is_element(subset, 0));
+    vrd_AVL_tree_destroy(&subset);
+
+    vrd_Predicate const malformed[] =
+    {
+        {VRD_PREDICATE_LABEL, 11, "sex=female"},
+        {VRD_PREDICATE_AND, 0, NULL}
+    };
+    assert(NULL == vrd_Sample_attributes_select(attributes, 2, malformed));
+    assert(NULL == vrd_Sample_attributes_select(attributes, 0, malformed));
+
+    vrd_Sample_attributes_destroy(&attributes);
+
+    return EXIT_SUCCESS;
+} // main
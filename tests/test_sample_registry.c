@@ -0,0 +1,80 @@
+#include <assert.h>     // assert
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // remove
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_Sample_Registry* registry = vrd_Sample_registry_init(2);
+    assert(NULL != registry);
+
+    vrd_AVL_Tree* cases = vrd_AVL_tree_init(10);
+    assert(NULL != cases);
+    int ret = vrd_AVL_tree_insert(cases, 1);
+    assert(0 == ret);
+    ret = vrd_AVL_tree_insert(cases, 3);
+    assert(0 == ret);
+
+    ret = vrd_Sample_registry_insert(registry, 6, "cases", cases);
+    assert(0 == ret);
+
+    vrd_AVL_Tree* other = vrd_AVL_tree_init(10);
+    assert(NULL != other);
+    ret = vrd_Sample_registry_insert(registry, 6, "cases", other);
+    assert(-1 == ret);
+
+    ret = vrd_AVL_tree_insert(other, 2);
+    assert(0 == ret);
+    ret = vrd_Sample_registry_insert(registry, 9, "controls", other);
+    assert(0 == ret);
+
+    vrd_AVL_Tree* full = vrd_AVL_tree_init(10);
+    assert(NULL != full);
+    ret = vrd_Sample_registry_insert(registry, 5, "full", full);
+    assert(-1 == ret);
+    vrd_AVL_tree_destroy(&full);
+
+    assert(cases == vrd_Sample_registry_find(registry, 6, "cases"));
+    assert(NULL == vrd_Sample_registry_find(registry, 5, "none"));
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1000);
+    assert(NULL != snv);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 1, 0, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 2, 0, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+
+    assert(2 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('A'), false, NULL));
+    assert(1 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('A'), false, vrd_Sample_registry_find(registry, 6, "cases")));
+
+    ret = vrd_Sample_registry_write(registry, "registry");
+    assert(0 == ret);
+    vrd_Sample_registry_destroy(&registry);
+
+    registry = vrd_Sample_registry_init(2);
+    assert(NULL != registry);
+    ret = vrd_Sample_registry_read(registry, "registry");
+    assert(0 == ret);
+
+    vrd_AVL_Tree const* const read = vrd_Sample_registry_find(registry, 9, "controls");
+    assert(NULL != read);
+    assert(vrd_AVL_tree_is_element(read, 2));
+    assert(!vrd_AVL_tree_is_element(read, 1));
+    assert(1 == vrd_SNV_table_query(snv, 5, "chr1", 10, vrd_iupac_to_idx('A'), false, vrd_Sample_registry_find(registry, 6, "cases")));
+
+    vrd_SNV_table_destroy(&snv);
+    vrd_Sample_registry_destroy(&registry);
+
+    assert(0 == remove("registry.idx"));
+    assert(0 == remove("registry_tree_0.bin"));
+    assert(0 == remove("registry_tree_1.bin"));
+
+    return EXIT_SUCCESS;
+} // main
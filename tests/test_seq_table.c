@@ -1,7 +1,8 @@
 #include <assert.h>     // assert
 #include <stddef.h>     // NULL, size_t
-#include <stdio.h>      // fprintf, stderr
-#include <stdlib.h>     // EXIT_*
+#include <stdio.h>      // fprintf, remove, snprintf, stderr
+#include <stdlib.h>     // EXIT_*, free
+#include <string.h>     // strcmp, strlen
 
 #include "../include/varda.h"   // vrd_*
 
@@ -49,5 +50,181 @@ main(int argc, char* argv[])
     vrd_Seq_table_destroy(&seq);
     assert(NULL == seq);
 
+    // write and read back a table with gaps and reference counts
+    seq = vrd_Seq_table_init(5);
+    assert(NULL != seq);
+
+    vrd_Trie_Node* elem = NULL;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        elem = vrd_Seq_table_insert(seq, 2, "A");
+        assert(NULL != elem);
+    } // for
+    elem = vrd_Seq_table_insert(seq, 2, "C");
+    assert(NULL != elem);
+    elem = vrd_Seq_table_insert(seq, 2, "G");
+    assert(NULL != elem);
+    elem = vrd_Seq_table_insert(seq, 2, "T");
+    assert(NULL != elem);
+    ret = vrd_Seq_table_remove(seq, 1);
+    assert(0 == ret);
+    ret = vrd_Seq_table_remove(seq, 2);
+    assert(0 == ret);
+
+    ret = vrd_Seq_table_write(seq, "seq_table");
+    assert(0 == ret);
+    vrd_Seq_table_destroy(&seq);
+
+    seq = vrd_Seq_table_init(5);
+    assert(NULL != seq);
+    ret = vrd_Seq_table_read(seq, "seq_table");
+    assert(0 == ret);
+    ret = remove("seq_table.idx");
+    assert(0 == ret);
+
+    vrd_Trie_Node* const f = vrd_Seq_table_query(seq, 2, "A");
+    assert(NULL != f);
+    assert(0 == (size_t) f->data);
+    assert(3 == f->count);
+    assert(NULL == vrd_Seq_table_query(seq, 2, "C"));
+    assert(3 == (size_t) vrd_Seq_table_query(seq, 2, "T")->data);
+
+    // the gaps are reused first, the table grows afterwards
+    elem = vrd_Seq_table_insert(seq, 3, "AA");
+    assert(NULL != elem && 1 == (size_t) elem->data);
+    elem = vrd_Seq_table_insert(seq, 3, "CC");
+    assert(NULL != elem && 2 == (size_t) elem->data);
+    elem = vrd_Seq_table_insert(seq, 3, "GG");
+    assert(NULL != elem && 4 == (size_t) elem->data);
+    elem = vrd_Seq_table_insert(seq, 3, "TT");
+    assert(NULL != elem && 5 == (size_t) elem->data);
+    assert(3 == (size_t) vrd_Seq_table_query(seq, 2, "T")->data);
+
+    vrd_Seq_table_destroy(&seq);
+
+    // fragment a table that spans several bitmap levels
+    seq = vrd_Seq_table_init(5000);
+    assert(NULL != seq);
+
+    char sequence[8] = {'\0'};
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        (void) snprintf(sequence, sizeof(sequence), "%zu", i);
+        elem = vrd_Seq_table_insert(seq, strlen(sequence) + 1, sequence);
+        assert(NULL != elem && i == (size_t) elem->data);
+    } // for
+
+    for (size_t i = 4999; i > 100; i -= 7)
+    {
+        ret = vrd_Seq_table_remove(seq, i);
+        assert(0 == ret);
+    } // for
+    ret = vrd_Seq_table_remove(seq, 4999);
+    assert(0 == ret);
+
+    vrd_Diagnostics* diag = NULL;
+    size_t const count = vrd_Seq_table_diagnostics(seq, &diag);
+    assert(1 == count);
+    assert(5000 - 700 == diag[0].entries);
+    free(diag);
+
+    size_t last = 0;
+    for (size_t i = 0; i < 700; ++i)
+    {
+        (void) snprintf(sequence, sizeof(sequence), "N%zu", i);
+        elem = vrd_Seq_table_insert(seq, strlen(sequence) + 1, sequence);
+        assert(NULL != elem && (size_t) elem->data > last);
+        last = (size_t) elem->data;
+    } // for
+    assert(4999 == last);
+    elem = vrd_Seq_table_insert(seq, 2, "A");
+    assert(NULL != elem && 5000 == (size_t) elem->data);
+
+    vrd_Seq_table_destroy(&seq);
+
+    // grow from an empty table, the indices remain stable
+    seq = vrd_Seq_table_init(0);
+    assert(NULL != seq);
+
+    vrd_Trie_Node* nodes[100] = {NULL};
+    for (size_t i = 0; i < 100; ++i)
+    {
+        (void) snprintf(sequence, sizeof(sequence), "%zu", i);
+        nodes[i] = vrd_Seq_table_insert(seq, strlen(sequence) + 1, sequence);
+        assert(NULL != nodes[i]);
+        assert(i == (size_t) nodes[i]->data);
+    } // for
+
+    char* key = NULL;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        (void) snprintf(sequence, sizeof(sequence), "%zu", i);
+        assert(nodes[i] == vrd_Seq_table_query(seq, strlen(sequence) + 1, sequence));
+        size_t const len = vrd_Seq_table_key(seq, i, &key);
+        assert(0 < len);
+        assert(0 == strcmp(sequence, key));
+    } // for
+    free(key);
+
+    ret = vrd_Seq_table_write(seq, "seq_table");
+    assert(0 == ret);
+    vrd_Seq_table_destroy(&seq);
+
+    // reading grows the table as well
+    seq = vrd_Seq_table_init(1);
+    assert(NULL != seq);
+    ret = vrd_Seq_table_read(seq, "seq_table");
+    assert(0 == ret);
+    ret = remove("seq_table.idx");
+    assert(0 == ret);
+    assert(99 == (size_t) vrd_Seq_table_query(seq, 3, "99")->data);
+    elem = vrd_Seq_table_insert(seq, 2, "A");
+    assert(NULL != elem && 100 == (size_t) elem->data);
+
+    vrd_Seq_table_destroy(&seq);
+
+    // churn the hash index: many references, removals and reinsertions
+    seq = vrd_Seq_table_init(16);
+    assert(NULL != seq);
+
+    for (size_t j = 0; j < 2; ++j)
+    {
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            (void) snprintf(sequence, sizeof(sequence), "%zu", i);
+            elem = vrd_Seq_table_insert(seq, strlen(sequence) + 1, sequence);
+            assert(NULL != elem && i == (size_t) elem->data);
+        } // for
+    } // for
+    assert(2 == vrd_Seq_table_query(seq, 3, "42")->count);
+
+    for (size_t j = 0; j < 2; ++j)
+    {
+        for (size_t i = 0; i < 2000; i += 2)
+        {
+            ret = vrd_Seq_table_remove(seq, i);
+            assert(0 == ret);
+        } // for
+    } // for
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        (void) snprintf(sequence, sizeof(sequence), "%zu", i);
+        vrd_Trie_Node const* const node = vrd_Seq_table_query(seq, strlen(sequence) + 1, sequence);
+        assert((0 == i % 2) == (NULL == node));
+    } // for
+
+    for (size_t i = 0; i < 2000; i += 2)
+    {
+        (void) snprintf(sequence, sizeof(sequence), "X%zu", i);
+        elem = vrd_Seq_table_insert(seq, strlen(sequence) + 1, sequence);
+        assert(NULL != elem);
+        assert(NULL != vrd_Seq_table_query(seq, strlen(sequence) + 1, sequence));
+    } // for
+    assert(NULL == vrd_Seq_table_query(seq, 2, "0"));
+    assert(1 == (size_t) vrd_Seq_table_query(seq, 2, "1")->data);
+
+    vrd_Seq_table_destroy(&seq);
+
     return EXIT_SUCCESS;
 } // main
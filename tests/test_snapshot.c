@@ -0,0 +1,301 @@
+#include <assert.h>     // assert
+#include <stdbool.h>    // false
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILE, FILENAME_MAX, fclose, fopen, remove,
+                        // snprintf
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+static char const PATH[] = "test_snapshot";
+
+
+static bool
+exists(char const* const filename)
+{
+    FILE* const stream = fopen(filename, "rb");
+    if (NULL == stream)
+    {
+        return false;
+    } // if
+    (void) fclose(stream);
+    return true;
+} // exists
+
+
+static void
+insert(vrd_SNV_Table* const snv,
+       vrd_MNV_Table* const mnv,
+       vrd_Seq_Table* const seq,
+       vrd_Cov_Table* const cov,
+       size_t const sample_id)
+{
+    for (size_t i = 0; i < 200; ++i)
+    {
+        int ret = vrd_SNV_table_insert(snv, 5, 0 == i % 2 ? "chr1" : "chr2", i, 1, sample_id, 0, 1);
+        assert(0 == ret);
+        ret = vrd_Cov_table_insert(cov, 5, "chr1", i, i + 1, 1, sample_id);
+        assert(0 == ret);
+
+        vrd_Trie_Node const* const elem = vrd_Seq_table_insert(seq, 4, "ACG");
+        assert(NULL != elem);
+        ret = vrd_MNV_table_insert(mnv, 5, "chr1", i, i + 2, 1, sample_id, 0, (size_t) elem->data);
+        assert(0 == ret);
+    } // for
+} // insert
+
+
+// The tables hold the samples 1 up to and including `last`: a snapshot
+// holds those inserted before its start only
+static void
+check(vrd_SNV_Table const* const snv,
+      vrd_MNV_Table const* const mnv,
+      vrd_Seq_Table const* const seq,
+      vrd_Cov_Table const* const cov,
+      size_t const last)
+{
+    vrd_Trie_Node const* const elem = vrd_Seq_table_query(seq, 4, "ACG");
+    assert(NULL != elem);
+
+    for (size_t i = 0; i < 200; i += 7)
+    {
+        char const* const reference = 0 == i % 2 ? "chr1" : "chr2";
+
+        size_t ret = vrd_SNV_table_query(snv, 5, reference, i, 1, false, NULL);
+        assert(last == ret);
+        ret = vrd_SNV_table_query(snv, 5, 0 == i % 2 ? "chr2" : "chr1", i, 1, false, NULL);
+        assert(0 == ret);
+        ret = vrd_Cov_table_query_stab(cov, 5, "chr1", i, i + 1, NULL);
+        assert(last == ret);
+        ret = vrd_MNV_table_query(mnv, 5, "chr1", i, i + 2, (size_t) elem->data, false, NULL);
+        assert(last == ret);
+
+        // each of the samples once
+        vrd_SNV_Entry result[4] = {{0}};
+        ret = vrd_SNV_table_query_region(snv, 5, reference, i, i + 1, NULL, 4, result);
+        assert(last == ret);
+        size_t seen = 0;
+        for (size_t j = 0; j < ret; ++j)
+        {
+            assert(i == result[j].position);
+            assert(1 <= result[j].sample_id && result[j].sample_id <= last);
+            seen |= (size_t) 1 << result[j].sample_id;
+        } // for
+        assert(((size_t) 1 << (last + 1)) - 2 == seen);
+    } // for
+} // check
+
+
+static void
+progress(void* const data, size_t const done, size_t const total, int const error)
+{
+    size_t* const calls = data;
+    *calls += 1;
+    assert(0 == error);
+    assert(done <= total);
+} // progress
+
+
+// a snapshot in the background is the point in time of its start; the
+// log holds the updates since
+static void
+background(void)
+{
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != mnv);
+    vrd_Seq_Table* seq = vrd_Seq_table_init(16);
+    assert(NULL != seq);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 12);
+    assert(NULL != cov);
+
+    (void) remove("test_snapshot.log");
+    (void) remove("test_snapshot.log.ckpt");
+    vrd_WAL* wal = vrd_wal_open("test_snapshot.log", seq);
+    assert(NULL != wal);
+    vrd_SNV_table_log(snv, wal);
+    vrd_MNV_table_log(mnv, wal);
+    vrd_Cov_table_log(cov, wal);
+
+    insert(snv, mnv, seq, cov, 1);
+
+    size_t calls = 0;
+    vrd_Snapshot* snapshot = vrd_snapshot_start(PATH, snv, mnv, seq, cov, wal, progress, &calls);
+    assert(NULL != snapshot);
+
+    // one at the time
+    vrd_Snapshot* other = vrd_snapshot_start("test_snapshot_other", NULL, NULL, NULL, NULL, wal, NULL, NULL);
+    assert(NULL == other);
+
+    insert(snv, mnv, seq, cov, 2);
+
+    int err = vrd_snapshot_finish(&snapshot);
+    assert(0 == err);
+    assert(NULL == snapshot);
+    assert(4 == calls);
+
+    vrd_SNV_table_log(snv, NULL);
+    vrd_MNV_table_log(mnv, NULL);
+    vrd_Cov_table_log(cov, NULL);
+    err = vrd_wal_sync(wal);
+    assert(0 == err);
+    vrd_wal_close(&wal);
+
+    vrd_SNV_Table* snv_read = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv_read);
+    vrd_MNV_Table* mnv_read = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != mnv_read);
+    vrd_Seq_Table* seq_read = vrd_Seq_table_init(16);
+    assert(NULL != seq_read);
+    vrd_Cov_Table* cov_read = vrd_Cov_table_init(10, 1 << 12);
+    assert(NULL != cov_read);
+
+    err = vrd_SNV_table_read(snv_read, "test_snapshot_snv", 4);
+    assert(0 == err);
+    err = vrd_MNV_table_read(mnv_read, "test_snapshot_mnv", 4);
+    assert(0 == err);
+    err = vrd_Seq_table_read(seq_read, "test_snapshot_seq");
+    assert(0 == err);
+    err = vrd_Cov_table_read(cov_read, "test_snapshot_cov", 4);
+    assert(0 == err);
+
+    check(snv_read, mnv_read, seq_read, cov_read, 1);
+
+    // only the updates after the start are replayed
+    wal = vrd_wal_open("test_snapshot.log", seq_read);
+    assert(NULL != wal);
+    size_t const count = vrd_wal_replay(wal, snv_read, mnv_read, seq_read, cov_read);
+    assert(3 * 200 == count);
+    vrd_wal_close(&wal);
+
+    check(snv_read, mnv_read, seq_read, cov_read, 2);
+
+    vrd_Cov_table_destroy(&cov_read);
+    vrd_Seq_table_destroy(&seq_read);
+    vrd_MNV_table_destroy(&mnv_read);
+    vrd_SNV_table_destroy(&snv_read);
+    vrd_Cov_table_destroy(&cov);
+    vrd_Seq_table_destroy(&seq);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+
+    (void) remove("test_snapshot.log");
+    (void) remove("test_snapshot.log.ckpt");
+    (void) remove("test_snapshot_seq.idx");
+    char const* const tables[] = {"snv", "mnv", "cov"};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        char name[FILENAME_MAX] = {'\0'};
+        (void) snprintf(name, sizeof(name), "test_snapshot_%s.idx", tables[i]);
+        (void) remove(name);
+        for (size_t j = 0; j < 2; ++j)
+        {
+            (void) snprintf(name, sizeof(name), "test_snapshot_%s_tree_%zu.bin", tables[i], j);
+            (void) remove(name);
+        } // for
+    } // for
+} // background
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        int ret = vrd_SNV_table_insert(snv, 5, "chr1", i, 1, 1, 0, 1);
+        assert(0 == ret);
+        ret = vrd_SNV_table_insert(snv, 5, "chr2", i, 1, 1, 0, 1);
+        assert(0 == ret);
+    } // for
+
+    int ret = vrd_SNV_table_write_incremental(snv, PATH);
+    assert(0 == ret);
+    assert(exists("test_snapshot_tree_0.bin"));
+    assert(exists("test_snapshot_tree_1.bin"));
+
+    // only chr1 (tree 0) changes
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 10, 1, 2, 0, 1);
+    assert(0 == ret);
+
+    (void) remove("test_snapshot_tree_0.bin");
+    (void) remove("test_snapshot_tree_1.bin");
+    ret = vrd_SNV_table_write_incremental(snv, PATH);
+    assert(0 == ret);
+    assert(exists("test_snapshot_tree_0.bin"));
+    assert(!exists("test_snapshot_tree_1.bin"));
+
+    // a full write writes all trees
+    ret = vrd_SNV_table_write(snv, PATH);
+    assert(0 == ret);
+    assert(exists("test_snapshot_tree_1.bin"));
+
+    // reading restores the generations: nothing is dirty
+    vrd_SNV_Table* copy = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != copy);
+    ret = vrd_SNV_table_read(copy, PATH, 2);
+    assert(0 == ret);
+
+    assert(2 == vrd_SNV_table_query(copy, 5, "chr1", 10, 1, false, NULL));
+    assert(1 == vrd_SNV_table_query(copy, 5, "chr2", 10, 1, false, NULL));
+
+    (void) remove("test_snapshot_tree_0.bin");
+    (void) remove("test_snapshot_tree_1.bin");
+    ret = vrd_SNV_table_write_incremental(copy, PATH);
+    assert(0 == ret);
+    assert(!exists("test_snapshot_tree_0.bin"));
+    assert(!exists("test_snapshot_tree_1.bin"));
+
+    // a removal makes only the trees it removed from dirty
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+    assert(NULL != subset);
+    (void) vrd_AVL_tree_insert(subset, 2);
+    size_t const count = vrd_SNV_table_remove(copy, subset);
+    assert(1 == count);
+    vrd_AVL_tree_destroy(&subset);
+
+    ret = vrd_SNV_table_write_incremental(copy, PATH);
+    assert(0 == ret);
+    assert(exists("test_snapshot_tree_0.bin"));
+    assert(!exists("test_snapshot_tree_1.bin"));
+
+    ret = vrd_SNV_table_write(copy, PATH);
+    assert(0 == ret);
+
+    // the same generations of another table are not the same trees
+    vrd_SNV_Table* other = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != other);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        ret = vrd_SNV_table_insert(other, 5, "chr1", i, 1, 3, 0, 1);
+        assert(0 == ret);
+        ret = vrd_SNV_table_insert(other, 5, "chr2", i, 1, 3, 0, 1);
+        assert(0 == ret);
+    } // for
+
+    (void) remove("test_snapshot_tree_0.bin");
+    (void) remove("test_snapshot_tree_1.bin");
+    ret = vrd_SNV_table_write_incremental(other, PATH);
+    assert(0 == ret);
+    assert(exists("test_snapshot_tree_0.bin"));
+    assert(exists("test_snapshot_tree_1.bin"));
+
+    vrd_SNV_table_destroy(&other);
+    vrd_SNV_table_destroy(&copy);
+    vrd_SNV_table_destroy(&snv);
+
+    (void) remove("test_snapshot.idx");
+    (void) remove("test_snapshot_tree_0.bin");
+    (void) remove("test_snapshot_tree_1.bin");
+
+    background();
+
+    return EXIT_SUCCESS;
+} // main
@@ -4,7 +4,6 @@
 #include <stdlib.h>     // EXIT_*
 
 #include "../include/varda.h"   // vrd_*
-#include "../src/snv_tree.h"    // vrd_SNV_unpack
 
 
 int
@@ -22,6 +21,56 @@ main(int argc, char* argv[])
     ret = vrd_SNV_table_insert(snv, 5, "chr1", 15, 1, 1, 10, 1);
     assert(0 == ret);
 
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 15, 2, 2, VRD_HOMOZYGOUS, vrd_iupac_to_idx('A'));
+    assert(0 == ret);
+
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 15, 1, 3, 10, vrd_iupac_to_idx('G'));
+    assert(0 == ret);
+
+    size_t heterozygous[16] = {0};
+    size_t homozygous[16] = {0};
+    size_t const spectrum_count = vrd_SNV_table_query_spectrum(snv, 5, "chr1", 15, NULL, heterozygous, homozygous);
+    assert(4 == spectrum_count);
+    assert(1 == heterozygous[vrd_iupac_to_idx('A')]);
+    assert(2 == homozygous[vrd_iupac_to_idx('A')]);
+    assert(1 == heterozygous[vrd_iupac_to_idx('G')]);
+    assert(0 == homozygous[vrd_iupac_to_idx('G')]);
+    assert(0 == heterozygous[vrd_iupac_to_idx('C')]);
+
+    size_t homozygous_count = 0;
+    size_t carriers = 0;
+    size_t const zygosity_count = vrd_SNV_table_query_zygosity(snv, 5, "chr1", 15, vrd_iupac_to_idx('A'), NULL, &homozygous_count, &carriers);
+    assert(3 == zygosity_count);
+    assert(2 == homozygous_count);
+    assert(2 == carriers);
+
+    // a sample matching on both haplotypes is a single carrier
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 30, 1, 7, 0, vrd_iupac_to_idx('T'));
+    assert(0 == ret);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 30, 1, 7, 1, vrd_iupac_to_idx('T'));
+    assert(0 == ret);
+    ret = vrd_SNV_table_insert(snv, 5, "chr1", 30, 1, 8, 0, vrd_iupac_to_idx('T'));
+    assert(0 == ret);
+    assert(3 == vrd_SNV_table_query_zygosity(snv, 5, "chr1", 30, vrd_iupac_to_idx('T'), NULL, &homozygous_count, &carriers));
+    assert(0 == homozygous_count);
+    assert(2 == carriers);
+
+    // more carriers than are kept inline, each on both haplotypes
+    vrd_SNV_Table* crowd = vrd_SNV_table_init(10, 1 << 10);
+    assert(NULL != crowd);
+    for (size_t i = 40; i > 0; --i)
+    {
+        ret = vrd_SNV_table_insert(crowd, 5, "chr1", 40, 1, i, 0, vrd_iupac_to_idx('G'));
+        assert(0 == ret);
+        ret = vrd_SNV_table_insert(crowd, 5, "chr1", 40, 1, i, 1, vrd_iupac_to_idx('G'));
+        assert(0 == ret);
+    } // for
+    size_t const many = vrd_SNV_table_query_zygosity(crowd, 5, "chr1", 40, vrd_iupac_to_idx('G'), NULL, &homozygous_count, &carriers);
+    assert(80 == many);
+    assert(0 == homozygous_count);
+    assert(40 == carriers);
+    vrd_SNV_table_destroy(&crowd);
+
     size_t count[10] = {0};
 
     size_t const max_sample_id = vrd_SNV_table_sample_count(snv, count);
@@ -29,21 +78,16 @@ main(int argc, char* argv[])
 
     assert(1 == count[0]);
     assert(1 == count[1]);
+    assert(1 == count[2]);
+    assert(1 == count[3]);
 
-    void* result[10] = {0};
+    vrd_SNV_Entry result[10] = {{0}};
 
     size_t const region_count = vrd_SNV_table_query_region(snv, 5, "chr1", 0, 20, NULL, 10, result);
 
     for (size_t i = 0; i < region_count; ++i)
     {
-        size_t position = 0;
-        size_t allele_count = 0;
-        size_t sample_id = 0;
-        size_t phase = 0;
-        char inserted = '\0';
-        vrd_SNV_unpack(result[i], &position, &allele_count, &sample_id, &phase, &inserted);
-
-        (void) fprintf(stderr, "%zu: %zu\n", i, position);
+        (void) fprintf(stderr, "%zu: %zu\n", i, result[i].position);
     } // for
 
 /*
@@ -0,0 +1,333 @@
+#include <assert.h>     // assert
+#include <errno.h>      // EINVAL
+#include <stdbool.h>    // false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILE, FILENAME_MAX, SEEK_END, fclose, fopen,
+                        // fseek, ftell, fwrite, remove, snprintf
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+enum
+{
+    ENTRIES = 10000,
+    REFERENCES = 50
+}; // sizes
+
+
+static long
+file_size(char const* const filename)
+{
+    FILE* const stream = fopen(filename, "rb");
+    assert(NULL != stream);
+    int const ret = fseek(stream, 0, SEEK_END);
+    assert(0 == ret);
+    long const size = ftell(stream);
+    (void) fclose(stream);
+    return size;
+} // file_size
+
+
+// the trees of many references are read concurrently
+static void
+references(void)
+{
+    vrd_SNV_Table* snv = vrd_SNV_table_init(REFERENCES, 1 << 12);
+    assert(NULL != snv);
+
+    char reference[16] = {'\0'};
+    for (size_t i = 0; i < REFERENCES; ++i)
+    {
+        int const len = snprintf(reference, sizeof(reference), "chr%zu", i);
+        for (size_t j = 0; j <= i; ++j)
+        {
+            int const ret = vrd_SNV_table_insert(snv, len, reference, j, 1, 1, 0, 1);
+            assert(0 == ret);
+        } // for
+    } // for
+
+    int err = vrd_SNV_table_write(snv, "test_tree_file_refs");
+    assert(0 == err);
+
+    vrd_SNV_Table* snv_read = vrd_SNV_table_init(REFERENCES, 1 << 12);
+    assert(NULL != snv_read);
+    err = vrd_SNV_table_read(snv_read, "test_tree_file_refs", 8);
+    assert(0 == err);
+
+    for (size_t i = 0; i < REFERENCES; ++i)
+    {
+        int const len = snprintf(reference, sizeof(reference), "chr%zu", i);
+        assert(1 == vrd_SNV_table_query(snv_read, len, reference, i, 1, false, NULL));
+        assert(0 == vrd_SNV_table_query(snv_read, len, reference, i + 1, 1, false, NULL));
+    } // for
+
+    vrd_Diagnostics* diag = NULL;
+    size_t const count = vrd_SNV_table_diagnostics(snv_read, &diag);
+    assert(REFERENCES == count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        free(diag[i].reference);
+    } // for
+    free(diag);
+
+    // a missing tree fails the read; none of the trees are added
+    (void) remove("test_tree_file_refs_tree_17.bin");
+    vrd_SNV_Table* partial = vrd_SNV_table_init(REFERENCES, 1 << 12);
+    assert(NULL != partial);
+    err = vrd_SNV_table_read(partial, "test_tree_file_refs", 8);
+    assert(0 != err);
+    assert((size_t) -1 == vrd_SNV_table_query(partial, 4, "chr0", 0, 1, false, NULL));
+
+    vrd_SNV_table_destroy(&partial);
+    vrd_SNV_table_destroy(&snv_read);
+    vrd_SNV_table_destroy(&snv);
+
+    (void) remove("test_tree_file_refs.idx");
+    char name[FILENAME_MAX] = {'\0'};
+    for (size_t i = 0; i < REFERENCES; ++i)
+    {
+        (void) snprintf(name, sizeof(name), "test_tree_file_refs_tree_%zu.bin", i);
+        (void) remove(name);
+    } // for
+} // references
+
+
+// trees are read on first use and evicted over budget, unless changed
+static void
+lazy(void)
+{
+    vrd_SNV_Table* snv = vrd_SNV_table_init(REFERENCES, 1 << 12);
+    assert(NULL != snv);
+
+    char reference[16] = {'\0'};
+    for (size_t i = 0; i < REFERENCES; ++i)
+    {
+        int const len = snprintf(reference, sizeof(reference), "chr%zu", i);
+        int const ret = vrd_SNV_table_insert(snv, len, reference, i, 1, 1, 0, 1);
+        assert(0 == ret);
+    } // for
+
+    int err = vrd_SNV_table_write(snv, "test_tree_file_lazy");
+    assert(0 == err);
+
+    vrd_Diagnostics* diag = NULL;
+    size_t const count = vrd_SNV_table_diagnostics(snv, &diag);
+    assert(REFERENCES == count);
+    size_t const tree_size = diag[0].entry_size * ((1 << 12) + 1);
+    for (size_t i = 0; i < count; ++i)
+    {
+        free(diag[i].reference);
+    } // for
+    free(diag);
+    vrd_SNV_table_destroy(&snv);
+
+    snv = vrd_SNV_table_init(REFERENCES, 1 << 12);
+    assert(NULL != snv);
+    err = vrd_SNV_table_read_lazy(snv, "test_tree_file_lazy", 3 * tree_size);
+    assert(0 == err);
+
+    // one source per table
+    err = vrd_SNV_table_read_lazy(snv, "test_tree_file_lazy", 0);
+    assert(0 != err);
+
+    // a changed tree is not evicted
+    int ret = vrd_SNV_table_insert(snv, 4, "chr0", 0, 1, 2, 0, 1);
+    assert(0 == ret);
+    (void) remove("test_tree_file_lazy_tree_0.bin");
+
+    assert(1 == vrd_SNV_table_query(snv, 4, "chr5", 5, 1, false, NULL));
+    (void) remove("test_tree_file_lazy_tree_5.bin");
+
+    for (size_t i = 10; i < REFERENCES; ++i)
+    {
+        int const len = snprintf(reference, sizeof(reference), "chr%zu", i);
+        assert(1 == vrd_SNV_table_query(snv, len, reference, i, 1, false, NULL));
+        assert(0 == vrd_SNV_table_query(snv, len, reference, i + 1, 1, false, NULL));
+    } // for
+
+    // evicted and no longer on disk
+    assert((size_t) -1 == vrd_SNV_table_query(snv, 4, "chr5", 5, 1, false, NULL));
+    assert(2 == vrd_SNV_table_query(snv, 4, "chr0", 0, 1, false, NULL));
+    assert(1 == vrd_SNV_table_query(snv, 4, "chr6", 6, 1, false, NULL));
+
+    // once written to the source a changed tree is evicted again
+    err = vrd_SNV_table_write_incremental(snv, "test_tree_file_lazy");
+    assert(0 == err);
+    for (size_t i = 10; i < REFERENCES; ++i)
+    {
+        int const len = snprintf(reference, sizeof(reference), "chr%zu", i);
+        assert(1 == vrd_SNV_table_query(snv, len, reference, i, 1, false, NULL));
+    } // for
+    (void) remove("test_tree_file_lazy_tree_0.bin");
+    assert((size_t) -1 == vrd_SNV_table_query(snv, 4, "chr0", 0, 1, false, NULL));
+
+    vrd_SNV_table_destroy(&snv);
+
+    (void) remove("test_tree_file_lazy.idx");
+    char name[FILENAME_MAX] = {'\0'};
+    for (size_t i = 0; i < REFERENCES; ++i)
+    {
+        (void) snprintf(name, sizeof(name), "test_tree_file_lazy_tree_%zu.bin", i);
+        (void) remove(name);
+    } // for
+} // lazy
+
+
+// files without the magic and version (the format before), or of
+// another table type, are refused
+static void
+old_format(void)
+{
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    int err = vrd_SNV_table_insert(snv, 5, "chr1", 1, 1, 1, 0, 1);
+    assert(0 == err);
+    err = vrd_SNV_table_write(snv, "test_tree_file_old");
+    assert(0 == err);
+    vrd_SNV_table_destroy(&snv);
+
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 12);
+    assert(NULL != cov);
+    err = vrd_Cov_table_read(cov, "test_tree_file_old", 1);
+    assert(EINVAL == err);
+    vrd_Cov_table_destroy(&cov);
+
+    // a tree of the format before: entries and height only
+    size_t const tree[2] = {0, 0};
+    FILE* stream = fopen("test_tree_file_old_tree_0.bin", "wb");
+    assert(NULL != stream);
+    size_t count = fwrite(tree, sizeof(tree[0]), 2, stream);
+    assert(2 == count);
+    (void) fclose(stream);
+
+    snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    err = vrd_SNV_table_read(snv, "test_tree_file_old", 1);
+    assert(EINVAL == err);
+    assert((size_t) -1 == vrd_SNV_table_query(snv, 5, "chr1", 1, 1, false, NULL));
+    vrd_SNV_table_destroy(&snv);
+
+    // an index of the format before: id, log position and no trees
+    size_t const index[4] = {1, 0, 0, 0};
+    stream = fopen("test_tree_file_old.idx", "wb");
+    assert(NULL != stream);
+    count = fwrite(index, sizeof(index[0]), 4, stream);
+    assert(4 == count);
+    (void) fclose(stream);
+
+    snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    err = vrd_SNV_table_read(snv, "test_tree_file_old", 1);
+    assert(EINVAL == err);
+    err = vrd_SNV_table_read_lazy(snv, "test_tree_file_old", 0);
+    assert(EINVAL == err);
+    vrd_SNV_table_destroy(&snv);
+
+    (void) remove("test_tree_file_old.idx");
+    (void) remove("test_tree_file_old_tree_0.bin");
+} // old_format
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv);
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1 << 16);
+    assert(NULL != mnv);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 16);
+    assert(NULL != cov);
+
+    size_t seed = 42;
+    for (size_t i = 0; i < ENTRIES; ++i)
+    {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        size_t const position = (seed >> 33) % (1 << 20);
+        size_t const sample_id = (seed >> 17) % 1000;
+        size_t const phase = 0 == i % 3 ? VRD_HOMOZYGOUS : i % 7;
+
+        int ret = vrd_SNV_table_insert(snv, 5, "chr1", position, 1 + i % 2, sample_id, phase, i % 16);
+        assert(0 == ret);
+        ret = vrd_MNV_table_insert(mnv, 5, "chr1", position, position + 1 + i % 5, 1, sample_id, phase, i % 100);
+        assert(0 == ret);
+        ret = vrd_Cov_table_insert(cov, 5, "chr1", position, position + 1 + i % 300, 2, sample_id);
+        assert(0 == ret);
+    } // for
+
+    int err = vrd_SNV_table_write(snv, "test_tree_file_snv");
+    assert(0 == err);
+    err = vrd_MNV_table_write(mnv, "test_tree_file_mnv");
+    assert(0 == err);
+    err = vrd_Cov_table_write(cov, "test_tree_file_cov");
+    assert(0 == err);
+
+    // the child pointers and the balance are not stored
+    assert(file_size("test_tree_file_snv_tree_0.bin") < (long) (ENTRIES * 16 / 3));
+    assert(file_size("test_tree_file_mnv_tree_0.bin") < (long) (ENTRIES * 28 / 3));
+
+    vrd_SNV_Table* snv_read = vrd_SNV_table_init(10, 1 << 16);
+    assert(NULL != snv_read);
+    vrd_MNV_Table* mnv_read = vrd_MNV_table_init(10, 1 << 16);
+    assert(NULL != mnv_read);
+    vrd_Cov_Table* cov_read = vrd_Cov_table_init(10, 1 << 16);
+    assert(NULL != cov_read);
+
+    err = vrd_SNV_table_read(snv_read, "test_tree_file_snv", 4);
+    assert(0 == err);
+    err = vrd_MNV_table_read(mnv_read, "test_tree_file_mnv", 4);
+    assert(0 == err);
+    err = vrd_Cov_table_read(cov_read, "test_tree_file_cov", 4);
+    assert(0 == err);
+
+    seed = 42;
+    for (size_t i = 0; i < ENTRIES; ++i)
+    {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        size_t const position = (seed >> 33) % (1 << 20);
+
+        for (size_t k = 0; k < 16; k += 5)
+        {
+            assert(vrd_SNV_table_query(snv, 5, "chr1", position, k, false, NULL) ==
+                   vrd_SNV_table_query(snv_read, 5, "chr1", position, k, false, NULL));
+            assert(vrd_SNV_table_query(snv, 5, "chr1", position, k, true, NULL) ==
+                   vrd_SNV_table_query(snv_read, 5, "chr1", position, k, true, NULL));
+        } // for
+        assert(vrd_MNV_table_query(mnv, 5, "chr1", position, position + 1 + i % 5, i % 100, false, NULL) ==
+               vrd_MNV_table_query(mnv_read, 5, "chr1", position, position + 1 + i % 5, i % 100, false, NULL));
+        assert(vrd_Cov_table_query_stab(cov, 5, "chr1", position, position + 1, NULL) ==
+               vrd_Cov_table_query_stab(cov_read, 5, "chr1", position, position + 1, NULL));
+    } // for
+
+    // the rebuilt trees are balanced
+    vrd_Diagnostics* diag = NULL;
+    size_t const count = vrd_Cov_table_diagnostics(cov_read, &diag);
+    assert(1 == count);
+    assert(ENTRIES == diag[0].entries);
+    assert(14 == diag[0].height);
+    free(diag[0].reference);
+    free(diag);
+
+    vrd_Cov_table_destroy(&cov_read);
+    vrd_MNV_table_destroy(&mnv_read);
+    vrd_SNV_table_destroy(&snv_read);
+    vrd_Cov_table_destroy(&cov);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+
+    (void) remove("test_tree_file_snv.idx");
+    (void) remove("test_tree_file_snv_tree_0.bin");
+    (void) remove("test_tree_file_mnv.idx");
+    (void) remove("test_tree_file_mnv_tree_0.bin");
+    (void) remove("test_tree_file_cov.idx");
+    (void) remove("test_tree_file_cov_tree_0.bin");
+
+    references();
+    lazy();
+    old_format();
+
+    return EXIT_SUCCESS;
+} // main
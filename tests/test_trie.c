@@ -1,7 +1,9 @@
 #include <assert.h>     // assert
+#include <stdbool.h>    // bool
 #include <stddef.h>     // NULL, size_t
-#include <stdio.h>      // FILE, fclose, fopen, fprintf, stderr
-#include <stdlib.h>     // EXIT_*
+#include <stdio.h>      // FILE, fclose, fopen, fprintf, snprintf, stderr
+#include <stdlib.h>     // EXIT_*, free
+#include <string.h>     // strcmp, strlen
 
 #include "../include/varda.h"   // vrd_*
 
@@ -63,6 +65,81 @@ main(int argc, char* argv[])
     elem = vrd_trie_find(trie, 3, "rom");
     assert(NULL != elem);
 
+    // removing keeps the identity of the remaining nodes
+    vrd_Trie_Node* const rubicon = vrd_trie_find(trie, 8, "rubicon");
+    bool removed = vrd_trie_remove(trie, 11, "rubicundus");
+    assert(removed);
+    assert(NULL == vrd_trie_find(trie, 11, "rubicundus"));
+    assert(rubicon == vrd_trie_find(trie, 8, "rubicon"));
+
+    char* key = NULL;
+    size_t len = vrd_trie_key(rubicon, &key);
+    assert(8 == len);
+    assert(0 == strcmp("rubicon", key));
+
+    elem = vrd_trie_insert(trie, 8, "rubicon", (void*) 8);
+    assert(rubicon == elem && 2 == elem->count && (void*) 6 == elem->data);
+    removed = vrd_trie_remove(trie, 8, "rubicon");
+    assert(!removed);
+    removed = vrd_trie_remove(trie, 8, "rubicon");
+    assert(removed);
+    removed = vrd_trie_remove(trie, 8, "rubicon");
+    assert(!removed);
+    assert(NULL == vrd_trie_find(trie, 8, "rubicon"));
+
+    vrd_Trie_Node* const ruber = vrd_trie_find(trie, 6, "ruber");
+    removed = vrd_trie_remove(trie, 7, "rubens");
+    assert(removed);
+    assert(ruber == vrd_trie_find(trie, 6, "ruber"));
+    len = vrd_trie_key(ruber, &key);
+    assert(6 == len);
+    assert(0 == strcmp("ruber", key));
+
+    // compared in place
+    assert(vrd_trie_key_equal(ruber, 6, "ruber"));
+    assert(!vrd_trie_key_equal(ruber, 6, "rubes"));
+    assert(!vrd_trie_key_equal(ruber, 5, "rube"));
+    assert(!vrd_trie_key_equal(ruber, 7, "xruber"));
+
+    vrd_trie_destroy(&trie);
+
+    // high fanout and long shared prefixes
+    trie = vrd_trie_init();
+    assert(NULL != trie);
+
+    char buffer[64] = {'\0'};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        (void) snprintf(buffer, sizeof(buffer), "AAAAAAAAAAAAAAAAAAAAAAAA%zu", i * 7919);
+        elem = vrd_trie_insert(trie, strlen(buffer) + 1, buffer, (void*) i);
+        assert(NULL != elem);
+    } // for
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        (void) snprintf(buffer, sizeof(buffer), "AAAAAAAAAAAAAAAAAAAAAAAA%zu", i * 7919);
+        elem = vrd_trie_find(trie, strlen(buffer) + 1, buffer);
+        assert(NULL != elem && (void*) i == elem->data);
+        len = vrd_trie_key(elem, &key);
+        assert(strlen(buffer) + 1 == len);
+        assert(0 == strcmp(buffer, key));
+    } // for
+
+    for (size_t i = 0; i < 1000; i += 2)
+    {
+        (void) snprintf(buffer, sizeof(buffer), "AAAAAAAAAAAAAAAAAAAAAAAA%zu", i * 7919);
+        removed = vrd_trie_remove(trie, strlen(buffer) + 1, buffer);
+        assert(removed);
+    } // for
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        (void) snprintf(buffer, sizeof(buffer), "AAAAAAAAAAAAAAAAAAAAAAAA%zu", i * 7919);
+        elem = vrd_trie_find(trie, strlen(buffer) + 1, buffer);
+        assert((0 == i % 2) == (NULL == elem));
+    } // for
+
+    free(key);
     vrd_trie_destroy(&trie);
 
     return EXIT_SUCCESS;
@@ -0,0 +1,103 @@
+#include <assert.h>     // assert
+#include <stdbool.h>    // false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILE, fclose, fputs, rewind, tmpfile
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+static char const VCF[] =
+    "##fileformat=VCFv4.2\n"
+    "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tsample\n"
+    "chr1\t1\t.\tG\t<NON_REF>\t.\t.\tEND=99\tGT:DP\t0/0:30\n"
+    "chr1\t100\t.\tA\tG,<NON_REF>\t50\tPASS\t.\tGT:PS\t0|1:100\n"
+    "chr1\t101\t.\tC\tT\t50\tPASS\t.\tGT:PS\t1|0:100\n"
+    "chr1\t102\t.\tc\tt\t50\tPASS\t.\tGT\t1/1\n"
+    "chr1\t103\t.\tA\tAT,G\t50\tPASS\t.\tGT\t1/2\n"
+    "chr1\t104\t.\tACGT\tA\t50\tPASS\t.\tGT\t0/1\n"
+    "chr1\t108\t.\tACG\tTCA\t50\tPASS\t.\tGT\t./.\n"
+    "chr1\t108\t.\tA\t<NON_REF>\t.\t.\tEND=200\tGT\t0/0\n"
+    "chr2\t10\t.\tT\tTAAAA\t50\tPASS\t.\tGT\t1\n";
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1000);
+    assert(NULL != snv);
+
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1000);
+    assert(NULL != mnv);
+
+    vrd_Seq_Table* seq = vrd_Seq_table_init(1000);
+    assert(NULL != seq);
+
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1000);
+    assert(NULL != cov);
+
+    FILE* const stream = tmpfile();
+    assert(NULL != stream);
+    fputs(VCF, stream);
+    rewind(stream);
+
+    size_t ret = vrd_variants_from_vcf(stream, snv, mnv, seq, 1);
+    assert(7 == ret);
+
+    // heterozygous SNVs in the same phase set
+    ret = vrd_SNV_table_query(snv, 5, "chr1", 99, vrd_iupac_to_idx('G'), false, NULL);
+    assert(1 == ret);
+    ret = vrd_SNV_table_query(snv, 5, "chr1", 100, vrd_iupac_to_idx('T'), false, NULL);
+    assert(1 == ret);
+    ret = vrd_SNV_table_query(snv, 5, "chr1", 100, vrd_iupac_to_idx('T'), true, NULL);
+    assert(0 == ret);
+
+    // homozygous SNV (lower case)
+    ret = vrd_SNV_table_query(snv, 5, "chr1", 101, vrd_iupac_to_idx('T'), true, NULL);
+    assert(2 == ret);
+
+    // multi-allelic: insertion and SNV
+    vrd_Trie_Node* elem = vrd_Seq_table_query(seq, 2, "T");
+    assert(NULL != elem);
+    ret = vrd_MNV_table_query(mnv, 5, "chr1", 103, 103, (size_t) elem->data, false, NULL);
+    assert(1 == ret);
+    ret = vrd_SNV_table_query(snv, 5, "chr1", 102, vrd_iupac_to_idx('G'), false, NULL);
+    assert(1 == ret);
+
+    // deletion
+    elem = vrd_Seq_table_query(seq, 1, "");
+    assert(NULL != elem);
+    ret = vrd_MNV_table_query(mnv, 5, "chr1", 104, 107, (size_t) elem->data, false, NULL);
+    assert(1 == ret);
+
+    // haploid
+    elem = vrd_Seq_table_query(seq, 5, "AAAA");
+    assert(NULL != elem);
+    ret = vrd_MNV_table_query(mnv, 5, "chr2", 10, 10, (size_t) elem->data, true, NULL);
+    assert(1 == ret);
+
+    rewind(stream);
+    ret = vrd_coverage_from_gvcf(stream, cov, 1);
+    assert(2 == ret);
+
+    ret = vrd_Cov_table_query_stab(cov, 5, "chr1", 0, 1, NULL);
+    assert(2 == ret);
+    ret = vrd_Cov_table_query_stab(cov, 5, "chr1", 150, 151, NULL);
+    assert(2 == ret);
+    ret = vrd_Cov_table_query_stab(cov, 5, "chr1", 200, 201, NULL);
+    assert(0 == ret);
+    ret = vrd_Cov_table_query_stab(cov, 5, "chr2", 9, 10, NULL);
+    assert(1 == ret);
+
+    fclose(stream);
+
+    vrd_Cov_table_destroy(&cov);
+    vrd_Seq_table_destroy(&seq);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+
+    return EXIT_SUCCESS;
+} // main
@@ -0,0 +1,436 @@
+#include <assert.h>     // assert
+#include <stdbool.h>    // false, true
+#include <stddef.h>     // NULL, size_t
+#include <stdio.h>      // FILE, fclose, fopen, fprintf, fwrite, remove,
+                        // rewind, tmpfile
+#include <stdlib.h>     // EXIT_*
+
+#include "../include/varda.h"   // vrd_*
+
+
+enum
+{
+    ENTRIES = 500
+}; // sizes
+
+
+static char const PATH[] = "test_wal.log";
+
+
+static void
+insert(vrd_SNV_Table* const snv,
+       vrd_MNV_Table* const mnv,
+       vrd_Seq_Table* const seq,
+       vrd_Cov_Table* const cov,
+       size_t const sample_id)
+{
+    for (size_t i = 0; i < ENTRIES; ++i)
+    {
+        char const* const reference = 0 == i % 2 ? "chr1" : "chr2";
+
+        int ret = vrd_SNV_table_insert(snv, 5, reference, i, 1, sample_id, 0, 1);
+        assert(0 == ret);
+        ret = vrd_Cov_table_insert(cov, 5, reference, i, i + 10, 2, sample_id);
+        assert(0 == ret);
+
+        vrd_Trie_Node const* const elem = vrd_Seq_table_insert(seq, 4, 0 == i % 3 ? "ACG" : "TTT");
+        assert(NULL != elem);
+        ret = vrd_MNV_table_insert(mnv, 5, reference, i, i + 2, 1, sample_id, 0, (size_t) elem->data);
+        assert(0 == ret);
+    } // for
+} // insert
+
+
+// The tables hold the `count` samples in `samples`, no others
+static void
+check(vrd_SNV_Table const* const snv,
+      vrd_MNV_Table const* const mnv,
+      vrd_Seq_Table const* const seq,
+      vrd_Cov_Table const* const cov,
+      size_t const count,
+      size_t const samples[count])
+{
+    for (size_t i = 0; i < ENTRIES; i += 37)
+    {
+        char const* const reference = 0 == i % 2 ? "chr1" : "chr2";
+
+        size_t ret = vrd_SNV_table_query(snv, 5, reference, i, 1, false, NULL);
+        assert(count == ret);
+        ret = vrd_Cov_table_query_stab(cov, 5, reference, i, i + 1, NULL);
+        assert(count * 2 * (i < 10 ? i / 2 + 1 : 5) == ret);
+
+        vrd_Trie_Node const* const elem = vrd_Seq_table_query(seq, 4, 0 == i % 3 ? "ACG" : "TTT");
+        assert(NULL != elem);
+        ret = vrd_MNV_table_query(mnv, 5, reference, i, i + 2, (size_t) elem->data, false, NULL);
+        assert(count == ret);
+
+        // each of the samples once
+        vrd_SNV_Entry result[8] = {{0}};
+        ret = vrd_SNV_table_query_region(snv, 5, reference, i, i + 1, NULL, 8, result);
+        assert(count == ret);
+        for (size_t j = 0; j < count; ++j)
+        {
+            size_t found = 0;
+            for (size_t k = 0; k < count; ++k)
+            {
+                found += samples[j] == result[k].sample_id;
+            } // for
+            assert(1 == found);
+        } // for
+    } // for
+} // check
+
+
+// imports in batches are logged as well
+static void
+batch(void)
+{
+    (void) remove(PATH);
+
+    FILE* variants[2] = {NULL};
+    size_t const sample_id[2] = {1, 2};
+    for (size_t i = 0; i < 2; ++i)
+    {
+        variants[i] = tmpfile();
+        assert(NULL != variants[i]);
+        for (size_t j = 0; j < ENTRIES; ++j)
+        {
+            fprintf(variants[i], "chr1 %zu %zu 1 -1 3 %s\n", j, j + 2, 0 == j % 3 ? "ACG" : "TTT");
+            fprintf(variants[i], "chr2 %zu %zu 1 0 1 A\n", j, j + 1);
+        } // for
+        rewind(variants[i]);
+    } // for
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != mnv);
+    vrd_Seq_Table* seq = vrd_Seq_table_init(16);
+    assert(NULL != seq);
+
+    vrd_WAL* wal = vrd_wal_open(PATH, seq);
+    assert(NULL != wal);
+    vrd_SNV_table_log(snv, wal);
+    vrd_MNV_table_log(mnv, wal);
+
+    size_t ret = vrd_variants_from_files(2, variants, sample_id, snv, mnv, seq, 2);
+    assert(2 * 2 * ENTRIES == ret);
+
+    vrd_SNV_table_log(snv, NULL);
+    vrd_MNV_table_log(mnv, NULL);
+
+    vrd_SNV_Table* snv_replay = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv_replay);
+    vrd_MNV_Table* mnv_replay = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != mnv_replay);
+    vrd_Seq_Table* seq_replay = vrd_Seq_table_init(16);
+    assert(NULL != seq_replay);
+
+    ret = vrd_wal_replay(wal, snv_replay, mnv_replay, seq_replay, NULL);
+    assert(2 * 2 * ENTRIES == ret);
+    vrd_wal_close(&wal);
+
+    for (size_t i = 0; i < ENTRIES; i += 37)
+    {
+        assert(2 == vrd_SNV_table_query(snv_replay, 5, "chr2", i, 1, false, NULL));
+
+        char const* const sequence = 0 == i % 3 ? "ACG" : "TTT";
+        vrd_Trie_Node const* const elem = vrd_Seq_table_query(seq, 4, sequence);
+        assert(NULL != elem);
+        vrd_Trie_Node const* const elem_replay = vrd_Seq_table_query(seq_replay, 4, sequence);
+        assert(NULL != elem_replay);
+        assert(2 == vrd_MNV_table_query(mnv_replay, 5, "chr1", i, i + 2, (size_t) elem_replay->data, false, NULL));
+        assert(2 == vrd_MNV_table_query(mnv, 5, "chr1", i, i + 2, (size_t) elem->data, false, NULL));
+    } // for
+
+    fclose(variants[0]);
+    fclose(variants[1]);
+
+    vrd_Seq_table_destroy(&seq_replay);
+    vrd_MNV_table_destroy(&mnv_replay);
+    vrd_SNV_table_destroy(&snv_replay);
+    vrd_Seq_table_destroy(&seq);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+} // batch
+
+
+// reads the tables written by a checkpoint that did not complete and
+// replays the log on top of them
+static void
+restart(vrd_SNV_Table** const snv,
+        vrd_MNV_Table** const mnv,
+        vrd_Seq_Table** const seq,
+        vrd_Cov_Table** const cov,
+        vrd_WAL** const wal)
+{
+    vrd_wal_close(wal);
+    vrd_Cov_table_destroy(cov);
+    vrd_Seq_table_destroy(seq);
+    vrd_MNV_table_destroy(mnv);
+    vrd_SNV_table_destroy(snv);
+
+    *snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != *snv);
+    *mnv = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != *mnv);
+    *seq = vrd_Seq_table_init(16);
+    assert(NULL != *seq);
+    *cov = vrd_Cov_table_init(10, 1 << 12);
+    assert(NULL != *cov);
+
+    int err = vrd_SNV_table_read(*snv, "test_wal_crash_snv", 1);
+    assert(0 == err);
+    err = vrd_MNV_table_read(*mnv, "test_wal_crash_mnv", 1);
+    assert(0 == err);
+    err = vrd_Seq_table_read(*seq, "test_wal_crash_seq");
+    assert(0 == err);
+    err = vrd_Cov_table_read(*cov, "test_wal_crash_cov", 1);
+    assert(0 == err);
+
+    *wal = vrd_wal_open(PATH, *seq);
+    assert(NULL != *wal);
+    size_t const ret = vrd_wal_replay(*wal, *snv, *mnv, *seq, *cov);
+    assert((size_t) -1 != ret);
+    vrd_SNV_table_log(*snv, *wal);
+    vrd_MNV_table_log(*mnv, *wal);
+    vrd_Cov_table_log(*cov, *wal);
+} // restart
+
+
+// a crash after the tables are written, but before the checkpoint
+// completes, does not apply the records in the tables twice
+static void
+crash(void)
+{
+    (void) remove(PATH);
+    (void) remove("test_wal.log.ckpt");
+    (void) remove("test_wal.log.prev");
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != mnv);
+    vrd_Seq_Table* seq = vrd_Seq_table_init(16);
+    assert(NULL != seq);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 12);
+    assert(NULL != cov);
+
+    vrd_WAL* wal = vrd_wal_open(PATH, seq);
+    assert(NULL != wal);
+    vrd_SNV_table_log(snv, wal);
+    vrd_MNV_table_log(mnv, wal);
+    vrd_Cov_table_log(cov, wal);
+
+    insert(snv, mnv, seq, cov, 1);
+
+    // the checkpoint ends without emptying the log, and the updates
+    // continue in the same log
+    int err = vrd_wal_checkpoint_begin(wal);
+    assert(0 == err);
+    err = vrd_SNV_table_write(snv, "test_wal_crash_snv");
+    assert(0 == err);
+    err = vrd_MNV_table_write(mnv, "test_wal_crash_mnv");
+    assert(0 == err);
+    err = vrd_Seq_table_write(seq, "test_wal_crash_seq");
+    assert(0 == err);
+    err = vrd_Cov_table_write(cov, "test_wal_crash_cov");
+    assert(0 == err);
+    err = vrd_wal_checkpoint_end(wal, false);
+    assert(0 == err);
+
+    insert(snv, mnv, seq, cov, 2);
+    err = vrd_wal_sync(wal);
+    assert(0 == err);
+
+    restart(&snv, &mnv, &seq, &cov, &wal);
+    size_t const first[] = {1, 2};
+    check(snv, mnv, seq, cov, 2, first);
+
+    // the tables frozen and written in the background, but the
+    // checkpoint not done: the log moved aside is in the tables
+    err = vrd_wal_checkpoint_begin(wal);
+    assert(0 == err);
+    vrd_SNV_Table* snv_frozen = vrd_SNV_table_freeze(snv, "test_wal_crash_snv");
+    assert(NULL != snv_frozen);
+    vrd_MNV_Table* mnv_frozen = vrd_MNV_table_freeze(mnv, "test_wal_crash_mnv");
+    assert(NULL != mnv_frozen);
+    vrd_Seq_Table* seq_frozen = vrd_Seq_table_copy(seq);
+    assert(NULL != seq_frozen);
+    vrd_Cov_Table* cov_frozen = vrd_Cov_table_freeze(cov, "test_wal_crash_cov");
+    assert(NULL != cov_frozen);
+    err = vrd_wal_checkpoint_freeze(wal);
+    assert(0 == err);
+
+    insert(snv, mnv, seq, cov, 3);
+    err = vrd_wal_sync(wal);
+    assert(0 == err);
+
+    err = vrd_SNV_table_write_incremental(snv_frozen, "test_wal_crash_snv");
+    assert(0 == err);
+    err = vrd_MNV_table_write_incremental(mnv_frozen, "test_wal_crash_mnv");
+    assert(0 == err);
+    err = vrd_Seq_table_write(seq_frozen, "test_wal_crash_seq");
+    assert(0 == err);
+    err = vrd_Cov_table_write_incremental(cov_frozen, "test_wal_crash_cov");
+    assert(0 == err);
+    vrd_Cov_table_destroy(&cov_frozen);
+    vrd_Seq_table_destroy(&seq_frozen);
+    vrd_MNV_table_destroy(&mnv_frozen);
+    vrd_SNV_table_destroy(&snv_frozen);
+
+    restart(&snv, &mnv, &seq, &cov, &wal);
+    size_t const second[] = {1, 2, 3};
+    check(snv, mnv, seq, cov, 3, second);
+
+    vrd_wal_close(&wal);
+    vrd_SNV_table_log(snv, NULL);
+    vrd_MNV_table_log(mnv, NULL);
+    vrd_Cov_table_log(cov, NULL);
+
+    vrd_Cov_table_destroy(&cov);
+    vrd_Seq_table_destroy(&seq);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+
+    char const* const files[] = {"test_wal.log.ckpt", "test_wal.log.prev",
+                                 "test_wal_crash_snv.idx", "test_wal_crash_snv_tree_0.bin", "test_wal_crash_snv_tree_1.bin",
+                                 "test_wal_crash_mnv.idx", "test_wal_crash_mnv_tree_0.bin", "test_wal_crash_mnv_tree_1.bin",
+                                 "test_wal_crash_seq.idx",
+                                 "test_wal_crash_cov.idx", "test_wal_crash_cov_tree_0.bin", "test_wal_crash_cov_tree_1.bin"};
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i)
+    {
+        (void) remove(files[i]);
+    } // for
+} // crash
+
+
+int
+main(int argc, char* argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    (void) remove(PATH);
+    (void) remove("test_wal.log.ckpt");
+
+    vrd_SNV_Table* snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    vrd_MNV_Table* mnv = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != mnv);
+    vrd_Seq_Table* seq = vrd_Seq_table_init(16);
+    assert(NULL != seq);
+    vrd_Cov_Table* cov = vrd_Cov_table_init(10, 1 << 12);
+    assert(NULL != cov);
+
+    vrd_WAL* wal = vrd_wal_open(PATH, seq);
+    assert(NULL != wal);
+    vrd_SNV_table_log(snv, wal);
+    vrd_MNV_table_log(mnv, wal);
+    vrd_Cov_table_log(cov, wal);
+
+    insert(snv, mnv, seq, cov, 1);
+    insert(snv, mnv, seq, cov, 2);
+    insert(snv, mnv, seq, cov, 3);
+
+    vrd_AVL_Tree* subset = vrd_AVL_tree_init(1);
+    assert(NULL != subset);
+    (void) vrd_AVL_tree_insert(subset, 2);
+    size_t ret = vrd_SNV_table_remove(snv, subset);
+    assert(ENTRIES == ret);
+    ret = vrd_MNV_table_remove(mnv, subset);
+    assert(ENTRIES == ret);
+    ret = vrd_Cov_table_remove(cov, subset);
+    assert(ENTRIES == ret);
+    vrd_AVL_tree_destroy(&subset);
+
+    size_t const kept[] = {1, 3};
+    check(snv, mnv, seq, cov, 2, kept);
+
+    int err = vrd_wal_sync(wal);
+    assert(0 == err);
+    vrd_wal_close(&wal);
+
+    // a torn record at the end of the log
+    FILE* stream = fopen(PATH, "ab");
+    assert(NULL != stream);
+    (void) fwrite("\x40\x00\x00\x00torn", 1, 8, stream);
+    (void) fclose(stream);
+
+    // replay into empty tables
+    vrd_Cov_table_destroy(&cov);
+    vrd_Seq_table_destroy(&seq);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+
+    snv = vrd_SNV_table_init(10, 1 << 12);
+    assert(NULL != snv);
+    mnv = vrd_MNV_table_init(10, 1 << 12);
+    assert(NULL != mnv);
+    seq = vrd_Seq_table_init(16);
+    assert(NULL != seq);
+    cov = vrd_Cov_table_init(10, 1 << 12);
+    assert(NULL != cov);
+
+    wal = vrd_wal_open(PATH, seq);
+    assert(NULL != wal);
+    vrd_SNV_table_log(snv, wal);
+    vrd_MNV_table_log(mnv, wal);
+    vrd_Cov_table_log(cov, wal);
+
+    // a removal is logged per table and reference
+    ret = vrd_wal_replay(wal, snv, mnv, seq, cov);
+    assert(3 * 3 * ENTRIES + 3 * 2 == ret);
+    check(snv, mnv, seq, cov, 2, kept);
+
+    // replaying does not log again
+    ret = vrd_wal_replay(wal, NULL, NULL, NULL, NULL);
+    assert(3 * 3 * ENTRIES + 3 * 2 == ret);
+
+    // the updates after the replay are appended
+    insert(snv, mnv, seq, cov, 4);
+    size_t const appended[] = {1, 3, 4};
+    check(snv, mnv, seq, cov, 3, appended);
+
+    err = vrd_wal_checkpoint_begin(wal);
+    assert(0 == err);
+    err = vrd_SNV_table_write(snv, "test_wal_snv");
+    assert(0 == err);
+    err = vrd_wal_checkpoint_end(wal, true);
+    assert(0 == err);
+
+    ret = vrd_wal_replay(wal, NULL, NULL, NULL, NULL);
+    assert(0 == ret);
+
+    insert(snv, mnv, seq, cov, 5);
+    err = vrd_wal_sync(wal);
+    assert(0 == err);
+    vrd_wal_close(&wal);
+
+    // only the updates after the checkpoint are in the log
+    wal = vrd_wal_open(PATH, seq);
+    assert(NULL != wal);
+    ret = vrd_wal_replay(wal, NULL, NULL, NULL, NULL);
+    assert(3 * ENTRIES == ret);
+    vrd_wal_close(&wal);
+
+    vrd_SNV_table_log(snv, NULL);
+    vrd_MNV_table_log(mnv, NULL);
+    vrd_Cov_table_log(cov, NULL);
+
+    vrd_Cov_table_destroy(&cov);
+    vrd_Seq_table_destroy(&seq);
+    vrd_MNV_table_destroy(&mnv);
+    vrd_SNV_table_destroy(&snv);
+
+    batch();
+    crash();
+
+    (void) remove(PATH);
+    (void) remove("test_wal.log.ckpt");
+    (void) remove("test_wal_snv.idx");
+    (void) remove("test_wal_snv_tree_0.bin");
+    (void) remove("test_wal_snv_tree_1.bin");
+
+    return EXIT_SUCCESS;
+} // main